@@ -1,14 +1,41 @@
 #include <hashmaps/HashMapLL.h>
 #include <hashmaps/HashMapDH.h>
 #include <hashmaps/HashMapRH.h>
+#include <hashmaps/HashMapCK.h>
+#include <hashmaps/HashMapHS.h>
+#include <hashmaps/OpenAddressingMap.h>
+#include <hashmaps/SeqLockHashMapRH.h>
+#include <hashmaps/LruHashMap.h>
+#include <hashmaps/MappedHashMapRH.h>
+#include <hashmaps/StringHashMapRH.h>
+#include <hashmaps/OrderedHashMapRH.h>
+#include <hashmaps/HashJoin.h>
+#include <hashmaps/GroupBy.h>
+#include <hashmaps/RadixSort.h>
 
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
 #include <fstream>
 #include <chrono>
 #include <random>
 #include <algorithm>
 #include <ctime>
 #include <sstream>
+#include <iomanip>
+#include <cstdio>
+#include <stdexcept>
+
+// Prefixes of the data set every benchmark over it runs with, the last one is the number of rows the data set needs
+const std::vector<int> ELEMENT_COUNTS = {50, 100, 250, 500, 1000, 5000, 10000, 15000, 30000, 50000, 75000, 100000,
+                                         150000};
+const std::vector<float> LOAD_FACTORS = {0.75f, 0.80f, 0.90f, 0.95f, 0.99f};
+// Largest relations analyseJoin builds unless the command line asks for other sizes
+constexpr size_t JOIN_MAX_ROWS = 10000000;
+// Largest file backed map analyseOutOfCore builds unless the command line asks for another size
+constexpr size_t OUT_OF_CORE_MAX_KEYS = 4000000;
 
 std::vector<std::string> getElements(const std::string& s) {
     std::vector<std::string> row;
@@ -52,215 +79,648 @@ size_t nearestPowerOf2(size_t number) {
     else return power * 2;
 }
 
+// Timings of a map that returned wrong results are worthless, so the run stops on the first one
+void check(bool condition, const std::string &message) {
+    if (!condition) throw std::logic_error("Benchmark check failed: " + message);
+}
+
 std::string convertToString(char *buffer) {
     std::string s(buffer);
     return s;
 }
 
-std::vector<std::string> analyse(const std::vector<std::vector<std::string>>& data) {
-    std::vector<int> values = {50, 100, 250, 500, 1000, 5000, 10000, 15000, 30000, 50000, 75000, 100000, 150000};
-    std::vector<float> loadFactors = {0.75f, 0.80f, 0.90f, 0.95f, 0.99f};
+std::string formatResult(const std::string &name, int value, float loadFactor, const std::string &operation,
+                         std::chrono::nanoseconds duration) {
+    char buffer[100];
+    std::sprintf(buffer,
+                 "%s,%d,%.2f,%s,%lld",
+                 name.c_str(),
+                 value,
+                 loadFactor,
+                 operation.c_str(),
+                 static_cast<long long>(duration.count()));
+    return convertToString(buffer);
+}
 
-    HashMapLL<std::string, float> *hashMapLL;
-    HashMapDH<std::string, float> *hashMapDH;
-    HashMapRH<std::string, float> *hashMapRH;
+// Uniform face of a benchmarked map. The maps of this library share their interface, so only the standard
+// containers need a specialization.
+template <typename HashMap>
+class MapAdapter {
+private:
+    HashMap _map;
+
+public:
+    MapAdapter(size_t capacity, float loadFactor) : _map(capacity, loadFactor) {}
+
+    void put(const std::string &key, float value) { _map.put(key, value); }
+    bool containsKey(const std::string &key) { return _map.containsKey(key); }
+    void remove(const std::string &key) { _map.remove(key); }
+};
+
+// Reserved for the same number of elements and held to the same load factor as the maps it is compared with
+template <>
+class MapAdapter<std::unordered_map<std::string, float>> {
+private:
+    std::unordered_map<std::string, float> _map;
+
+public:
+    MapAdapter(size_t capacity, float loadFactor) {
+        _map.max_load_factor(loadFactor);
+        _map.reserve(static_cast<size_t>(capacity * loadFactor));
+    }
+
+    void put(const std::string &key, float value) { _map.insert_or_assign(key, value); }
+    bool containsKey(const std::string &key) { return _map.find(key) != _map.end(); }
+    void remove(const std::string &key) { _map.erase(key); }
+};
+
+// Has neither a capacity nor a load factor, it runs the same phases as an ordered baseline
+template <>
+class MapAdapter<std::map<std::string, float>> {
+private:
+    std::map<std::string, float> _map;
+
+public:
+    MapAdapter(size_t, float) {}
+
+    void put(const std::string &key, float value) { _map.insert_or_assign(key, value); }
+    bool containsKey(const std::string &key) { return _map.find(key) != _map.end(); }
+    void remove(const std::string &key) { _map.erase(key); }
+};
+
+// Puts the first value elements, looks all of them up in shuffled order, looks up as many missing keys and removes
+// every element. The shuffle is seeded with the number of elements, so every map sees the same order.
+template <typename HashMap>
+void analyseMap(const std::string &name, const std::vector<std::vector<std::string>>& data, int value,
+                float loadFactor, size_t capacity, std::vector<std::string> &results) {
+    MapAdapter<HashMap> hashMap(capacity, loadFactor);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) {
+        hashMap.put(data[e][0], std::stof(data[e][1]));
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "put", stop - start));
+
+    std::vector<std::vector<std::string>> copiedData(data.begin(), data.begin() + value);
+    std::mt19937 rng(value);
+    std::shuffle(copiedData.begin(), copiedData.end(), rng);
+
+    // Counting the hits keeps the compiler from dropping lookups whose result would be unused
+    size_t found = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) {
+        found += hashMap.containsKey(copiedData[e][0]);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "containsKey", stop - start));
+
+    // Missing keys are the present ones with a suffix, so they hash as widely and compare as long as the hits
+    std::vector<std::string> missing;
+    missing.reserve(value);
+    for (size_t e = 0; e < value; e++) missing.push_back(copiedData[e][0] + "#");
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) {
+        found += hashMap.containsKey(missing[e]);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "containsKeyFailed", stop - start));
+    check(found == value, name + " found " + std::to_string(found) + " of " + std::to_string(value) + " keys");
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) {
+        hashMap.remove(copiedData[e][0]);
+    }
+    stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "remove", stop - start));
+}
+
+template <template <typename, typename, typename, typename, typename, typename> typename HashMap>
+using FilteredMap = HashMap<std::string, float, std::hash<std::string>, allocation::HeapAllocation, NoObserver,
+                            BlockedBloomFilter<>>;
+
+std::vector<std::string> analyse(const std::vector<std::vector<std::string>>& data) {
 
     std::vector<std::string> results;
     results.emplace_back("HashMap,\"Number of elements\",Load factor,Operation,Time");
-    char buffer[100];
 
-    for (float loadFactor : loadFactors) {
-        for (int value : values) {
+    for (float loadFactor : LOAD_FACTORS) {
+        for (int value : ELEMENT_COUNTS) {
+            auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+
+            analyseMap<HashMapLL<std::string, float>>("LL", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                                      results);
+            analyseMap<HashMapDH<std::string, float>>("DH", data, value, loadFactor, hashMapSize, results);
+            analyseMap<HashMapRH<std::string, float>>("RH", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                                      results);
+            analyseMap<FilteredMap<HashMapLL>>("LL-BLOOM", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                               results);
+            analyseMap<FilteredMap<HashMapDH>>("DH-BLOOM", data, value, loadFactor, hashMapSize, results);
+            analyseMap<FilteredMap<HashMapRH>>("RH-BLOOM", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                               results);
+            analyseMap<HashMapCK<std::string, float>>("CK", data, value, loadFactor, hashMapSize, results);
+            analyseMap<HashMapHS<std::string, float>>("HS", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                                      results);
+            analyseMap<StringHashMapRH<float>>("RH-ARENA", data, value, loadFactor, nearestPowerOf2(hashMapSize),
+                                               results);
+            analyseMap<OrderedHashMapRH<std::string, float>>("RH-ORDERED", data, value, loadFactor,
+                                                             nearestPowerOf2(hashMapSize), results);
+            analyseMap<std::unordered_map<std::string, float>>("STD-UNORDERED", data, value, loadFactor,
+                                                               hashMapSize, results);
+            analyseMap<std::map<std::string, float>>("STD-MAP", data, value, loadFactor, hashMapSize, results);
+        }
+    }
+
+    return results;
+}
+
+template <typename Probe, typename Delete>
+using OpenAddressing = OpenAddressingMap<std::string, float, std::hash<std::string>, Probe, Delete>;
+
+// Runs every probe sequence and deletion policy combination of OpenAddressingMap through the same phases as analyse()
+std::vector<std::string> analyseOpenAddressing(const std::vector<std::vector<std::string>>& data) {
+
+    std::vector<std::string> results;
+    for (float loadFactor : LOAD_FACTORS) {
+        for (int value : ELEMENT_COUNTS) {
             auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
-            hashMapLL = new HashMapLL<std::string, float>(nearestPowerOf2(hashMapSize), loadFactor);
-            hashMapDH = new HashMapDH<std::string, float>(hashMapSize, loadFactor);
-            hashMapRH = new HashMapRH<std::string, float>(nearestPowerOf2(hashMapSize), loadFactor);
 
-            // Adding elements to hash maps and benchmarking performance
+            analyseMap<OpenAddressing<LinearProbing, TombstoneDeletion>>("OA-LIN-TS", data, value, loadFactor,
+                                                                         hashMapSize, results);
+            analyseMap<OpenAddressing<LinearProbing, BackwardShiftDeletion>>("OA-LIN-BS", data, value, loadFactor,
+                                                                             hashMapSize, results);
+            analyseMap<OpenAddressing<TriangularProbing, TombstoneDeletion>>("OA-TRI-TS", data, value, loadFactor,
+                                                                             hashMapSize, results);
+            analyseMap<OpenAddressing<DoubleHashing, TombstoneDeletion>>("OA-DBL-TS", data, value, loadFactor,
+                                                                         hashMapSize, results);
+            analyseMap<OpenAddressing<RobinHoodProbing, TombstoneDeletion>>("OA-RH-TS", data, value, loadFactor,
+                                                                            hashMapSize, results);
+            analyseMap<OpenAddressing<RobinHoodProbing, BackwardShiftDeletion>>("OA-RH-BS", data, value, loadFactor,
+                                                                                hashMapSize, results);
+        }
+    }
+
+    return results;
+}
+
+template <typename HashMap>
+void analyseBuildFrom(const std::string &name, const std::vector<std::pair<std::string, float>> &pairs, int value,
+                      float loadFactor, std::vector<std::string> &results) {
+    auto start = std::chrono::high_resolution_clock::now();
+    HashMap hashMap(pairs.begin(), pairs.begin() + value, loadFactor);
+    auto stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "buildFrom", stop - start));
+}
+
+// Bulk loads the same prefixes that analyse() inserts one by one, starting from a default sized map
+std::vector<std::string> analyseBulkBuild(const std::vector<std::vector<std::string>>& data) {
+
+    std::vector<std::pair<std::string, float>> pairs;
+    pairs.reserve(ELEMENT_COUNTS.back());
+    for (size_t e = 0; e < ELEMENT_COUNTS.back(); e++) pairs.emplace_back(data[e][0], std::stof(data[e][1]));
+
+    std::vector<std::string> results;
+    for (float loadFactor : LOAD_FACTORS) {
+        for (int value : ELEMENT_COUNTS) {
+            analyseBuildFrom<HashMapLL<std::string, float>>("LL", pairs, value, loadFactor, results);
+            analyseBuildFrom<HashMapDH<std::string, float>>("DH", pairs, value, loadFactor, results);
+            analyseBuildFrom<HashMapRH<std::string, float>>("RH", pairs, value, loadFactor, results);
+        }
+    }
+
+    return results;
+}
+
+template <typename HashMap>
+void analyseEraseIf(const std::string &name, const std::vector<std::vector<std::string>>& data, int value,
+                    float loadFactor, std::vector<std::string> &results) {
+    auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+    HashMap sweptMap(nearestPowerOf2(hashMapSize), loadFactor);
+    HashMap removedMap(nearestPowerOf2(hashMapSize), loadFactor);
+
+    // Values are the element indices, so the sweep and the removal loop drop exactly the same every other element
+    for (size_t e = 0; e < value; e++) {
+        sweptMap.put(data[e][0], static_cast<float>(e));
+        removedMap.put(data[e][0], static_cast<float>(e));
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t erased = sweptMap.eraseIf([](const std::string &, const float &e) { return static_cast<size_t>(e) % 2 == 0; });
+    auto stop = std::chrono::high_resolution_clock::now();
+    check(erased == (value + 1) / 2,
+          name + " erased " + std::to_string(erased) + " of " + std::to_string((value + 1) / 2) + " keys");
+    results.push_back(formatResult(name, value, loadFactor, "eraseIf", stop - start));
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e += 2) removedMap.remove(data[e][0]);
+    stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name + "-REMOVE", value, loadFactor, "eraseIf", stop - start));
+}
+
+// Purges every other element with one sweep of the bucket array and, for comparison, with a remove per key
+std::vector<std::string> analysePurge(const std::vector<std::vector<std::string>>& data) {
+    float loadFactor = constants::DEFAULT_LOAD_FACTOR;
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        analyseEraseIf<HashMapLL<std::string, float>>("LL", data, value, loadFactor, results);
+        analyseEraseIf<HashMapDH<std::string, float>>("DH", data, value, loadFactor, results);
+        analyseEraseIf<HashMapRH<std::string, float>>("RH", data, value, loadFactor, results);
+    }
+
+    return results;
+}
+
+template <typename HashMap>
+void analyseMissingLookups(const std::string &name, const std::vector<std::vector<std::string>>& data, int value,
+                           float loadFactor, std::vector<std::string> &results) {
+    auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+    HashMap hashMap(nearestPowerOf2(hashMapSize), loadFactor);
+    for (size_t e = 0; e < value; e++) {
+        hashMap.put(data[e][0], std::stof(data[e][1]));
+    }
+
+    std::vector<std::string> missing;
+    for (size_t e = 0; e < value; e++) missing.push_back(data[e][0] + "#");
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) {
+        hashMap.containsKey(missing[e]);
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+    results.push_back(formatResult(name, value, loadFactor, "containsKeyMissing", stop - start));
+}
+
+// Every lookup misses, so each one walks a whole probe sequence through the bucket array, which is where huge pages
+// cut the dTLB misses of the heap backed maps
+std::vector<std::string> analyseAllocation(const std::vector<std::vector<std::string>>& data) {
+    using allocation::HugePageAllocation;
+    float loadFactor = constants::DEFAULT_LOAD_FACTOR;
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        analyseMissingLookups<HashMapLL<std::string, float>>("LL", data, value, loadFactor, results);
+        analyseMissingLookups<HashMapDH<std::string, float>>("DH", data, value, loadFactor, results);
+        analyseMissingLookups<HashMapRH<std::string, float>>("RH", data, value, loadFactor, results);
+        analyseMissingLookups<HashMapLL<std::string, float, std::hash<std::string>, HugePageAllocation>>(
+                "LL-HUGE", data, value, loadFactor, results);
+        analyseMissingLookups<HashMapDH<std::string, float, std::hash<std::string>, HugePageAllocation>>(
+                "DH-HUGE", data, value, loadFactor, results);
+        analyseMissingLookups<HashMapRH<std::string, float, std::hash<std::string>, HugePageAllocation>>(
+                "RH-HUGE", data, value, loadFactor, results);
+    }
+
+    return results;
+}
+
+// Every reader looks up all keys once while the writer keeps replacing values, with perfect scaling the wall time
+// stays flat as readers are added
+std::vector<std::string> analyseConcurrentReads(const std::vector<std::vector<std::string>>& data) {
+    std::vector<int> readerCounts = {1, 2, 4, 8};
+    float loadFactor = constants::DEFAULT_LOAD_FACTOR;
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+        SeqLockHashMapRH<std::string, float> hashMap(nearestPowerOf2(hashMapSize), loadFactor);
+        for (size_t e = 0; e < value; e++) {
+            hashMap.put(data[e][0], std::stof(data[e][1]));
+        }
+
+        for (int readerCount : readerCounts) {
+            std::atomic<bool> done(false);
+            std::thread writer([&hashMap, &data, &done, value]() {
+                for (size_t e = 0; !done.load(); e = (e + 1) % value) hashMap.put(data[e][0], static_cast<float>(e));
+            });
+
+            std::vector<std::thread> readers;
             auto start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapLL->put(data[e][0], std::stof(data[e][1]));
+            for (int r = 0; r < readerCount; r++) {
+                readers.emplace_back([&hashMap, &data, value]() {
+                    for (size_t e = 0; e < value; e++) hashMap.containsKey(data[e][0]);
+                });
             }
+            for (auto &reader : readers) reader.join();
             auto stop = std::chrono::high_resolution_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "LL",
-                         value,
-                         loadFactor,
-                         "put",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapDH->put(data[e][0], std::stof(data[e][1]));
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "DH",
-                         value,
-                         loadFactor,
-                         "put",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapRH->put(data[e][0], std::stof(data[e][1]));
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "RH",
-                         value,
-                         loadFactor,
-                         "put",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-
-            // Coping data for shuffling and further benchmarks
-            std::vector<std::vector<std::string>> copiedData(data.begin(), data.begin() + value);
-            std::random_device rd;
-            std::mt19937 rng(rd());
-            std::shuffle(copiedData.begin(), copiedData.end(), rng);
-
-            // Looking up for elements in hash maps and benchmarking performance
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapLL->containsKey(copiedData[e][0]);
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "LL",
-                         value,
-                         loadFactor,
-                         "containsKey",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapDH->containsKey(copiedData[e][0]);
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "DH",
-                         value,
-                         loadFactor,
-                         "containsKey",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapRH->containsKey(copiedData[e][0]);
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "RH",
-                         value,
-                         loadFactor,
-                         "containsKey",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            // Intentionally looking for element that does not exist in hash maps and benchmarking performance
-            start = std::chrono::high_resolution_clock::now();
-            hashMapLL->containsKey("im-not-existing");
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "LL",
-                         value,
-                         loadFactor,
-                         "containsKeyFailed",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            hashMapDH->containsKey("im-not-existing");
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "DH",
-                         value,
-                         loadFactor,
-                         "containsKeyFailed",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            hashMapLL->containsKey("im-not-existing");
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "RH",
-                         value,
-                         loadFactor,
-                         "containsKeyFailed",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            // Removing elements from hash maps and benchmarking performance
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapLL->remove(copiedData[e][0]);
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "LL",
-                         value,
-                         loadFactor,
-                         "remove",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapDH->remove(copiedData[e][0]);
-            }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "DH",
-                         value,
-                         loadFactor,
-                         "remove",
-                         duration.count());
-            results.push_back(convertToString(buffer));
-
-            start = std::chrono::high_resolution_clock::now();
-            for (size_t e = 0; e < value; e++) {
-                hashMapRH->remove(copiedData[e][0]);
+
+            done.store(true);
+            writer.join();
+            results.push_back(formatResult("RH-SEQ-" + std::to_string(readerCount), value, loadFactor,
+                                           "containsKeyConcurrent", stop - start));
+        }
+    }
+
+    return results;
+}
+
+template <typename Cache>
+void analyseCacheAccesses(const std::string &name, const std::vector<std::vector<std::string>>& data,
+                          const std::vector<size_t> &accesses, int value, std::vector<std::string> &results) {
+    Cache cache(std::max(value / 10, 1));
+    size_t hits = 0;
+
+    // A miss loads the element from the data set, as a read-through cache would
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t e : accesses) {
+        if (cache.containsKey(data[e][0])) {
+            cache.get(data[e][0]);
+            hits++;
+        } else {
+            cache.put(data[e][0], std::stof(data[e][1]));
+        }
+    }
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    std::cout << name << " " << value << " hit rate: " << static_cast<double>(hits) / accesses.size() << "\n";
+    results.push_back(formatResult(name, value, constants::DEFAULT_LOAD_FACTOR, "cacheAccess", stop - start));
+}
+
+// Keys are drawn from a Zipf distribution over the first elements of the data set while the cache holds a tenth of
+// them, so the policies differ only in which cold keys they keep
+std::vector<std::string> analyseCache(const std::vector<std::vector<std::string>>& data) {
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        std::vector<double> weights(value);
+        for (int i = 0; i < value; i++) weights[i] = 1.0 / (i + 1);
+        std::discrete_distribution<size_t> zipf(weights.begin(), weights.end());
+        std::mt19937 generator(value);
+
+        std::vector<size_t> accesses(10 * static_cast<size_t>(value));
+        for (size_t &access : accesses) access = zipf(generator);
+
+        analyseCacheAccesses<LruHashMap<std::string, float>>("LRU", data, accesses, value, results);
+        analyseCacheAccesses<LruHashMap<std::string, float, std::hash<std::string>, ClockEviction>>(
+                "CLOCK", data, accesses, value, results);
+    }
+
+    return results;
+}
+
+template <typename HashMap>
+void analyseRandomLookups(const std::string &name, HashMap &hashMap, size_t value, std::vector<std::string> &results) {
+    // Keys are the mixed element indices, which the bijective mix keeps distinct, so no array of keys has to fit in
+    // memory next to the map
+    for (size_t e = 0; e < value; e++) hashMap.put(radix::mix(e), static_cast<float>(e));
+
+    std::mt19937_64 generator(value);
+    size_t found = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t e = 0; e < value; e++) found += hashMap.containsKey(radix::mix(generator() % value));
+    auto stop = std::chrono::high_resolution_clock::now();
+    check(found == value, name + " lost " + std::to_string(value - found) + " keys");
+    results.push_back(formatResult(name, static_cast<int>(value), constants::DEFAULT_LOAD_FACTOR,
+                                   "containsKeyOutOfCore", stop - start));
+}
+
+// Looks up keys in random order in a file backed map and, while it fits in memory, in a heap one. Every slot of the
+// file takes 32 bytes, so with the default OUT_OF_CORE_MAX_KEYS the file takes about 256 MB and is served from the
+// page cache: lookups then measure the mapping but no page faults. Runs larger than the physical memory pass a key
+// count whose file exceeds it, the heap map stops at OUT_OF_CORE_MAX_KEYS so that it is never swapped out.
+std::vector<std::string> analyseOutOfCore(size_t maxKeys) {
+    std::vector<size_t> values;
+    for (size_t value = 1000; value < maxKeys; value *= 10) values.push_back(value);
+    values.push_back(maxKeys);
+    std::string path = "benchmark-mapped.bin";
+
+    std::vector<std::string> results;
+    for (size_t value : values) {
+        auto hashMapSize = nearestPowerOf2(static_cast<size_t>(std::floor(value / constants::DEFAULT_LOAD_FACTOR)));
+
+        std::remove(path.c_str());
+        {
+            MappedHashMapRH<uint64_t, float> hashMap(path, hashMapSize);
+            analyseRandomLookups("RH-MAPPED", hashMap, value, results);
+        }
+        std::remove(path.c_str());
+
+        if (value > OUT_OF_CORE_MAX_KEYS) continue;
+        HashMapRH<uint64_t, float> hashMap(hashMapSize);
+        analyseRandomLookups("RH", hashMap, value, results);
+    }
+
+    return results;
+}
+
+template <typename HashMap, typename F>
+void analyseScanOf(const std::string &name, HashMap &hashMap, F scan, double expected, int value,
+                   std::vector<std::string> &results) {
+    // Values are summed in double, so every visiting order ends within rounding of the sum of the inserted values
+    double sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    scan(hashMap, sum);
+    auto stop = std::chrono::high_resolution_clock::now();
+    check(std::abs(sum - expected) <= 1e-9 * (std::abs(expected) + 1),
+          name + " summed to " + std::to_string(sum) + " instead of " + std::to_string(expected));
+    results.push_back(formatResult(name, value, constants::DEFAULT_LOAD_FACTOR, "scan", stop - start));
+}
+
+// Visits every element once. The insertion-ordered map walks its dense array, the other maps their whole bucket
+// arrays through an eraseIf that keeps everything, and once more split over threads with parallelReduce. Bytes taken
+// by the tables are printed alongside.
+std::vector<std::string> analyseScan(const std::vector<std::vector<std::string>>& data) {
+    float loadFactor = constants::DEFAULT_LOAD_FACTOR;
+    auto keepAll = [](double &sum) { return [&sum](const std::string &, const float &v) { sum += v; return false; }; };
+    auto reduce = [](auto &map, double &sum) {
+        sum = map.parallelReduce(0.0, [](double acc, const std::string &, const float &v) { return acc + v; },
+                                 [](double a, double b) { return a + b; });
+    };
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+        OrderedHashMapRH<std::string, float> ordered(nearestPowerOf2(hashMapSize), loadFactor);
+        HashMapLL<std::string, float> ll(hashMapSize, loadFactor);
+        HashMapDH<std::string, float> dh(hashMapSize, loadFactor);
+        HashMapRH<std::string, float> rh(nearestPowerOf2(hashMapSize), loadFactor);
+        for (size_t e = 0; e < value; e++) {
+            ordered.put(data[e][0], std::stof(data[e][1]));
+            ll.put(data[e][0], std::stof(data[e][1]));
+            dh.put(data[e][0], std::stof(data[e][1]));
+            rh.put(data[e][0], std::stof(data[e][1]));
+        }
+
+        // Later rows of a repeated key replace the earlier ones, so the expected sum is taken from a map as well
+        double expected = 0;
+        ordered.forEach([&expected](const std::string &, float &v) { expected += v; });
+
+        auto sweep = [&keepAll](auto &map, double &sum) { map.eraseIf(keepAll(sum)); };
+        analyseScanOf("RH-ORDERED", ordered, [](auto &map, double &sum) {
+            map.forEach([&sum](const std::string &, float &v) { sum += v; });
+        }, expected, value, results);
+        analyseScanOf("LL", ll, sweep, expected, value, results);
+        analyseScanOf("DH", dh, sweep, expected, value, results);
+        analyseScanOf("RH", rh, sweep, expected, value, results);
+        analyseScanOf("LL-PARALLEL", ll, reduce, expected, value, results);
+        analyseScanOf("DH-PARALLEL", dh, reduce, expected, value, results);
+        analyseScanOf("RH-PARALLEL", rh, reduce, expected, value, results);
+
+        std::cout << "RH-ORDERED " << value << " index bytes: " << ordered.getIndexBytes()
+                  << ", entry bytes: " << ordered.getEntryBytes()
+                  << ", DH slot bytes: " << dh.getCapacity() * sizeof(HashMapEntryDH<std::string, float>)
+                  << ", RH bucket and entry bytes: " << rh.getCapacity() * sizeof(HashMapEntryRH<std::string, float> *)
+                                                        + rh.getSize() * sizeof(HashMapEntryRH<std::string, float>)
+                  << "\n";
+    }
+
+    return results;
+}
+
+template <typename Join>
+size_t analyseJoinOf(const std::string &name, Join &join, const std::vector<std::pair<int, int>> &build,
+                     const std::vector<std::pair<int, int>> &probe, std::vector<std::string> &results) {
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t matches = join.join(build, probe, [](const std::vector<typename Join::Match> &) {});
+    auto stop = std::chrono::high_resolution_clock::now();
+    check(matches >= probe.size() / 2, name + " matched only " + std::to_string(matches) + " rows");
+    results.push_back(formatResult(name, static_cast<int>(build.size()), constants::DEFAULT_LOAD_FACTOR, "join",
+                                   stop - start));
+    return matches;
+}
+
+// Joins a build side of random keys with a probe side as large, half of whose keys come from the build side. A single
+// table over the whole build side is compared with radix partitioned joins on all cores, for robin hood tables of
+// entry pointers and for flat linear probing ones, all of which have to find the same matches. Rows are generated,
+// so the build side grows past the last level cache, up to maxRows rows per side; 100M rows take a few GB.
+std::vector<std::string> analyseJoin(size_t maxRows) {
+    std::mt19937 generator(42);
+    using FlatJoin = HashJoin<int, int, int, std::hash<int>, OpenAddressingMap<int, size_t>>;
+
+    std::vector<std::string> results;
+    for (size_t rows = 1000; rows <= maxRows; rows *= 10) {
+        int value = static_cast<int>(rows);
+        std::vector<std::pair<int, int>> build(value), probe(value);
+        for (int i = 0; i < value; i++) build[i] = {static_cast<int>(generator() >> 1), i};
+        for (int i = 0; i < value; i++) {
+            int key = i % 2 == 0 ? build[generator() % value].first : static_cast<int>(generator() >> 1);
+            probe[i] = {key, i};
+        }
+
+        HashJoin<int, int, int> single(0);
+        size_t matches = analyseJoinOf("RH", single, build, probe, results);
+        HashJoin<int, int, int> radix;
+        check(analyseJoinOf("RH-RADIX", radix, build, probe, results) == matches, "RH-RADIX matched other rows");
+        FlatJoin flatSingle(0);
+        check(analyseJoinOf("OA", flatSingle, build, probe, results) == matches, "OA matched other rows");
+        FlatJoin flatRadix;
+        check(analyseJoinOf("OA-RADIX", flatRadix, build, probe, results) == matches, "OA-RADIX matched other rows");
+    }
+
+    return results;
+}
+
+template <typename F>
+void analyseGroupByOf(const std::string &name, F aggregate, int value, std::vector<std::string> &results) {
+    auto start = std::chrono::high_resolution_clock::now();
+    size_t groups = aggregate();
+    auto stop = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    std::cout << name << " " << value << " groups: " << groups << ", rows/s: " << static_cast<size_t>(value / seconds)
+              << "\n";
+    results.push_back(formatResult(name, value, constants::DEFAULT_LOAD_FACTOR, "groupBy", stop - start));
+}
+
+// Sums, counts and bounds column 1 grouped by column 0. Rows are streamed to GroupBy in chunks, which every thread
+// pre-aggregates into a map of its own, while the baseline upserts every row into a single robin hood map on one
+// thread. Rows per second are printed alongside.
+std::vector<std::string> analyseGroupBy(const std::vector<std::vector<std::string>>& data) {
+    std::vector<int> values = {1000, 10000, 50000, 100000, 150000};
+    const size_t chunkSize = 65536;
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        std::vector<std::vector<std::pair<std::string, float>>> chunks;
+        for (size_t e = 0; e < value; e++) {
+            if (e % chunkSize == 0) chunks.emplace_back();
+            chunks.back().emplace_back(data[e][0], std::stof(data[e][1]));
+        }
+
+        analyseGroupByOf("RH", [&chunks]() {
+            HashMapRH<std::string, Aggregate<float>> groups;
+            for (auto &chunk : chunks) {
+                for (auto &row : chunk) {
+                    float v = row.second;
+                    groups.upsert(row.first, [v](Aggregate<float> &aggregate) { aggregate.add(v); });
+                }
             }
-            stop = std::chrono::high_resolution_clock::now();
-            duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
-            std::sprintf(buffer,
-                         "%s,%d,%.2f,%s,%lld",
-                         "RH",
-                         value,
-                         loadFactor,
-                         "remove",
-                         duration.count());
-            results.push_back(convertToString(buffer));
+            return groups.getSize();
+        }, value, results);
+
+        analyseGroupByOf("RH-GROUPBY", [&chunks]() {
+            GroupBy<std::string, float> groupBy;
+            for (auto &chunk : chunks) groupBy.add(chunk);
+            groupBy.finish();
+            return groupBy.getGroups();
+        }, value, results);
+    }
+
+    return results;
+}
+
+template <typename HashMap>
+void reportObserver(const std::string &name, const std::vector<std::vector<std::string>>& data, int value) {
+    HashMap hashMap(constants::DEFAULT_CAPACITY);
+
+    // Removing and putting back every other element lets double hashing reuse the slots freed by the removals
+    for (size_t e = 0; e < value; e++) hashMap.put(data[e][0], std::stof(data[e][1]));
+    for (size_t e = 0; e < value; e++) hashMap.containsKey(data[e][0]);
+    for (size_t e = 0; e < value; e += 2) hashMap.remove(data[e][0]);
+    for (size_t e = 0; e < value; e += 2) hashMap.put(data[e][0], std::stof(data[e][1]));
+
+    auto &observer = hashMap.getObserver();
+    std::cout << name << " " << value << " long probes: " << observer.getLongProbes()
+              << ", longest probe: " << observer.getLongestProbe()
+              << ", rehashes: " << observer.getRehashes()
+              << ", rehash time: " << std::chrono::duration<double, std::milli>(observer.getRehashTime()).count()
+              << " ms, tombstone reuses: " << observer.getTombstoneReuses()
+              << ", robin hood swaps: " << observer.getRobinHoodSwaps() << "\n";
+
+}
+
+// Grows every map from the default capacity with observers attached, so the printed counters show how often each
+// one probes far, rehashes, reuses removed slots or displaces entries on the way
+void analyseObservers(const std::vector<std::vector<std::string>>& data) {
+    int value = 150000;
+    using Observer = CountingObserver<16, 8>;
+
+    reportObserver<HashMapLL<std::string, float, std::hash<std::string>, allocation::HeapAllocation, Observer>>(
+            "LL", data, value);
+    reportObserver<HashMapDH<std::string, float, std::hash<std::string>, allocation::HeapAllocation, Observer>>(
+            "DH", data, value);
+    reportObserver<HashMapRH<std::string, float, std::hash<std::string>, allocation::HeapAllocation, Observer>>(
+            "RH", data, value);
+}
+
+// Hashes every key into a handful of values to simulate hash-flooding on user-supplied keys
+struct FloodingHash {
+    size_t operator()(const std::string &key) const { return key.size() % 4; }
+};
+
+std::vector<std::string> analyseCollisionFlood(const std::vector<std::vector<std::string>>& data) {
+    float loadFactor = constants::DEFAULT_LOAD_FACTOR;
+
+    HashMapLL<std::string, float, FloodingHash> *hashMapLL;
+
+    std::vector<std::string> results;
+    for (int value : ELEMENT_COUNTS) {
+        auto hashMapSize = static_cast<size_t>(std::floor(value / loadFactor));
+        hashMapLL = new HashMapLL<std::string, float, FloodingHash>(nearestPowerOf2(hashMapSize), loadFactor);
+
+        for (size_t e = 0; e < value; e++) {
+            hashMapLL->put(data[e][0], std::stof(data[e][1]));
         }
+
+        // Looking up for every element while all of them share a few buckets
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t e = 0; e < value; e++) {
+            hashMapLL->containsKey(data[e][0]);
+        }
+        auto stop = std::chrono::high_resolution_clock::now();
+        results.push_back(formatResult("LL", value, loadFactor, "containsKeyFlooded", stop - start));
+
+        delete hashMapLL;
     }
 
     return results;
@@ -289,10 +749,39 @@ std::string writeToCSVFile(const std::vector<std::string>& results) {
 }
 
 int main(int argc, char *argv[]) {
-    if (argc != 2) throw std::invalid_argument("Benchmark requires the path of file from which it reads data");
+    if (argc < 2 || argc > 4) {
+        throw std::invalid_argument("Benchmark requires the path of file from which it reads data, optionally followed "
+                                    "by the largest number of rows joined and of keys in the file backed map");
+    }
     std::vector args(argv + 1, argv + argc);
-
-    auto results = analyse(getData(args[0]));
+    size_t joinMaxRows = argc >= 3 ? std::stoul(args[1]) : JOIN_MAX_ROWS;
+    size_t outOfCoreMaxKeys = argc == 4 ? std::stoul(args[2]) : OUT_OF_CORE_MAX_KEYS;
+
+    auto data = getData(args[0]);
+    auto results = analyse(data);
+    auto floodResults = analyseCollisionFlood(data);
+    results.insert(results.end(), floodResults.begin(), floodResults.end());
+    auto openAddressingResults = analyseOpenAddressing(data);
+    results.insert(results.end(), openAddressingResults.begin(), openAddressingResults.end());
+    auto bulkBuildResults = analyseBulkBuild(data);
+    results.insert(results.end(), bulkBuildResults.begin(), bulkBuildResults.end());
+    auto purgeResults = analysePurge(data);
+    results.insert(results.end(), purgeResults.begin(), purgeResults.end());
+    auto allocationResults = analyseAllocation(data);
+    results.insert(results.end(), allocationResults.begin(), allocationResults.end());
+    auto concurrentResults = analyseConcurrentReads(data);
+    results.insert(results.end(), concurrentResults.begin(), concurrentResults.end());
+    auto cacheResults = analyseCache(data);
+    results.insert(results.end(), cacheResults.begin(), cacheResults.end());
+    auto scanResults = analyseScan(data);
+    results.insert(results.end(), scanResults.begin(), scanResults.end());
+    auto joinResults = analyseJoin(joinMaxRows);
+    results.insert(results.end(), joinResults.begin(), joinResults.end());
+    auto groupByResults = analyseGroupBy(data);
+    results.insert(results.end(), groupByResults.begin(), groupByResults.end());
+    auto outOfCoreResults = analyseOutOfCore(outOfCoreMaxKeys);
+    results.insert(results.end(), outOfCoreResults.begin(), outOfCoreResults.end());
+    analyseObservers(data);
     std::cout << writeToCSVFile(results) << "\n";
 
     return 0;
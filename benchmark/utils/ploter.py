@@ -6,70 +6,75 @@ from os import listdir, mkdir
 from os.path import exists, isdir, isfile, join
 from dataclasses import dataclass
 from enum import Enum
-from copy import deepcopy
 
 
 class Operations(Enum):
     PUT = 'PUT'
     CONTAINS_KEY = 'LOOKUP'
     REMOVE = 'REMOVE'
-    CONTAINS_KEY_FAILED = 'FAILED LOOKUP'
+    CONTAINS_KEY_FAILED = 'FAILED LOOKUPS'
+    CONTAINS_KEY_FLOODED = 'FLOODED LOOKUP'
+    BUILD_FROM = 'BULK BUILD'
+    CONTAINS_KEY_MISSING = 'MISSING LOOKUPS'
+    CONTAINS_KEY_CONCURRENT = 'CONCURRENT LOOKUPS'
+    CACHE_ACCESS = 'CACHE ACCESSES'
+    CONTAINS_KEY_OUT_OF_CORE = 'OUT OF CORE LOOKUPS'
+    ERASE_IF = 'PURGE'
+    SCAN = 'SCAN'
+    JOIN = 'JOIN'
+    GROUP_BY = 'GROUP BY'
 
 
 CONVERTER = {
     'put': Operations.PUT,
     'containsKey': Operations.CONTAINS_KEY,
     'remove': Operations.REMOVE,
-    'containsKeyFailed': Operations.CONTAINS_KEY_FAILED
+    'containsKeyFailed': Operations.CONTAINS_KEY_FAILED,
+    'containsKeyFlooded': Operations.CONTAINS_KEY_FLOODED,
+    'buildFrom': Operations.BUILD_FROM,
+    'containsKeyMissing': Operations.CONTAINS_KEY_MISSING,
+    'containsKeyConcurrent': Operations.CONTAINS_KEY_CONCURRENT,
+    'cacheAccess': Operations.CACHE_ACCESS,
+    'containsKeyOutOfCore': Operations.CONTAINS_KEY_OUT_OF_CORE,
+    'eraseIf': Operations.ERASE_IF,
+    'scan': Operations.SCAN,
+    'join': Operations.JOIN,
+    'groupBy': Operations.GROUP_BY
 }
 
 
 @dataclass
 class HashMapResults:
     name: str
-    ranges: list[int]
-    results: dict[Operations, list[list[int]]]
+    results: dict[Operations, dict[int, list[int]]]
 
-    def get_average(self, operation: Operations) -> list[int]:
-        return [sum(elements) / len(elements) for elements in zip(*self.results[operation])]
+    def get_ranges(self, operation: Operations) -> list[int]:
+        return sorted(self.results[operation])
 
-    def get_operations(self) -> list[Operations]:
-        return [k for k, v in self.results.items()]
+    def get_average(self, operation: Operations) -> list[float]:
+        return [sum(times) / len(times) for _, times in sorted(self.results[operation].items())]
 
+    def has_results(self, operation: Operations) -> bool:
+        return bool(self.results[operation])
 
-def get_results(files: list[str]) -> dict[str, list[HashMapResults]]:
-    ranges = list()
-    data = dict()
 
-    operations = {
-        Operations.PUT: [[] for _ in range(len(files))],
-        Operations.CONTAINS_KEY: [[] for _ in range(len(files))],
-        Operations.REMOVE: [[] for _ in range(len(files))],
-        Operations.CONTAINS_KEY_FAILED: [[] for _ in range(len(files))]
-    }
+def get_results(files: list[str]) -> dict[str, dict[str, HashMapResults]]:
+    # Maps are discovered from the files in order of appearance, times of the same size from every file are averaged
+    data = dict()
 
-    for idx, filename in enumerate(files):
+    for filename in files:
         with open(filename, 'r') as f:
             reader = csv.reader(f)
             next(reader, None)
             for row in reader:
-                if row[1] not in ranges:
-                    ranges.append(row[1])
-
-                if row[2] not in data:
-                    data[row[2]] = [HashMapResults(name, list(), deepcopy(operations)) for name in ('LL', 'DH', 'RH')]
+                if row[3] not in CONVERTER:
+                    continue
 
-                match row[0]:
-                    case 'LL':
-                        data[row[2]][0].results[CONVERTER[row[3]]][idx].append(int(row[4]))
-                    case 'DH':
-                        data[row[2]][1].results[CONVERTER[row[3]]][idx].append(int(row[4]))
-                    case 'RH':
-                        data[row[2]][2].results[CONVERTER[row[3]]][idx].append(int(row[4]))
+                maps = data.setdefault(row[2], dict())
+                if row[0] not in maps:
+                    maps[row[0]] = HashMapResults(row[0], {operation: dict() for operation in Operations})
 
-    for _, v in data.items():
-        for hm in v:
-            hm.ranges = ranges
+                maps[row[0]].results[CONVERTER[row[3]]].setdefault(int(row[1]), list()).append(int(row[4]))
 
     return data
 
@@ -108,23 +113,19 @@ def main() -> None:
     mkdir('./assets') if args.save and not isdir('./assets') else None
 
     for lf, maps in results.items():
-        ll, dh, rh = maps
-        for operation in ll.get_operations():
-            x = [format_number(int(n)) for n in ll.ranges]
-            if operation == Operations.CONTAINS_KEY_FAILED:
-                plt.plot(x, ll.get_average(operation), label=ll.name, linestyle='-', marker='o', markersize=3.5)
-                plt.plot(x, dh.get_average(operation), label=dh.name, linestyle='-', marker='o', markersize=3.5)
-                plt.plot(x, rh.get_average(operation), label=rh.name, linestyle='-', marker='o', markersize=3.5)
-                plt.ylabel('Time [ns]')
-            else:
-                plt.plot(x, list(map(lambda ns: ns / 1000000, ll.get_average(operation))),
-                         label=ll.name, linestyle='-', marker='o', markersize=3.5)
-                plt.plot(x, list(map(lambda ns: ns / 1000000, dh.get_average(operation))),
-                         label=dh.name, linestyle='-', marker='o', markersize=3.5)
-                plt.plot(x, list(map(lambda ns: ns / 1000000, rh.get_average(operation))),
-                         label=rh.name, linestyle='-', marker='o', markersize=3.5)
-                plt.ylabel('Time [ms]')
-            plt.xticks(x)
+        for operation in Operations:
+            plotted = [hm for hm in maps.values() if hm.has_results(operation)]
+            if not plotted:
+                continue
+
+            # Benchmarks differ in the sizes they measure, every map is drawn against its own sizes on a shared axis
+            ranges = sorted({n for hm in plotted for n in hm.get_ranges(operation)})
+            for hm in plotted:
+                x = [ranges.index(n) for n in hm.get_ranges(operation)]
+                plt.plot(x, list(map(lambda ns: ns / 1000000, hm.get_average(operation))),
+                         label=hm.name, linestyle='-', marker='o', markersize=3.5)
+            plt.ylabel('Time [ms]')
+            plt.xticks(range(len(ranges)), [format_number(n) for n in ranges])
             plt.grid()
             plt.legend()
             plt.xlabel('Number of entries in hash map')
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "Constants.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace allocation {
+    enum class Numa { Local, Interleave, Bind };
+
+    // Plain value-initialized new[], what every map used before allocation became a policy. Entries are created and
+    // destroyed with new and delete.
+    struct HeapAllocation {
+        template <typename T>
+        static T *allocate(size_t count) { return new T[count](); }
+
+        template <typename T>
+        static void deallocate(T *buckets, size_t) { delete []buckets; }
+
+        template <typename T, typename... Args>
+        static T *create(Args &&...args) { return new T(std::forward<Args>(args)...); }
+
+        template <typename T>
+        static void destroy(T *entry) { delete entry; }
+
+        static constexpr bool needsDeallocation() { return true; }
+        static constexpr bool threadSafe = true;
+    };
+
+    // Arrays spanning at least one page of PageSize bytes are mmap-ed and aligned to it. Reserved hugetlbfs pages
+    // are tried first, then transparent huge pages via madvise. Before the first touch the memory is interleaved
+    // over all allowed NUMA nodes or bound to Node. Smaller arrays and other platforms fall back to the heap.
+    template <size_t PageSize = constants::HUGE_PAGE_SIZE, Numa Mode = Numa::Local, int Node = 0>
+    struct MappedAllocation : HeapAllocation {
+        static size_t mappedBytes(size_t bytes) {
+            if (bytes < PageSize) return 0;
+            return (bytes + PageSize - 1) / PageSize * PageSize;
+        }
+
+#ifdef __linux__
+        static void *map(size_t length) {
+            int pageFlag = 0;
+#ifdef MAP_HUGE_SHIFT
+            pageFlag = (PageSize == constants::GIGANTIC_PAGE_SIZE ? 30 : 21) << MAP_HUGE_SHIFT;
+#endif
+            void *memory = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | pageFlag, -1, 0);
+            if (memory != MAP_FAILED) return memory;
+
+            // Over-map by one page so the region can be trimmed to a page aligned one
+            memory = mmap(nullptr, length + PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED) throw std::bad_alloc();
+
+            auto start = reinterpret_cast<uintptr_t>(memory);
+            uintptr_t aligned = (start + PageSize - 1) / PageSize * PageSize;
+            if (aligned > start) munmap(memory, aligned - start);
+            munmap(reinterpret_cast<void *>(aligned + length), start + PageSize - aligned);
+
+            memory = reinterpret_cast<void *>(aligned);
+            madvise(memory, length, MADV_HUGEPAGE);
+            return memory;
+        }
+
+        static void place(void *memory, size_t length) {
+            // Raw syscalls keep libnuma optional, failures leave the kernel's default first touch placement
+            constexpr int MPOL_BIND_MODE = 2;
+            constexpr int MPOL_INTERLEAVE_MODE = 3;
+            constexpr unsigned long MPOL_F_MEMS_ALLOWED_FLAG = 1 << 2;
+            constexpr unsigned long MAX_NODES = 64;
+
+            unsigned long nodes = 1UL << Node;
+            if constexpr (Mode == Numa::Bind) syscall(SYS_mbind, memory, length, MPOL_BIND_MODE, &nodes, MAX_NODES, 0);
+            if constexpr (Mode == Numa::Interleave) {
+                int policy;
+                long status = syscall(SYS_get_mempolicy, &policy, &nodes, MAX_NODES, nullptr, MPOL_F_MEMS_ALLOWED_FLAG);
+                if (status != 0) return;
+                syscall(SYS_mbind, memory, length, MPOL_INTERLEAVE_MODE, &nodes, MAX_NODES, 0);
+            }
+        }
+#endif
+
+        template <typename T>
+        static T *allocate(size_t count) {
+#ifdef __linux__
+            size_t length = mappedBytes(count * sizeof(T));
+            if (length != 0) {
+                void *memory = map(length);
+                place(memory, length);
+
+                T *buckets = static_cast<T *>(memory);
+                for (size_t i = 0; i < count; i++) new (buckets + i) T();
+                return buckets;
+            }
+#endif
+            return HeapAllocation::allocate<T>(count);
+        }
+
+        template <typename T>
+        static void deallocate(T *buckets, size_t count) {
+#ifdef __linux__
+            size_t length = mappedBytes(count * sizeof(T));
+            if (length != 0) {
+                for (size_t i = 0; i < count; i++) buckets[i].~T();
+                munmap(buckets, length);
+                return;
+            }
+#endif
+            HeapAllocation::deallocate(buckets, count);
+        }
+    };
+
+    using HugePageAllocation = MappedAllocation<>;
+    using GiganticPageAllocation = MappedAllocation<constants::GIGANTIC_PAGE_SIZE>;
+    using InterleavedAllocation = MappedAllocation<constants::HUGE_PAGE_SIZE, Numa::Interleave>;
+    template <int Node>
+    using BoundAllocation = MappedAllocation<constants::HUGE_PAGE_SIZE, Numa::Bind, Node>;
+
+    // Buckets and entries come from a std::pmr memory resource given to the map, the default resource otherwise.
+    // A monotonic buffer resource frees nothing before it is released, so maps of trivially destructible keys and
+    // values allocated from one skip visiting their entries when they are cleared or destroyed.
+    class ResourceAllocation {
+    private:
+        std::pmr::memory_resource *_resource;
+        bool _monotonic;
+
+    public:
+        ResourceAllocation() : ResourceAllocation(std::pmr::get_default_resource()) {}
+        ResourceAllocation(std::pmr::memory_resource *resource)
+                : _resource(resource),
+                  _monotonic(dynamic_cast<std::pmr::monotonic_buffer_resource *>(resource) != nullptr) {}
+
+        std::pmr::memory_resource *getResource() const { return _resource; }
+
+        template <typename T>
+        T *allocate(size_t count) {
+            T *buckets = static_cast<T *>(_resource->allocate(count * sizeof(T), alignof(T)));
+            for (size_t i = 0; i < count; i++) new (buckets + i) T();
+            return buckets;
+        }
+
+        template <typename T>
+        void deallocate(T *buckets, size_t count) {
+            for (size_t i = 0; i < count; i++) buckets[i].~T();
+            _resource->deallocate(buckets, count * sizeof(T), alignof(T));
+        }
+
+        template <typename T, typename... Args>
+        T *create(Args &&...args) {
+            void *memory = _resource->allocate(sizeof(T), alignof(T));
+            return new (memory) T(std::forward<Args>(args)...);
+        }
+
+        template <typename T>
+        void destroy(T *entry) {
+            entry->~T();
+            _resource->deallocate(entry, sizeof(T), alignof(T));
+        }
+
+        bool needsDeallocation() const { return !_monotonic; }
+        // Only synchronized_pool_resource may be shared between threads, maps never create entries concurrently
+        static constexpr bool threadSafe = false;
+    };
+
+    // Copies buckets between arrays of equal length, as one memcpy when the bucket type is trivially copyable
+    template <typename T>
+    void copyBuckets(T *to, const T *from, size_t count) {
+        if constexpr (std::is_trivially_copyable<T>::value) std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+        else std::copy(from, from + count, to);
+    }
+}
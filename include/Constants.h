@@ -1,8 +1,35 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 
 namespace constants {
     constexpr size_t DEFAULT_CAPACITY = 32;
     constexpr float DEFAULT_LOAD_FACTOR = 0.75f;
+    constexpr size_t TREEIFY_THRESHOLD = 8;
+    constexpr size_t UNTREEIFY_THRESHOLD = 6;
+    constexpr size_t CUCKOO_BUCKET_SLOTS = 4;
+    constexpr size_t CUCKOO_MAX_SEARCH = 256;
+    constexpr size_t CUCKOO_MAX_GROWTHS = 4;
+    constexpr size_t HOPSCOTCH_NEIGHBORHOOD = 32;
+    constexpr size_t HOPSCOTCH_MAX_PROBE = 512;
+    constexpr size_t HOPSCOTCH_MAX_GROWTHS = 8;
+    constexpr size_t PARALLEL_MIN_RANGE = 16384;
+    constexpr size_t PARALLEL_CHUNKS_PER_THREAD = 8;
+    constexpr size_t HUGE_PAGE_SIZE = static_cast<size_t>(1) << 21;
+    constexpr size_t GIGANTIC_PAGE_SIZE = static_cast<size_t>(1) << 30;
+    constexpr size_t MAX_READER_THREADS = 128;
+    constexpr size_t RETIRE_BATCH = 64;
+    constexpr size_t EXPIRY_SWEEP_SLOTS = 4;
+    constexpr size_t MAPPED_HEADER_SIZE = 4096;
+    constexpr uint64_t MAPPED_MAGIC = 0x48524d4150534c54;
+    constexpr size_t CACHE_LINE_SIZE = 64;
+    constexpr size_t JOIN_PARTITION_ROWS = 8192;
+    constexpr size_t JOIN_MAX_PARTITION_BITS = 12;
+    constexpr size_t JOIN_BATCH_SIZE = 1024;
+    constexpr size_t GROUP_LOCAL_LIMIT = 16384;
+    constexpr size_t GROUP_PARTITION_BITS = 6;
+    constexpr size_t GROUP_MAX_PARTITION_BITS = 12;
+    constexpr size_t SHARD_BITS = 6;
+    constexpr size_t SHARD_MAX_BITS = 12;
 }
\ No newline at end of file
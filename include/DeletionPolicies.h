@@ -0,0 +1,13 @@
+#pragma once
+
+// Deletion policies for OpenAddressingMap
+//   tombstones - removed entries are only marked, lookups keep probing through them and inserts reuse them;
+//                otherwise following entries are shifted back into the hole, which needs a contiguous probe sequence
+
+struct TombstoneDeletion {
+    static constexpr bool tombstones = true;
+};
+
+struct BackwardShiftDeletion {
+    static constexpr bool tombstones = false;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+// Eviction policies for LruHashMap
+//   touchOnRead - a read moves the entry to the head of the recency list; otherwise it only sets the entry's
+//                 referenced bit and eviction gives referenced entries a second chance (CLOCK), so reads never
+//                 relink list nodes
+
+struct LruEviction {
+    static constexpr bool touchOnRead = true;
+};
+
+struct ClockEviction {
+    static constexpr bool touchOnRead = false;
+};
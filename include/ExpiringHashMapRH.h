@@ -0,0 +1,297 @@
+#pragma once
+
+#include "HashMapEntryTTL.h"
+#include "Constants.h"
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+// Robin hood map whose entries may carry a time to live. Expired entries are treated as missing and reclaimed without
+// ever scanning the whole table: every probe removes the expired entries it passes with a backward shift, and every
+// write sweeps a few more slots from a cursor that wraps around the bucket array.
+// The size counts entries which have not been reclaimed yet, including expired ones.
+template <typename K, typename V, typename H = std::hash<K>, typename C = std::chrono::steady_clock>
+class ExpiringHashMapRH {
+private:
+    HashMapEntryTTL<K, V> **_buckets;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+    size_t _cursor;
+
+    size_t threshold();
+    void rehash();
+    std::chrono::nanoseconds now();
+    int search(const K &key, std::chrono::nanoseconds now);
+    void place(HashMapEntryTTL<K, V> *entry);
+    void eraseAt(size_t index);
+    void sweep(std::chrono::nanoseconds now);
+    V putUntil(const K &key, const V &value, std::chrono::nanoseconds expiresAt);
+
+public:
+    ExpiringHashMapRH();
+    explicit ExpiringHashMapRH(size_t capacity);
+    ExpiringHashMapRH(size_t capacity, float loadFactor);
+    ~ExpiringHashMapRH();
+
+    ExpiringHashMapRH(const ExpiringHashMapRH &) = delete;
+    ExpiringHashMapRH &operator=(const ExpiringHashMapRH &) = delete;
+    ExpiringHashMapRH(ExpiringHashMapRH &&other);
+    ExpiringHashMapRH &operator=(ExpiringHashMapRH &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V put(const K &key, const V &value, std::chrono::nanoseconds ttl);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void clear();
+    void swap(ExpiringHashMapRH &other) noexcept;
+    ExpiringHashMapRH clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C>::ExpiringHashMapRH() : ExpiringHashMapRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C>::ExpiringHashMapRH(size_t capacity)
+        : ExpiringHashMapRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C>::ExpiringHashMapRH(size_t capacity, float loadFactor)
+        : _capacity(capacity), _loadFactor(loadFactor), _size(0), _cursor(0) {
+    _buckets = new HashMapEntryTTL<K, V> *[_capacity]();
+}
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C>::~ExpiringHashMapRH() {
+    if (!this->isEmpty()) this->clear();
+    delete []_buckets;
+}
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C>::ExpiringHashMapRH(ExpiringHashMapRH<K, V, H, C> &&other) : ExpiringHashMapRH() { this->swap(other); }
+
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C> &ExpiringHashMapRH<K, V, H, C>::operator=(ExpiringHashMapRH<K, V, H, C> &&other) {
+    ExpiringHashMapRH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::swap(ExpiringHashMapRH<K, V, H, C> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+    std::swap(_cursor, other._cursor);
+}
+
+// Entries keep their slots and expiry times, expired ones included, and are reclaimed by the copy as they would be here
+template <typename K, typename V, typename H, typename C>
+ExpiringHashMapRH<K, V, H, C> ExpiringHashMapRH<K, V, H, C>::clone() {
+    ExpiringHashMapRH copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i] != nullptr) copy._buckets[i] = new HashMapEntryTTL<K, V>(*_buckets[i]);
+    }
+
+    copy._size = _size;
+    copy._cursor = _cursor;
+    return copy;
+}
+
+template <typename K, typename V, typename H, typename C>
+size_t ExpiringHashMapRH<K, V, H, C>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename C>
+size_t ExpiringHashMapRH<K, V, H, C>::getSize() { return _size; }
+
+template <typename K, typename V, typename H, typename C>
+float ExpiringHashMapRH<K, V, H, C>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H, typename C>
+V ExpiringHashMapRH<K, V, H, C>::put(const K &key, const V &value) {
+    return this->putUntil(key, value, std::chrono::nanoseconds::max());
+}
+
+template <typename K, typename V, typename H, typename C>
+V ExpiringHashMapRH<K, V, H, C>::put(const K &key, const V &value, std::chrono::nanoseconds ttl) {
+    // A deadline past the end of the clock saturates at its maximum, which never expires, instead of overflowing
+    // into the past
+    std::chrono::nanoseconds now = this->now();
+    if (ttl > std::chrono::nanoseconds::zero() && ttl > std::chrono::nanoseconds::max() - now) {
+        return this->putUntil(key, value, std::chrono::nanoseconds::max());
+    }
+    return this->putUntil(key, value, now + ttl);
+}
+
+template <typename K, typename V, typename H, typename C>
+V ExpiringHashMapRH<K, V, H, C>::get(const K &key) {
+    int idx = this->search(key, this->now());
+
+    if (idx != -1) return _buckets[idx]->getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H, typename C>
+V ExpiringHashMapRH<K, V, H, C>::remove(const K &key) {
+    std::chrono::nanoseconds now = this->now();
+    this->sweep(now);
+
+    int idx = this->search(key, now);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    V rtnValue = _buckets[idx]->getValue();
+    this->eraseAt(idx);
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H, typename C>
+bool ExpiringHashMapRH<K, V, H, C>::containsKey(const K &key) { return this->search(key, this->now()) != -1; }
+
+template <typename K, typename V, typename H, typename C>
+bool ExpiringHashMapRH<K, V, H, C>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i] != nullptr) {
+            delete _buckets[i];
+            _buckets[i] = nullptr;
+            _size--;
+        }
+    }
+    _cursor = 0;
+}
+
+template <typename K, typename V, typename H, typename C>
+size_t ExpiringHashMapRH<K, V, H, C>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename V, typename H, typename C>
+std::chrono::nanoseconds ExpiringHashMapRH<K, V, H, C>::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(C::now().time_since_epoch());
+}
+
+template <typename K, typename V, typename H, typename C>
+V ExpiringHashMapRH<K, V, H, C>::putUntil(const K &key, const V &value, std::chrono::nanoseconds expiresAt) {
+    std::chrono::nanoseconds now = this->now();
+    this->sweep(now);
+
+    int idx = this->search(key, now);
+    if (idx != -1) {
+        V rtnValue = _buckets[idx]->getValue();
+        _buckets[idx]->setValue(value);
+        _buckets[idx]->setExpiresAt(expiresAt);
+        return rtnValue;
+    }
+
+    this->place(new HashMapEntryTTL<K, V>(key, value, expiresAt));
+    _size++;
+
+    if (this->threshold() < _size) this->rehash();
+    return V();
+}
+
+template <typename K, typename V, typename H, typename C>
+int ExpiringHashMapRH<K, V, H, C>::search(const K &key, std::chrono::nanoseconds now) {
+    if (this->isEmpty()) return -1;
+    size_t hashValue = _hasher(key) % _capacity;
+
+    size_t itr = 0;
+    while (itr < _capacity) {
+        size_t idx = (hashValue + itr) % _capacity;
+        HashMapEntryTTL<K, V> *current = _buckets[idx];
+        if (current == nullptr) break;
+
+        // The backward shift moves the next entry of the cluster onto this slot, so the same position is examined
+        // again and the probe length stays consistent with the shifted PSL
+        if (current->isExpired(now)) {
+            this->eraseAt(idx);
+            continue;
+        }
+
+        if (itr > current->getPSL()) break;
+        if (current->getKey() == key) return static_cast<int>(idx);
+        itr++;
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::place(HashMapEntryTTL<K, V> *entry) {
+    size_t hashValue = _hasher(entry->getKey()) % _capacity;
+    entry->setPSL(0);
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = (hashValue + itr) % _capacity;
+        if (_buckets[idx] == nullptr) {
+            _buckets[idx] = entry;
+            return;
+        }
+
+        if (_buckets[idx]->getPSL() < entry->getPSL()) std::swap(_buckets[idx], entry);
+        entry->setPSL(entry->getPSL() + 1);
+    }
+}
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::eraseAt(size_t index) {
+    delete _buckets[index];
+    _buckets[index] = nullptr;
+    _size--;
+
+    size_t next = (index + 1) % _capacity;
+    while (_buckets[next] != nullptr && _buckets[next]->getPSL() > 0) {
+        _buckets[next]->setPSL(_buckets[next]->getPSL() - 1);
+        _buckets[index] = _buckets[next];
+        _buckets[next] = nullptr;
+
+        index = next;
+        next = (index + 1) % _capacity;
+    }
+}
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::sweep(std::chrono::nanoseconds now) {
+    // Entries on a probe path are reclaimed by lookups, the cursor catches the ones nobody asks for anymore
+    for (size_t step = 0; step < constants::EXPIRY_SWEEP_SLOTS && !this->isEmpty(); step++) {
+        _cursor %= _capacity;
+        HashMapEntryTTL<K, V> *current = _buckets[_cursor];
+
+        if (current != nullptr && current->isExpired(now)) this->eraseAt(_cursor);
+        if (_buckets[_cursor] == nullptr || !_buckets[_cursor]->isExpired(now)) _cursor++;
+    }
+}
+
+template <typename K, typename V, typename H, typename C>
+void ExpiringHashMapRH<K, V, H, C>::rehash() {
+    std::chrono::nanoseconds now = this->now();
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    HashMapEntryTTL<K, V> **temp = _buckets;
+    _buckets = new HashMapEntryTTL<K, V> *[_capacity]();
+
+    // Every entry is visited anyway, so expired ones are dropped instead of being moved
+    for (size_t i = 0; i < prevCapacity; i++) {
+        HashMapEntryTTL<K, V> *entry = temp[i];
+        if (entry == nullptr) continue;
+
+        if (entry->isExpired(now)) {
+            delete entry;
+            _size--;
+        } else {
+            this->place(entry);
+        }
+    }
+
+    delete []temp;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Constants.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Filter policies for HashMapLL, HashMapDH and HashMapRH. A map with a filter adds the hash of every key it inserts
+// and asks the filter first on get, remove and containsKey, so most lookups of missing keys never touch the buckets:
+//   reset(keys)        - empties the filter and sizes it for given number of keys
+//   add(hash)          - records a key by its full hash
+//   mayContain(hash)   - false only if no key with that hash was added since the last reset
+//   removed(count)     - tells the filter that count added keys are gone, true once it should be rebuilt
+// Removed keys cannot be taken out of a Bloom filter, they only raise its false positive rate, so the map rebuilds
+// the filter from its live keys whenever removed() asks for it and on every rehash.
+// NoFilter answers every query with true and is inlined away.
+
+struct NoFilter {
+    static constexpr bool enabled = false;
+
+    void reset(size_t) {}
+    void add(size_t) {}
+    bool mayContain(size_t) const { return true; }
+    bool removed(size_t) { return false; }
+};
+
+// Bloom filter whose Probes bits of a key all lie in one cache line, so a query costs a single cache miss. Blocks are
+// sized for BitsPerKey bits per expected key, which with the defaults gives about one false positive per hundred
+// queries. A rebuild is requested once the removed keys reach half of the keys the filter was sized for.
+template <size_t BitsPerKey = 10, size_t Probes = 6>
+class BlockedBloomFilter {
+private:
+    static constexpr size_t BLOCK_BITS = constants::CACHE_LINE_SIZE * 8;
+
+    struct alignas(constants::CACHE_LINE_SIZE) Block {
+        uint64_t words[BLOCK_BITS / 64];
+    };
+
+    std::vector<Block> _blocks = std::vector<Block>(1);
+    size_t _expected = 0;
+    size_t _removed = 0;
+
+    // Finalizer of splitmix64, std::hash of integers is the identity and would put consecutive keys in one block
+    static uint64_t mix(uint64_t hash) {
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+        return hash ^ (hash >> 31);
+    }
+
+    template <typename F>
+    void forEachBit(size_t hash, F fn) const {
+        uint64_t mixed = mix(hash);
+        size_t block = mixed % _blocks.size();
+
+        // Bits within the block come from a second round, which is independent of the block index
+        uint64_t bits = mix(mixed);
+        auto first = static_cast<uint32_t>(bits);
+        auto step = static_cast<uint32_t>(bits >> 32) | 1;
+        for (uint32_t i = 0; i < Probes; i++) {
+            uint32_t bit = (first + i * step) % BLOCK_BITS;
+            fn(block, bit / 64, static_cast<uint64_t>(1) << (bit % 64));
+        }
+    }
+
+public:
+    static constexpr bool enabled = true;
+
+    void reset(size_t keys) {
+        size_t blocks = std::max<size_t>(1, (keys * BitsPerKey + BLOCK_BITS - 1) / BLOCK_BITS);
+        _blocks.assign(blocks, Block{});
+        _expected = keys;
+        _removed = 0;
+    }
+
+    void add(size_t hash) {
+        this->forEachBit(hash, [this](size_t block, size_t word, uint64_t mask) {
+            _blocks[block].words[word] |= mask;
+        });
+    }
+
+    bool mayContain(size_t hash) const {
+        bool present = true;
+        this->forEachBit(hash, [this, &present](size_t block, size_t word, uint64_t mask) {
+            present &= (_blocks[block].words[word] & mask) != 0;
+        });
+        return present;
+    }
+
+    bool removed(size_t count) {
+        _removed += count;
+        return _removed * 2 > _expected;
+    }
+
+    size_t getBlocks() const { return _blocks.size(); }
+};
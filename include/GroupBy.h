@@ -0,0 +1,159 @@
+#pragma once
+
+#include "HashMapRH.h"
+#include "Constants.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Sum, count, minimum and maximum of the values of one group. A default constructed aggregate is empty and leaves
+// any aggregate it is merged with unchanged.
+template <typename V>
+struct Aggregate {
+    V sum = V();
+    size_t count = 0;
+    V min = std::numeric_limits<V>::max();
+    V max = std::numeric_limits<V>::lowest();
+
+    void add(const V &value) {
+        sum += value;
+        count++;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    void merge(const Aggregate &other) {
+        sum += other.sum;
+        count += other.count;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+};
+
+// Aggregates values by key over rows streamed in chunks. Every chunk is split over threads, and each thread folds its
+// rows into a small map of its own, with a single upsert per row. Once the map holds more than localLimit groups it
+// is spilled into buffers by partition of the key hash and emptied, so it stays small enough for the cache however
+// many groups there are. finish() merges the spilled partial aggregates into one final map per partition, partitions
+// being merged on separate threads, so no two threads ever update the same map.
+template <typename K, typename V, typename H = std::hash<K>>
+class GroupBy {
+public:
+    using Map = HashMapRH<K, Aggregate<V>, H>;
+    using Row = std::pair<K, V>;
+
+private:
+    H _hasher;
+    size_t _localLimit;
+    size_t _partitionBits;
+    size_t _rows;
+    std::vector<Map> _locals;
+    std::vector<std::vector<std::vector<std::pair<K, Aggregate<V>>>>> _spills;
+    std::vector<Map> _groups;
+
+    size_t partitionOf(const K &key);
+    void spill(size_t thread);
+
+public:
+    GroupBy();
+    explicit GroupBy(size_t localLimit);
+    GroupBy(size_t localLimit, size_t partitionBits);
+
+    size_t getRows();
+    size_t getGroups();
+
+    void add(const std::vector<Row> &rows);
+    void finish();
+
+    Aggregate<V> get(const K &key);
+    template <typename F> void forEach(F fn);
+};
+
+template <typename K, typename V, typename H>
+GroupBy<K, V, H>::GroupBy() : GroupBy(constants::GROUP_LOCAL_LIMIT) {}
+
+template <typename K, typename V, typename H>
+GroupBy<K, V, H>::GroupBy(size_t localLimit) : GroupBy(localLimit, constants::GROUP_PARTITION_BITS) {}
+
+template <typename K, typename V, typename H>
+GroupBy<K, V, H>::GroupBy(size_t localLimit, size_t partitionBits)
+        : _hasher(), _localLimit(localLimit), _partitionBits(partitionBits), _rows(0) {
+    if (localLimit == 0) throw std::invalid_argument("ValueError: Local limit must be positive");
+    if (partitionBits > constants::GROUP_MAX_PARTITION_BITS)
+        throw std::invalid_argument("ValueError: Too many partition bits");
+    _groups.resize(static_cast<size_t>(1) << partitionBits);
+}
+
+template <typename K, typename V, typename H>
+size_t GroupBy<K, V, H>::getRows() { return _rows; }
+
+// Counts only groups merged by finish()
+template <typename K, typename V, typename H>
+size_t GroupBy<K, V, H>::getGroups() {
+    size_t groups = 0;
+    for (Map &map : _groups) groups += map.getSize();
+    return groups;
+}
+
+template <typename K, typename V, typename H>
+size_t GroupBy<K, V, H>::partitionOf(const K &key) { return radix::partitionOf(_hasher(key), _partitionBits); }
+
+template <typename K, typename V, typename H>
+void GroupBy<K, V, H>::spill(size_t thread) {
+    auto &spills = _spills[thread];
+    _locals[thread].forEach([this, &spills](const K &key, const Aggregate<V> &aggregate) {
+        spills[this->partitionOf(key)].push_back({key, aggregate});
+    });
+    _locals[thread].clear();
+}
+
+template <typename K, typename V, typename H>
+void GroupBy<K, V, H>::add(const std::vector<Row> &rows) {
+    size_t threads = parallel::threadCount(rows.size());
+    if (_locals.size() < threads) {
+        _locals.resize(threads);
+        _spills.resize(threads, std::vector<std::vector<std::pair<K, Aggregate<V>>>>(_groups.size()));
+    }
+
+    parallel::forRanges(rows.size(), threads, [this, &rows](size_t begin, size_t end, size_t t) {
+        Map &local = _locals[t];
+        for (size_t i = begin; i < end; i++) {
+            const V &value = rows[i].second;
+            local.upsert(rows[i].first, [&value](Aggregate<V> &aggregate) { aggregate.add(value); });
+            if (local.getSize() > _localLimit) this->spill(t);
+        }
+    });
+    _rows += rows.size();
+}
+
+// Spills what is left in the local maps and merges all spilled aggregates, more rows may be added afterwards
+template <typename K, typename V, typename H>
+void GroupBy<K, V, H>::finish() {
+    for (size_t t = 0; t < _locals.size(); t++) this->spill(t);
+
+    size_t threads = std::min(_groups.size(), parallel::threadCount(_rows));
+    parallel::forChunks(_groups.size(), 1, threads, [this](size_t p, size_t, size_t) {
+        for (auto &spills : _spills) {
+            for (auto &partial : spills[p]) {
+                const Aggregate<V> &other = partial.second;
+                _groups[p].upsert(partial.first, [&other](Aggregate<V> &aggregate) { aggregate.merge(other); });
+            }
+            spills[p].clear();
+            spills[p].shrink_to_fit();
+        }
+    });
+}
+
+template <typename K, typename V, typename H>
+Aggregate<V> GroupBy<K, V, H>::get(const K &key) { return _groups[this->partitionOf(key)].get(key); }
+
+// Visits every group merged by finish(), partition by partition
+template <typename K, typename V, typename H>
+template <typename F>
+void GroupBy<K, V, H>::forEach(F fn) {
+    for (Map &map : _groups) map.forEach([&fn](const K &key, const Aggregate<V> &aggregate) { fn(key, aggregate); });
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "HashMapRH.h"
+#include "Constants.h"
+#include "Parallel.h"
+#include "RadixSort.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Equi-join of two relations of (key, payload) rows. A single table over a build side larger than the last level
+// cache misses the cache on nearly every probe, so both sides are first radix partitioned on bits of the key hash and
+// every partition is then joined on its own, with a table small enough to stay in cache while it is probed.
+// Partitions are spread over threads, which take the next one from a shared counter.
+// Table maps a key to a row of the build side and has to provide a (capacity) constructor, upsert and find, which
+// HashMapRH<K, size_t, H> and the flat OpenAddressingMap<K, size_t, H> do. Rows with equal keys on the build side are
+// chained through their positions, so every one of them is matched.
+template <typename K, typename L, typename R, typename H = std::hash<K>, typename Table = HashMapRH<K, size_t, H>>
+class HashJoin {
+public:
+    using BuildRow = std::pair<K, L>;
+    using ProbeRow = std::pair<K, R>;
+
+    struct Match {
+        const BuildRow *build;
+        const ProbeRow *probe;
+    };
+
+private:
+    // Partitioned copy of a relation: keys with positions of their rows, grouped by partition
+    struct Partitioned {
+        std::vector<std::pair<K, size_t>> rows;
+        std::vector<size_t> offsets;
+    };
+
+    H _hasher;
+    size_t _partitionBits;
+    bool _autoBits;
+    size_t _batchSize;
+
+    size_t partitionOf(const K &key);
+    template <typename Row> Partitioned partition(const std::vector<Row> &rows, size_t threads);
+    template <typename F>
+    size_t joinPartition(size_t p, const Partitioned &build, const Partitioned &probe,
+                         const std::vector<BuildRow> &buildRows, const std::vector<ProbeRow> &probeRows, F &emit);
+
+public:
+    HashJoin();
+    explicit HashJoin(size_t partitionBits);
+    HashJoin(size_t partitionBits, size_t batchSize);
+
+    size_t getPartitionBits();
+
+    template <typename F>
+    size_t join(const std::vector<BuildRow> &build, const std::vector<ProbeRow> &probe, F emit);
+};
+
+template <typename K, typename L, typename R, typename H, typename Table>
+HashJoin<K, L, R, H, Table>::HashJoin()
+        : _hasher(), _partitionBits(0), _autoBits(true), _batchSize(constants::JOIN_BATCH_SIZE) {}
+
+template <typename K, typename L, typename R, typename H, typename Table>
+HashJoin<K, L, R, H, Table>::HashJoin(size_t partitionBits) : HashJoin(partitionBits, constants::JOIN_BATCH_SIZE) {}
+
+template <typename K, typename L, typename R, typename H, typename Table>
+HashJoin<K, L, R, H, Table>::HashJoin(size_t partitionBits, size_t batchSize)
+        : _hasher(), _partitionBits(partitionBits), _autoBits(false), _batchSize(batchSize) {
+    if (partitionBits > constants::JOIN_MAX_PARTITION_BITS)
+        throw std::invalid_argument("ValueError: Too many partition bits");
+    if (batchSize == 0) throw std::invalid_argument("ValueError: Batch size must be positive");
+}
+
+template <typename K, typename L, typename R, typename H, typename Table>
+size_t HashJoin<K, L, R, H, Table>::getPartitionBits() { return _partitionBits; }
+
+template <typename K, typename L, typename R, typename H, typename Table>
+size_t HashJoin<K, L, R, H, Table>::partitionOf(const K &key) {
+    return radix::partitionOf(_hasher(key), _partitionBits);
+}
+
+// Histogram and scatter passes of a radix sort on the partition of every row. Every thread counts its own range of
+// rows first, so in the scatter pass it writes to slots of its own and rows keep their order within a partition.
+template <typename K, typename L, typename R, typename H, typename Table>
+template <typename Row>
+typename HashJoin<K, L, R, H, Table>::Partitioned
+HashJoin<K, L, R, H, Table>::partition(const std::vector<Row> &rows, size_t threads) {
+    size_t partitions = static_cast<size_t>(1) << _partitionBits;
+    std::vector<size_t> bounds = parallel::boundaries(rows.size(), threads);
+    std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(partitions, 0));
+
+    parallel::forBoundaries(bounds, [this, &rows, &counts](size_t begin, size_t end, size_t t) {
+        for (size_t i = begin; i < end; i++) counts[t][this->partitionOf(rows[i].first)]++;
+    });
+
+    Partitioned result;
+    result.offsets.assign(partitions + 1, 0);
+    size_t offset = 0;
+    for (size_t p = 0; p < partitions; p++) {
+        result.offsets[p] = offset;
+        for (size_t t = 0; t < threads; t++) {
+            size_t count = counts[t][p];
+            counts[t][p] = offset;
+            offset += count;
+        }
+    }
+    result.offsets[partitions] = offset;
+
+    result.rows.resize(rows.size());
+    parallel::forBoundaries(bounds, [this, &rows, &counts, &result](size_t begin, size_t end, size_t t) {
+        for (size_t i = begin; i < end; i++) {
+            result.rows[counts[t][this->partitionOf(rows[i].first)]++] = {rows[i].first, i};
+        }
+    });
+    return result;
+}
+
+template <typename K, typename L, typename R, typename H, typename Table>
+template <typename F>
+size_t HashJoin<K, L, R, H, Table>::joinPartition(size_t p, const Partitioned &build, const Partitioned &probe,
+                                                  const std::vector<BuildRow> &buildRows,
+                                                  const std::vector<ProbeRow> &probeRows, F &emit) {
+    size_t begin = build.offsets[p], end = build.offsets[p + 1];
+    if (begin == end || probe.offsets[p] == probe.offsets[p + 1]) return 0;
+
+    // The table keeps the last build row of every key, one based so that a new entry reads as no row at all, and
+    // next links each row to the previous one with the same key
+    Table table(static_cast<size_t>((end - begin) / constants::DEFAULT_LOAD_FACTOR) + 1);
+    std::vector<size_t> next(end - begin);
+    for (size_t i = begin; i < end; i++) {
+        table.upsert(build.rows[i].first, [&next, i, begin](size_t &last) {
+            next[i - begin] = last;
+            last = i - begin + 1;
+        });
+    }
+
+    std::vector<Match> batch;
+    batch.reserve(_batchSize);
+    size_t matches = 0;
+    for (size_t i = probe.offsets[p]; i < probe.offsets[p + 1]; i++) {
+        const size_t *last = table.find(probe.rows[i].first);
+        if (last == nullptr) continue;
+
+        for (size_t row = *last; row != 0; row = next[row - 1]) {
+            batch.push_back({&buildRows[build.rows[begin + row - 1].second], &probeRows[probe.rows[i].second]});
+            if (batch.size() == _batchSize) {
+                emit(batch);
+                matches += batch.size();
+                batch.clear();
+            }
+        }
+    }
+
+    if (!batch.empty()) emit(batch);
+    return matches + batch.size();
+}
+
+// Calls emit with batches of matches and returns how many there were. Batches come from several threads at once, so
+// emit has to be safe to call concurrently; a batch is reused once emit returns, while the rows it points to are the
+// ones passed in and outlive the call.
+template <typename K, typename L, typename R, typename H, typename Table>
+template <typename F>
+size_t HashJoin<K, L, R, H, Table>::join(const std::vector<BuildRow> &build, const std::vector<ProbeRow> &probe,
+                                         F emit) {
+    if (_autoBits) {
+        _partitionBits = 0;
+        while (_partitionBits < constants::JOIN_MAX_PARTITION_BITS &&
+               (build.size() >> _partitionBits) > constants::JOIN_PARTITION_ROWS) _partitionBits++;
+    }
+
+    size_t threads = parallel::threadCount(build.size() + probe.size());
+    Partitioned builds = this->partition(build, threads);
+    Partitioned probes = this->partition(probe, threads);
+
+    size_t partitions = static_cast<size_t>(1) << _partitionBits;
+    std::vector<size_t> matches(partitions, 0);
+    parallel::forChunks(partitions, 1, threads,
+                        [this, &builds, &probes, &build, &probe, &emit, &matches](size_t p, size_t, size_t) {
+        matches[p] = this->joinPartition(p, builds, probes, build, probe, emit);
+    });
+
+    size_t total = 0;
+    for (size_t count : matches) total += count;
+    return total;
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "HashMapEntryCK.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Bucketized cuckoo hashing: every key lives in one of CUCKOO_BUCKET_SLOTS slots of exactly two buckets,
+// so a lookup never inspects more than two buckets regardless of the load factor. Keys of equal hashes share both
+// buckets, so no table size fits more than 2 * CUCKOO_BUCKET_SLOTS of them; put throws std::length_error right away
+// when both buckets are taken by such keys, and after CUCKOO_MAX_GROWTHS doublings that do not make room otherwise.
+// A put that throws leaves the map as it was, capacity included.
+template <typename K, typename V, typename H = std::hash<K>>
+class HashMapCK {
+private:
+    HashMapEntryCK<K, V> *_buckets;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    size_t threshold();
+    size_t normalizeCapacity(size_t capacity);
+    size_t bucketCount();
+    size_t firstBucket(size_t hash);
+    size_t secondBucket(size_t hash);
+    size_t alternativeBucket(size_t hash, size_t bucket);
+
+    int search(size_t hash, const K &key);
+    int displace(size_t first, size_t second);
+    bool saturated(size_t hash);
+    bool insert(size_t hash, const K &key, const V &value);
+    bool rebuild(HashMapEntryCK<K, V> *source, size_t sourceCapacity, size_t capacity);
+
+public:
+    HashMapCK();
+    explicit HashMapCK(size_t capacity);
+    HashMapCK(size_t capacity, float loadFactor);
+    ~HashMapCK();
+
+    HashMapCK(const HashMapCK &) = delete;
+    HashMapCK &operator=(const HashMapCK &) = delete;
+    HashMapCK(HashMapCK &&other);
+    HashMapCK &operator=(HashMapCK &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void clear();
+    void swap(HashMapCK &other) noexcept;
+    HashMapCK clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H>::HashMapCK() : _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0) {
+    _capacity = normalizeCapacity(constants::DEFAULT_CAPACITY);
+    _buckets = new HashMapEntryCK<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H>::HashMapCK(size_t capacity) : _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0) {
+    _capacity = normalizeCapacity(capacity);
+    _buckets = new HashMapEntryCK<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H>::HashMapCK(size_t capacity, float loadFactor) : _loadFactor(loadFactor), _size(0) {
+    _capacity = normalizeCapacity(capacity);
+    _buckets = new HashMapEntryCK<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H>::~HashMapCK() {
+    delete []_buckets;
+}
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H>::HashMapCK(HashMapCK<K, V, H> &&other) : HashMapCK() { this->swap(other); }
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H> &HashMapCK<K, V, H>::operator=(HashMapCK<K, V, H> &&other) {
+    HashMapCK(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H>
+void HashMapCK<K, V, H>::swap(HashMapCK<K, V, H> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+template <typename K, typename V, typename H>
+HashMapCK<K, V, H> HashMapCK<K, V, H>::clone() {
+    HashMapCK copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    allocation::copyBuckets(copy._buckets, _buckets, _capacity);
+
+    copy._size = _size;
+    return copy;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::getSize() { return _size; }
+
+template <typename K, typename V, typename H>
+float HashMapCK<K, V, H>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::normalizeCapacity(size_t capacity) {
+    size_t buckets = (capacity + constants::CUCKOO_BUCKET_SLOTS - 1) / constants::CUCKOO_BUCKET_SLOTS;
+    if (buckets < 2) buckets = 2;
+    return buckets * constants::CUCKOO_BUCKET_SLOTS;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::bucketCount() { return _capacity / constants::CUCKOO_BUCKET_SLOTS; }
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::firstBucket(size_t hash) { return hash % this->bucketCount(); }
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::secondBucket(size_t hash) {
+    // Second hash function derived from the first one with the 64-bit MurmurHash3 finalizer
+    uint64_t mixed = hash;
+    mixed ^= mixed >> 33;
+    mixed *= 0xff51afd7ed558ccdULL;
+    mixed ^= mixed >> 33;
+    mixed *= 0xc4ceb9fe1a85ec53ULL;
+    mixed ^= mixed >> 33;
+
+    size_t bucket = mixed % this->bucketCount();
+    if (bucket == this->firstBucket(hash)) bucket = (bucket + 1) % this->bucketCount();
+    return bucket;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::alternativeBucket(size_t hash, size_t bucket) {
+    size_t first = this->firstBucket(hash);
+    if (bucket == first) return this->secondBucket(hash);
+    return first;
+}
+
+template <typename K, typename V, typename H>
+int HashMapCK<K, V, H>::search(size_t hash, const K &key) {
+    size_t candidates[2] = {this->firstBucket(hash), this->secondBucket(hash)};
+
+    for (size_t bucket : candidates) {
+        size_t base = bucket * constants::CUCKOO_BUCKET_SLOTS;
+        for (size_t i = 0; i < constants::CUCKOO_BUCKET_SLOTS; i++) {
+            HashMapEntryCK<K, V> &entry = _buckets[base + i];
+            if (entry.isOccupied() && entry.getHash() == hash && entry.getKey() == key) {
+                return static_cast<int>(base + i);
+            }
+        }
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename H>
+int HashMapCK<K, V, H>::displace(size_t first, size_t second) {
+    // Breadth-first search for the shortest chain of moves that frees a slot in one of the given buckets
+    struct Step {
+        size_t bucket;
+        int parent;
+        size_t slot;
+    };
+
+    std::vector<Step> queue;
+    queue.reserve(constants::CUCKOO_MAX_SEARCH);
+    queue.push_back({first, -1, 0});
+    queue.push_back({second, -1, 0});
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        size_t base = queue[head].bucket * constants::CUCKOO_BUCKET_SLOTS;
+
+        for (size_t i = 0; i < constants::CUCKOO_BUCKET_SLOTS; i++) {
+            if (_buckets[base + i].isOccupied()) continue;
+
+            // Walking the path back, every entry moves one step into its alternative bucket
+            size_t freeSlot = base + i;
+            int current = static_cast<int>(head);
+            while (queue[current].parent != -1) {
+                const Step &step = queue[current];
+                size_t parentBucket = queue[step.parent].bucket;
+                size_t from = parentBucket * constants::CUCKOO_BUCKET_SLOTS + step.slot;
+
+                if (!_buckets[from].isOccupied()) return -1;
+                if (this->alternativeBucket(_buckets[from].getHash(), parentBucket) != step.bucket) return -1;
+
+                _buckets[freeSlot] = _buckets[from];
+                _buckets[from].setOccupied(false);
+                freeSlot = from;
+                current = step.parent;
+            }
+            return static_cast<int>(freeSlot);
+        }
+
+        for (size_t i = 0; i < constants::CUCKOO_BUCKET_SLOTS; i++) {
+            if (queue.size() >= constants::CUCKOO_MAX_SEARCH) break;
+
+            size_t next = this->alternativeBucket(_buckets[base + i].getHash(), queue[head].bucket);
+            if (next != queue[head].bucket) queue.push_back({next, static_cast<int>(head), i});
+        }
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapCK<K, V, H>::saturated(size_t hash) {
+    // Both buckets full of entries of the same hash stay full at every capacity, growing cannot help
+    size_t candidates[2] = {this->firstBucket(hash), this->secondBucket(hash)};
+
+    for (size_t bucket : candidates) {
+        size_t base = bucket * constants::CUCKOO_BUCKET_SLOTS;
+        for (size_t i = 0; i < constants::CUCKOO_BUCKET_SLOTS; i++) {
+            if (!_buckets[base + i].isOccupied() || _buckets[base + i].getHash() != hash) return false;
+        }
+    }
+    return true;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapCK<K, V, H>::insert(size_t hash, const K &key, const V &value) {
+    int slot = this->displace(this->firstBucket(hash), this->secondBucket(hash));
+    if (slot == -1) return false;
+
+    _buckets[slot] = HashMapEntryCK<K, V>(hash, key, value);
+    return true;
+}
+
+template <typename K, typename V, typename H>
+V HashMapCK<K, V, H>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    int idx = this->search(hash, key);
+
+    if (idx != -1) {
+        V rtnValue = _buckets[idx].getValue();
+        _buckets[idx].setValue(value);
+        return rtnValue;
+    }
+
+    // The table grows before the key goes in, and the old array is kept until the key has found a slot, so all
+    // growths of one put are rebuilt from it and a failure can go back to it
+    HashMapEntryCK<K, V> *prevBuckets = _buckets;
+    size_t prevCapacity = _capacity;
+    size_t capacity = _capacity;
+    bool roomy = this->threshold() >= _size + 1;
+
+    for (size_t growths = 0; !roomy || !this->insert(hash, key, value); growths++) {
+        if (growths == constants::CUCKOO_MAX_GROWTHS || this->saturated(hash)) {
+            if (_buckets != prevBuckets) delete []_buckets;
+            _buckets = prevBuckets;
+            _capacity = prevCapacity;
+            throw std::length_error("CapacityError: Too many keys share the buckets of given key");
+        }
+        capacity *= 2;
+        roomy = this->rebuild(prevBuckets, prevCapacity, capacity);
+    }
+
+    if (_buckets != prevBuckets) delete []prevBuckets;
+    _size++;
+    return V();
+}
+
+template <typename K, typename V, typename H>
+V HashMapCK<K, V, H>::get(const K &key) {
+    int idx = this->search(_hasher(key), key);
+
+    if (idx != -1) return _buckets[idx].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H>
+V HashMapCK<K, V, H>::remove(const K &key) {
+    int idx = this->search(_hasher(key), key);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    V rtnValue = _buckets[idx].getValue();
+    _buckets[idx] = HashMapEntryCK<K, V>();
+    _size--;
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapCK<K, V, H>::containsKey(const K &key) {
+    if (this->search(_hasher(key), key) == -1) return false;
+    return true;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapCK<K, V, H>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H>
+void HashMapCK<K, V, H>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        _buckets[i] = HashMapEntryCK<K, V>();
+    }
+    _size = 0;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapCK<K, V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+// Places the entries of source into a new array of given capacity, which replaces the current one unless that is
+// source itself. If they do not all fit the current array stays and false is returned
+template <typename K, typename V, typename H>
+bool HashMapCK<K, V, H>::rebuild(HashMapEntryCK<K, V> *source, size_t sourceCapacity, size_t capacity) {
+    HashMapEntryCK<K, V> *current = _buckets;
+    size_t currentCapacity = _capacity;
+    _capacity = capacity;
+    _buckets = new HashMapEntryCK<K, V>[_capacity]();
+
+    for (size_t i = 0; i < sourceCapacity; i++) {
+        if (source[i].isOccupied() && !this->insert(source[i].getHash(), source[i].getKey(), source[i].getValue())) {
+            delete []_buckets;
+            _buckets = current;
+            _capacity = currentCapacity;
+            return false;
+        }
+    }
+
+    if (current != source) delete []current;
+    return true;
+}
@@ -1,24 +1,42 @@
 #pragma once
 
 #include "HashMapEntryDH.h"
+#include "Allocation.h"
+#include "ObserverPolicies.h"
+#include "FilterPolicies.h"
 #include "Constants.h"
+#include "Parallel.h"
 
+#include <atomic>
 #include <iostream>
 #include <cmath>
+#include <iterator>
+#include <vector>
 
-template <typename K, typename V, typename H = std::hash<K>>
+template <typename K, typename V, typename H = std::hash<K>, typename A = allocation::HeapAllocation,
+          typename O = NoObserver, typename B = NoFilter>
 class HashMapDH
 {
 private:
     HashMapEntryDH<K, V>* _buckets;
-    H _hasher;
+    [[no_unique_address]] H _hasher;
+    [[no_unique_address]] O _observer;
+    [[no_unique_address]] A _allocator;
+    [[no_unique_address]] B _filter;
     size_t _capacity;
     float _loadFactor;
     size_t _size;
     size_t _how_much_free;
 
     size_t threshold();
-    void rehash();
+    void observeProbe(size_t steps);
+    template <typename F> void forEachIn(size_t begin, size_t end, F fn);
+    void filterRemoved(size_t count);
+    void rebuildFilter();
+    void rehash(size_t capacity);
+    void place(size_t hash, HashMapEntryDH<K, V> &entry);
+    V putHashed(size_t hash, const K& key, const V& value);
+    template <typename F> V& findOrInsert(const K& key, F factory, bool& inserted);
     int getNextPrime(int capacity);
     bool isPrime(int n);
 
@@ -26,59 +44,129 @@ public:
     HashMapDH();
     explicit HashMapDH(size_t capacity);
     HashMapDH(size_t capacity, float loadFactor);
+    HashMapDH(size_t capacity, float loadFactor, A allocator);
+    template <typename It> HashMapDH(It first, It last);
+    template <typename It> HashMapDH(It first, It last, float loadFactor);
     ~HashMapDH();
 
+    HashMapDH(const HashMapDH&) = delete;
+    HashMapDH& operator=(const HashMapDH&) = delete;
+    HashMapDH(HashMapDH&& other);
+    HashMapDH& operator=(HashMapDH&& other);
+
     size_t getCapacity();
     size_t getSize();
     float getLoadFactor();
+    O& getObserver();
 
     V put(const K& key, const V& value);
     V get(const K& key);
+    V* find(const K& key);
     V remove(const K& key);
-
+    bool tryRemove(const K& key, V& value);
+    template <typename P> size_t eraseIf(P pred);
+    template <typename F> void forEach(F fn);
+    template <typename F> void parallelForEach(F fn);
+    template <typename T, typename F, typename C> T parallelReduce(T init, F fn, C combine);
+
+    template <typename F> V& upsert(const K& key, F fn);
+    template <typename F> V& computeIfAbsent(const K& key, F factory);
+    template <typename F> V& merge(const K& key, const V& value, F combine);
+    V& operator[](const K& key);
+
+    template <typename It> void buildFrom(It first, It last);
+    void reserve(size_t size);
     void clear();
+    void swap(HashMapDH& other) noexcept;
+    HashMapDH clone();
 
     bool containsKey(const K& key);
     bool isEmpty();
 };
 
-template <typename K, typename V, typename H>
-HashMapDH<K, V, H>::HashMapDH() : _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0) {
-    _capacity = getNextPrime(constants::DEFAULT_CAPACITY);
-    _buckets = new HashMapEntryDH<K, V>[_capacity]();
-    _how_much_free = _capacity;
-}
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::HashMapDH() : HashMapDH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(size_t capacity) : HashMapDH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(size_t capacity, float loadFactor) : HashMapDH(capacity, loadFactor, A()) {}
 
-template <typename K, typename V, typename H>
-HashMapDH<K, V, H>::HashMapDH(size_t capacity) : _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0) {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(size_t capacity, float loadFactor, A allocator)
+        : _allocator(allocator), _loadFactor(loadFactor), _size(0) {
     _capacity = getNextPrime(capacity);
-    _buckets = new HashMapEntryDH<K, V>[_capacity];
+    _buckets = _allocator.template allocate<HashMapEntryDH<K, V>>(_capacity);
     _how_much_free = _capacity;
+    _filter.reset(this->threshold() + 1);
 }
 
-template <typename K, typename V, typename H>
-HashMapDH<K, V, H>::HashMapDH(size_t capacity, float loadFactor) : _loadFactor(loadFactor), _size(0) {
-    _capacity = getNextPrime(capacity);
-    _buckets = new HashMapEntryDH<K, V>[_capacity];
-    _how_much_free = _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(It first, It last) : HashMapDH() { this->buildFrom(first, last); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(It first, It last, float loadFactor) : HashMapDH(constants::DEFAULT_CAPACITY, loadFactor) {
+    this->buildFrom(first, last);
 }
 
-template <typename K, typename V, typename H>
-HashMapDH<K, V, H>::~HashMapDH() {
-    delete[]_buckets;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::~HashMapDH() {
+    _allocator.deallocate(_buckets, _capacity);
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapDH<K, V, H>::getCapacity() { return _capacity; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>::HashMapDH(HashMapDH<K, V, H, A, O, B>&& other) : HashMapDH() { this->swap(other); }
 
-template <typename K, typename V, typename H>
-size_t HashMapDH<K, V, H>::getSize() { return _size; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B>& HashMapDH<K, V, H, A, O, B>::operator=(HashMapDH<K, V, H, A, O, B>&& other) {
+    HashMapDH(std::move(other)).swap(*this);
+    return *this;
+}
 
-template <typename K, typename V, typename H>
-float HashMapDH<K, V, H>::getLoadFactor() { return _loadFactor; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::swap(HashMapDH<K, V, H, A, O, B>& other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_observer, other._observer);
+    std::swap(_allocator, other._allocator);
+    std::swap(_filter, other._filter);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+    std::swap(_how_much_free, other._how_much_free);
+}
 
-template <typename K, typename V, typename H>
-bool HashMapDH<K, V, H>::isPrime(int n) {
+// Capacities are always prime, so the copy gets the same one and the bucket array is copied as a whole, tombstones
+// included
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapDH<K, V, H, A, O, B> HashMapDH<K, V, H, A, O, B>::clone() {
+    HashMapDH copy(_capacity, _loadFactor, _allocator);
+    copy._hasher = _hasher;
+    copy._filter = _filter;
+    allocation::copyBuckets(copy._buckets, _buckets, _capacity);
+
+    copy._size = _size;
+    copy._how_much_free = _how_much_free;
+    return copy;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapDH<K, V, H, A, O, B>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapDH<K, V, H, A, O, B>::getSize() { return _size; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+float HashMapDH<K, V, H, A, O, B>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+O& HashMapDH<K, V, H, A, O, B>::getObserver() { return _observer; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapDH<K, V, H, A, O, B>::isPrime(int n) {
     if (n <= 1) return false;
     if (n <= 3) return true;
     if (n % 2 == 0 || n % 3 == 0) return false;
@@ -88,8 +176,8 @@ bool HashMapDH<K, V, H>::isPrime(int n) {
     return true;
 }
 
-template <typename K, typename V, typename H>
-int HashMapDH<K, V, H>::getNextPrime(int capacity) {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+int HashMapDH<K, V, H, A, O, B>::getNextPrime(int capacity) {
     if (capacity <= 1) return 2;
     int prime = capacity;
     bool found = false;
@@ -102,28 +190,37 @@ int HashMapDH<K, V, H>::getNextPrime(int capacity) {
     return prime - 1;
 }
 
-template <typename K, typename V, typename H>
-V HashMapDH<K, V, H>::put(const K& key, const V& value) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapDH<K, V, H, A, O, B>::put(const K& key, const V& value) { return this->putHashed(_hasher(key), key, value); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapDH<K, V, H, A, O, B>::putHashed(size_t hash, const K& key, const V& value) {
+    size_t hashValue = hash % _capacity;
+    size_t step = 1 + hash % (_capacity - 1);
     size_t first_a = -1;
+    size_t steps = 0;
   
     while (_buckets[hashValue].getStatus() != 'f' && _buckets[hashValue].getKey() != key) {
         if (_buckets[hashValue].getStatus() == 'a' && first_a == -1) { first_a = hashValue; }
-        hashValue = (hashValue + 1 + (_hasher(key) % (_capacity - 1))) % _capacity;
+        hashValue = (hashValue + step) % _capacity;
+        steps++;
     }
+    this->observeProbe(steps);
 
     if (_buckets[hashValue].getKey() != key) {
+        _filter.add(hash);
         if (first_a != -1) {
+            _observer.onTombstoneReuse(first_a);
             _buckets[first_a] = HashMapEntryDH<K, V>(key, value);
             _size++;
-            return V(0);
+            return V();
         }
         _buckets[hashValue] = HashMapEntryDH<K, V>(key, value);
         _size++;
         _how_much_free--;
-        if (_capacity - this->threshold() >= _how_much_free) { this->rehash(); }
+        if (_capacity - this->threshold() >= _how_much_free) { this->rehash(getNextPrime(_capacity * 2)); }
 
-        return V(0);
+        return V();
     }
 
     V rtnValue = _buckets[hashValue].getValue();
@@ -131,87 +228,369 @@ V HashMapDH<K, V, H>::put(const K& key, const V& value) {
     return rtnValue;
 }
 
-template <typename K, typename V, typename H>
-V HashMapDH<K, V, H>::get(const K& key) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapDH<K, V, H, A, O, B>::get(const K& key) {
+    V* value = this->find(key);
+    if (value == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return *value;
+}
+
+// Lookup for callers expecting misses, which need neither containsKey before get nor a thrown exception. The pointer
+// stays valid until the map is modified again.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V* HashMapDH<K, V, H, A, O, B>::find(const K& key) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return nullptr;
+
+    size_t hashValue = hash % _capacity;
+    size_t steps = 0;
     while (_buckets[hashValue].getStatus() != 'f') {
         if (_buckets[hashValue].getKey() == key) {
-            return _buckets[hashValue].getValue();
+            this->observeProbe(steps);
+            return &_buckets[hashValue].getValueRef();
         }
-        hashValue = (hashValue + 1 + _hasher(key) % (_capacity - 1)) % _capacity;
+        hashValue = (hashValue + 1 + hash % (_capacity - 1)) % _capacity;
+        steps++;
     }
-    throw std::out_of_range("KeyError: Given key does not exist in map");
+    this->observeProbe(steps);
+    return nullptr;
 }
 
-template <typename K, typename V, typename H>
-V HashMapDH<K, V, H>::remove(const K& key) {
-    int hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapDH<K, V, H, A, O, B>::remove(const K& key) {
+    V value;
+    if (!this->tryRemove(key, value)) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return value;
+}
+
+// Removal for callers expecting misses, which copies the value of a removed key into value instead of returning it
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapDH<K, V, H, A, O, B>::tryRemove(const K& key, V& value) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return false;
+
+    int hashValue = hash % _capacity;
+    size_t steps = 0;
 
     while (_buckets[hashValue].getStatus() != 'f') {
         if (_buckets[hashValue].getKey() == key) {
+            this->observeProbe(steps);
             _buckets[hashValue].setStatus('a');
-            V rtnValue = _buckets[hashValue].getValue();
+            value = _buckets[hashValue].getValue();
             _buckets[hashValue].setValue(V());
             _buckets[hashValue].setKey(K());
             _size--;
-            return rtnValue;
+            this->filterRemoved(1);
+            return true;
         }
-        hashValue = (hashValue + 1 + _hasher(key) % (_capacity - 1)) % _capacity;
+        hashValue = (hashValue + 1 + hash % (_capacity - 1)) % _capacity;
+        steps++;
     }
-    throw std::out_of_range("KeyError: Given key does not exist in map");
+    this->observeProbe(steps);
+    return false;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapDH<K, V, H>::containsKey(const K& key) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename P>
+size_t HashMapDH<K, V, H, A, O, B>::eraseIf(P pred) {
+    size_t erased = 0;
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i].getStatus() != 'o' || !pred(_buckets[i].getKeyRef(), _buckets[i].getValueRef())) continue;
+
+        _buckets[i] = HashMapEntryDH<K, V>();
+        _buckets[i].setStatus('a');
+        erased++;
+    }
+    _size -= erased;
+
+    // Slots freed by the sweep are tombstones which every later probe still has to step over. Once they outnumber
+    // the live entries the array is rebuilt at the same capacity, which turns all of them back into free slots.
+    size_t tombstones = _capacity - _how_much_free - _size;
+    if (erased > 0 && tombstones > _size) this->rehash(_capacity);
+    else this->filterRemoved(erased);
+    return erased;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapDH<K, V, H, A, O, B>::forEachIn(size_t begin, size_t end, F fn) {
+    for (size_t i = begin; i < end; i++) {
+        if (_buckets[i].getStatus() == 'o') fn(_buckets[i].getKeyRef(), _buckets[i].getValueRef());
+    }
+}
+
+// Visits every entry in bucket order, fn may change values but not the map
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapDH<K, V, H, A, O, B>::forEach(F fn) { this->forEachIn(0, _capacity, fn); }
+
+// Entries are only read, so concurrent scans are safe as long as nothing writes to the map meanwhile
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapDH<K, V, H, A, O, B>::parallelForEach(F fn) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryDH<K, V>));
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn](size_t begin, size_t end, size_t) {
+        this->forEachIn(begin, end, fn);
+    });
+}
+
+// Every chunk folds its entries with fn starting from init, which therefore has to be the identity of combine.
+// Partial results are combined in bucket order, so combine only needs to be associative.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename T, typename F, typename C>
+T HashMapDH<K, V, H, A, O, B>::parallelReduce(T init, F fn, C combine) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryDH<K, V>));
+
+    // Each chunk writes its own cache line, which also keeps std::vector<bool> from packing the results into bits
+    struct alignas(constants::CACHE_LINE_SIZE) Partial { T value; };
+    std::vector<Partial> partials((_capacity + chunk - 1) / chunk, Partial{init});
+
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn, &partials](size_t begin, size_t end, size_t index) {
+        T partial = partials[index].value;
+        this->forEachIn(begin, end, [&fn, &partial](const K &key, const V &value) {
+            partial = fn(std::move(partial), key, value);
+        });
+        partials[index].value = std::move(partial);
+    });
+
+    T result = init;
+    for (Partial &partial : partials) result = combine(std::move(result), partial.value);
+    return result;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapDH<K, V, H, A, O, B>::containsKey(const K& key) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return false;
+
+    size_t hashValue = hash % _capacity;
+    size_t steps = 0;
 
     while (_buckets[hashValue].getStatus() != 'f') {
         if (_buckets[hashValue].getKey() == key) {
+            this->observeProbe(steps);
             return true;
         }
-        hashValue = (hashValue + 1 + _hasher(key) % (_capacity - 1)) % _capacity;
+        hashValue = (hashValue + 1 + hash % (_capacity - 1)) % _capacity;
+        steps++;
     }
+    this->observeProbe(steps);
     return false;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapDH<K, V, H>::isEmpty() { return _size == 0; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V& HashMapDH<K, V, H, A, O, B>::upsert(const K& key, F fn) {
+    bool inserted;
+    V& value = this->findOrInsert(key, []() { return V(); }, inserted);
+    fn(value);
+    return value;
+}
 
-template <typename K, typename V, typename H>
-void HashMapDH<K, V, H>::clear() {
-    delete[] _buckets;
-    _buckets = new HashMapEntryDH<K, V>[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V& HashMapDH<K, V, H, A, O, B>::computeIfAbsent(const K& key, F factory) {
+    bool inserted;
+    return this->findOrInsert(key, factory, inserted);
+}
 
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V& HashMapDH<K, V, H, A, O, B>::merge(const K& key, const V& value, F combine) {
+    bool inserted;
+    V& current = this->findOrInsert(key, [&value]() { return value; }, inserted);
+    if (!inserted) current = combine(current, value);
+    return current;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V& HashMapDH<K, V, H, A, O, B>::operator[](const K& key) {
+    bool inserted;
+    return this->findOrInsert(key, []() { return V(); }, inserted);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V& HashMapDH<K, V, H, A, O, B>::findOrInsert(const K& key, F factory, bool& inserted) {
+    size_t hash = _hasher(key);
+    size_t hashValue = hash % _capacity;
+    size_t step = 1 + hash % (_capacity - 1);
+    size_t first_a = _capacity;
+    size_t steps = 0;
+    inserted = false;
+
+    while (_buckets[hashValue].getStatus() != 'f') {
+        if (_buckets[hashValue].getStatus() == 'o' && _buckets[hashValue].getKey() == key) {
+            this->observeProbe(steps);
+            return _buckets[hashValue].getValueRef();
+        }
+        if (_buckets[hashValue].getStatus() == 'a' && first_a == _capacity) { first_a = hashValue; }
+        hashValue = (hashValue + step) % _capacity;
+        steps++;
+    }
+    this->observeProbe(steps);
+
+    V value = factory();
+    _filter.add(hash);
+    inserted = true;
+    _size++;
+    if (first_a != _capacity) {
+        _observer.onTombstoneReuse(first_a);
+        _buckets[first_a] = HashMapEntryDH<K, V>(key, value);
+        return _buckets[first_a].getValueRef();
+    }
+
+    _buckets[hashValue] = HashMapEntryDH<K, V>(key, value);
+    _how_much_free--;
+    if (_capacity - this->threshold() < _how_much_free) return _buckets[hashValue].getValueRef();
+
+    // Entries are stored by value, so after growing the array the new one has to be probed for again
+    this->rehash(getNextPrime(_capacity * 2));
+    hashValue = hash % _capacity;
+    step = 1 + hash % (_capacity - 1);
+    while (_buckets[hashValue].getStatus() != 'o' || _buckets[hashValue].getKey() != key) {
+        hashValue = (hashValue + step) % _capacity;
+    }
+    return _buckets[hashValue].getValueRef();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+void HashMapDH<K, V, H, A, O, B>::buildFrom(It first, It last) {
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    this->reserve(_size + count);
+
+    // Keys are hashed concurrently up front, the probing itself stays serial so duplicates keep the last value
+    std::vector<size_t> hashes(count);
+    parallel::forRanges(count, parallel::threadCount(count), [this, first, &hashes](size_t begin, size_t end, size_t) {
+        It itr = std::next(first, static_cast<typename std::iterator_traits<It>::difference_type>(begin));
+        for (size_t i = begin; i < end; i++, ++itr) hashes[i] = _hasher(itr->first);
+    });
+
+    for (size_t i = 0; i < count; i++, ++first) this->putHashed(hashes[i], first->first, first->second);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::reserve(size_t size) {
+    size_t capacity = _capacity;
+    while (static_cast<size_t>(capacity * _loadFactor) <= size) capacity = getNextPrime(capacity * 2);
+    if (capacity == _capacity) return;
+
+    if (this->isEmpty()) {
+        _allocator.deallocate(_buckets, _capacity);
+        _capacity = capacity;
+        _buckets = _allocator.template allocate<HashMapEntryDH<K, V>>(_capacity);
+        _how_much_free = _capacity;
+        _filter.reset(this->threshold() + 1);
+        return;
+    }
+    while (_capacity < capacity) this->rehash(getNextPrime(_capacity * 2));
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapDH<K, V, H, A, O, B>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::clear() {
+    // Slots are reset in place, a monotonic resource would never get a released array back
     for (size_t i = 0; i < _capacity; i++) {
-        _buckets[i].setStatus('f');
+        _buckets[i] = HashMapEntryDH<K, V>();
     }
     _size = 0;
+    _how_much_free = _capacity;
+    _filter.reset(this->threshold() + 1);
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapDH<K, V, H>::threshold() {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapDH<K, V, H, A, O, B>::threshold() {
     return static_cast<size_t>(_capacity * _loadFactor);
 }
 
-template <typename K, typename V, typename H>
-void HashMapDH<K, V, H>::rehash() {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::observeProbe(size_t steps) {
+    if (steps > O::longProbe) _observer.onLongProbe(steps);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::filterRemoved(size_t count) {
+    if (count > 0 && _filter.removed(count)) this->rebuildFilter();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::rebuildFilter() {
+    if constexpr (B::enabled) {
+        _filter.reset(this->threshold() + 1);
+        for (size_t i = 0; i < _capacity; i++) {
+            if (_buckets[i].getStatus() == 'o') _filter.add(_hasher(_buckets[i].getKeyRef()));
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::place(size_t hash, HashMapEntryDH<K, V> &entry) {
+    size_t hashValue = hash % _capacity;
+    size_t step = 1 + hash % (_capacity - 1);
+
+    while (_buckets[hashValue].getStatus() != 'f') hashValue = (hashValue + step) % _capacity;
+    _buckets[hashValue] = entry;
+    _size++;
+    _how_much_free--;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapDH<K, V, H, A, O, B>::rehash(size_t capacity) {
     size_t prevCapacity = _capacity;
-    _capacity = getNextPrime(_capacity * 2);
+    _capacity = capacity;
+    _observer.onRehashStart(prevCapacity, _capacity);
     HashMapEntryDH<K, V>* temp = _buckets;
-    _buckets = new HashMapEntryDH<K, V>[_capacity]();
+    _buckets = _allocator.template allocate<HashMapEntryDH<K, V>>(_capacity);
     _size = 0;
     _how_much_free = _capacity;
-    
+
     for (size_t i = 0; i < _capacity; i++) {
         _buckets[i].setStatus('f');
     }
-   
-    for (size_t i = 0; i < prevCapacity; i++) {
 
-        if (temp[i].getStatus() == 'o') {
-            put(temp[i].getKey(), temp[i].getValue());
+    // Double hashing sends every probe sequence across the whole new array, so it cannot be cut into ranges owned by
+    // one thread. Threads take ranges of the old array instead and claim slots along each probe sequence with an
+    // atomic flag per slot, writing the entry only into the slot they won. Keys are distinct, so each slot is claimed
+    // once, and every slot an entry skipped stays taken, which is all a lookup relies on.
+    size_t threads = parallel::threadCount(prevCapacity);
+    std::vector<size_t> hashes(prevCapacity);
+    std::vector<size_t> placed(threads, 0);
+    std::vector<std::atomic<bool>> claimed(threads > 1 ? _capacity : 0);
+
+    parallel::forRanges(prevCapacity, threads, [this, temp, threads, &hashes, &placed, &claimed](size_t begin,
+                                                                                               size_t end, size_t t) {
+        for (size_t i = begin; i < end; i++) {
+            if (temp[i].getStatus() != 'o') continue;
+            hashes[i] = _hasher(temp[i].getKey());
+            if (threads == 1) continue;
+
+            size_t hashValue = hashes[i] % _capacity;
+            size_t step = 1 + hashes[i] % (_capacity - 1);
+            while (claimed[hashValue].exchange(true, std::memory_order_relaxed)) {
+                hashValue = (hashValue + step) % _capacity;
+            }
+            _buckets[hashValue] = temp[i];
+            placed[t]++;
         }
+    });
+
+    // The filter is refilled from the same hashes, which also drops the keys removed since it was last built
+    _filter.reset(this->threshold() + 1);
+    for (size_t i = 0; i < prevCapacity; i++) {
+        if (temp[i].getStatus() != 'o') continue;
+        if (threads == 1) this->place(hashes[i], temp[i]);
+        _filter.add(hashes[i]);
+    }
+    for (size_t count : placed) {
+        _size += count;
+        _how_much_free -= count;
     }
-    
-    delete[]temp;
-}
\ No newline at end of file
+
+    _allocator.deallocate(temp, prevCapacity);
+    _observer.onRehashEnd(prevCapacity, _capacity);
+}
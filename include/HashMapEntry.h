@@ -8,10 +8,12 @@ protected:
 
 public:
     HashMapEntry(const K &key, const V &value);
-    ~HashMapEntry();
+    ~HashMapEntry() = default;
 
     K getKey();
+    const K &getKeyRef();
     V getValue();
+    V &getValueRef();
     void setValue(const V &value);
     void setKey(const K &key);
 };
@@ -20,14 +22,17 @@ template <typename K, typename V>
 HashMapEntry<K, V>::HashMapEntry(const K &key, const V &value) : _key(key), _value(value) {}
 
 template <typename K, typename V>
-HashMapEntry<K, V>::~HashMapEntry() = default;
+K HashMapEntry<K, V>::getKey() { return _key; }
 
 template <typename K, typename V>
-K HashMapEntry<K, V>::getKey() { return _key; }
+const K &HashMapEntry<K, V>::getKeyRef() { return _key; }
 
 template <typename K, typename V>
 V HashMapEntry<K, V>::getValue() { return _value; }
 
+template <typename K, typename V>
+V &HashMapEntry<K, V>::getValueRef() { return _value; }
+
 template <typename K, typename V>
 void HashMapEntry<K, V>::setValue(const V &value) { _value = value; }
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+// Robin hood slot whose string key lives in the arena of its map, referenced by offset and length. The first bytes of
+// the key are kept inline to reject most mismatches without touching the arena.
+template <typename V>
+class HashMapEntryArena {
+private:
+    size_t _offset;
+    uint32_t _length;
+    uint32_t _psl;
+    uint64_t _prefix;
+    V _value;
+    bool _occupied;
+
+public:
+    HashMapEntryArena();
+    HashMapEntryArena(uint32_t length, uint64_t prefix, const V &value);
+
+    size_t getOffset() const;
+    void setOffset(size_t offset);
+    uint32_t getLength() const;
+    uint64_t getPrefix() const;
+
+    V &getValueRef();
+    V getValue() const;
+    void setValue(const V &value);
+
+    size_t getPSL() const;
+    void setPSL(size_t psl);
+
+    bool isOccupied() const;
+};
+
+template <typename V>
+HashMapEntryArena<V>::HashMapEntryArena() : _offset(0), _length(0), _psl(0), _prefix(0), _value(), _occupied(false) {}
+
+template <typename V>
+HashMapEntryArena<V>::HashMapEntryArena(uint32_t length, uint64_t prefix, const V &value)
+        : _offset(0), _length(length), _psl(0), _prefix(prefix), _value(value), _occupied(true) {}
+
+template <typename V>
+size_t HashMapEntryArena<V>::getOffset() const { return _offset; }
+
+template <typename V>
+void HashMapEntryArena<V>::setOffset(size_t offset) { _offset = offset; }
+
+template <typename V>
+uint32_t HashMapEntryArena<V>::getLength() const { return _length; }
+
+template <typename V>
+uint64_t HashMapEntryArena<V>::getPrefix() const { return _prefix; }
+
+template <typename V>
+V &HashMapEntryArena<V>::getValueRef() { return _value; }
+
+template <typename V>
+V HashMapEntryArena<V>::getValue() const { return _value; }
+
+template <typename V>
+void HashMapEntryArena<V>::setValue(const V &value) { _value = value; }
+
+template <typename V>
+size_t HashMapEntryArena<V>::getPSL() const { return _psl; }
+
+template <typename V>
+void HashMapEntryArena<V>::setPSL(size_t psl) { _psl = static_cast<uint32_t>(psl); }
+
+template <typename V>
+bool HashMapEntryArena<V>::isOccupied() const { return _occupied; }
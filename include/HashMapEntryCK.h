@@ -0,0 +1,37 @@
+#pragma once
+
+#include "HashMapEntry.h"
+
+#include <iostream>
+
+template <typename K, typename V>
+class HashMapEntryCK : public HashMapEntry<K, V> {
+private:
+    size_t _hash;
+    bool _occupied;
+
+public:
+    HashMapEntryCK();
+    HashMapEntryCK(const size_t &hash, const K &key, const V &value);
+    ~HashMapEntryCK() = default;
+
+    size_t getHash();
+    bool isOccupied();
+    void setOccupied(bool occupied);
+};
+
+template <typename K, typename V>
+HashMapEntryCK<K, V>::HashMapEntryCK() : HashMapEntry<K, V>(K(), V()), _hash(0), _occupied(false) {}
+
+template <typename K, typename V>
+HashMapEntryCK<K, V>::HashMapEntryCK(const size_t &hash, const K &key, const V &value)
+        : HashMapEntry<K, V>(key, value), _hash(hash), _occupied(true) {}
+
+template <typename K, typename V>
+size_t HashMapEntryCK<K, V>::getHash() { return _hash; }
+
+template <typename K, typename V>
+bool HashMapEntryCK<K, V>::isOccupied() { return _occupied; }
+
+template <typename K, typename V>
+void HashMapEntryCK<K, V>::setOccupied(bool occupied) { _occupied = occupied; }
@@ -10,7 +10,7 @@ private:
 public:
 	HashMapEntryDH();
 	HashMapEntryDH(const K& key, const V& value);
-	~HashMapEntryDH();
+	~HashMapEntryDH() = default;
 
 	char getStatus();
 	void setStatus(char status);
@@ -21,9 +21,6 @@ HashMapEntryDH<K, V>::HashMapEntryDH() : HashMapEntry<K, V>(K(), V()), _status('
 template <typename K, typename V>
 HashMapEntryDH<K, V>::HashMapEntryDH(const K& key, const V& value) : HashMapEntry<K, V>(key, value), _status('o') {}
 
-template <typename K, typename V>
-HashMapEntryDH<K, V>::~HashMapEntryDH() = default;
-
 
 template <typename K, typename V>
 char HashMapEntryDH<K, V>::getStatus() { return _status; }
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "HashMapEntry.h"
+
+#include <cstdint>
+#include <iostream>
+
+template <typename K, typename V>
+class HashMapEntryHS : public HashMapEntry<K, V> {
+private:
+    size_t _hash;
+    uint32_t _hop;  // neighborhood bitmap of the bucket, bit i set when bucket + i holds an entry homed here
+    bool _occupied;
+
+public:
+    HashMapEntryHS();
+    ~HashMapEntryHS() = default;
+
+    size_t getHash();
+    void setHash(const size_t &hash);
+
+    uint32_t getHop();
+    void setHop(uint32_t hop);
+
+    bool isOccupied();
+    void setOccupied(bool occupied);
+};
+
+template <typename K, typename V>
+HashMapEntryHS<K, V>::HashMapEntryHS() : HashMapEntry<K, V>(K(), V()), _hash(0), _hop(0), _occupied(false) {}
+
+template <typename K, typename V>
+size_t HashMapEntryHS<K, V>::getHash() { return _hash; }
+
+template <typename K, typename V>
+void HashMapEntryHS<K, V>::setHash(const size_t &hash) { _hash = hash; }
+
+template <typename K, typename V>
+uint32_t HashMapEntryHS<K, V>::getHop() { return _hop; }
+
+template <typename K, typename V>
+void HashMapEntryHS<K, V>::setHop(uint32_t hop) { _hop = hop; }
+
+template <typename K, typename V>
+bool HashMapEntryHS<K, V>::isOccupied() { return _occupied; }
+
+template <typename K, typename V>
+void HashMapEntryHS<K, V>::setOccupied(bool occupied) { _occupied = occupied; }
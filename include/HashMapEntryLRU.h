@@ -0,0 +1,60 @@
+#pragma once
+
+#include "HashMapEntryLL.h"
+
+#include <iostream>
+
+// Chained entry which is also a node of the intrusive recency list of LruHashMap
+template <typename K, typename V>
+class HashMapEntryLRU : public HashMapEntryLL<K, V> {
+private:
+    HashMapEntryLRU *_newer;
+    HashMapEntryLRU *_older;
+    size_t _weight;
+    bool _referenced;
+
+public:
+    HashMapEntryLRU(const K &key, const V &value, size_t weight);
+    ~HashMapEntryLRU();
+
+    HashMapEntryLRU *getNewer();
+    HashMapEntryLRU *getOlder();
+    void setNewer(HashMapEntryLRU *newer);
+    void setOlder(HashMapEntryLRU *older);
+
+    size_t getWeight();
+    void setWeight(size_t weight);
+    bool isReferenced();
+    void setReferenced(bool referenced);
+};
+
+template <typename K, typename V>
+HashMapEntryLRU<K, V>::HashMapEntryLRU(const K &key, const V &value, size_t weight)
+        : HashMapEntryLL<K, V>(key, value), _newer(nullptr), _older(nullptr), _weight(weight), _referenced(false) {}
+
+template <typename K, typename V>
+HashMapEntryLRU<K, V>::~HashMapEntryLRU() = default;
+
+template <typename K, typename V>
+HashMapEntryLRU<K, V> *HashMapEntryLRU<K, V>::getNewer() { return _newer; }
+
+template <typename K, typename V>
+HashMapEntryLRU<K, V> *HashMapEntryLRU<K, V>::getOlder() { return _older; }
+
+template <typename K, typename V>
+void HashMapEntryLRU<K, V>::setNewer(HashMapEntryLRU<K, V> *newer) { _newer = newer; }
+
+template <typename K, typename V>
+void HashMapEntryLRU<K, V>::setOlder(HashMapEntryLRU<K, V> *older) { _older = older; }
+
+template <typename K, typename V>
+size_t HashMapEntryLRU<K, V>::getWeight() { return _weight; }
+
+template <typename K, typename V>
+void HashMapEntryLRU<K, V>::setWeight(size_t weight) { _weight = weight; }
+
+template <typename K, typename V>
+bool HashMapEntryLRU<K, V>::isReferenced() { return _referenced; }
+
+template <typename K, typename V>
+void HashMapEntryLRU<K, V>::setReferenced(bool referenced) { _referenced = referenced; }
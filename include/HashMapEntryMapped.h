@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+
+// Robin hood slot stored by value in a memory-mapped file. It holds no pointers, so a file mapped at any address is
+// valid as it is. Zeroed memory is a free slot.
+template <typename K, typename V>
+class HashMapEntryMapped {
+private:
+    K _key;
+    V _value;
+    uint64_t _psl;
+    bool _occupied;
+
+public:
+    HashMapEntryMapped() = default;
+    HashMapEntryMapped(const K &key, const V &value);
+
+    K getKey() const;
+    V getValue() const;
+    void setValue(const V &value);
+
+    size_t getPSL() const;
+    void setPSL(size_t psl);
+
+    bool isOccupied() const;
+    void setOccupied(bool occupied);
+};
+
+template <typename K, typename V>
+HashMapEntryMapped<K, V>::HashMapEntryMapped(const K &key, const V &value)
+        : _key(key), _value(value), _psl(0), _occupied(true) {}
+
+template <typename K, typename V>
+K HashMapEntryMapped<K, V>::getKey() const { return _key; }
+
+template <typename K, typename V>
+V HashMapEntryMapped<K, V>::getValue() const { return _value; }
+
+template <typename K, typename V>
+void HashMapEntryMapped<K, V>::setValue(const V &value) { _value = value; }
+
+template <typename K, typename V>
+size_t HashMapEntryMapped<K, V>::getPSL() const { return _psl; }
+
+template <typename K, typename V>
+void HashMapEntryMapped<K, V>::setPSL(size_t psl) { _psl = psl; }
+
+template <typename K, typename V>
+bool HashMapEntryMapped<K, V>::isOccupied() const { return _occupied; }
+
+template <typename K, typename V>
+void HashMapEntryMapped<K, V>::setOccupied(bool occupied) { _occupied = occupied; }
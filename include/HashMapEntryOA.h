@@ -0,0 +1,46 @@
+#pragma once
+
+#include "HashMapEntry.h"
+
+#include <iostream>
+
+template <typename K, typename V>
+class HashMapEntryOA : public HashMapEntry<K, V> {
+private:
+    size_t _hash;
+    size_t _psl;
+    char _status;   //'f'=free,'a'=accessed,'o'occupied
+
+public:
+    HashMapEntryOA();
+    HashMapEntryOA(const size_t &hash, const K &key, const V &value);
+    ~HashMapEntryOA() = default;
+
+    size_t getHash();
+    size_t getPSL();
+    void setPSL(const size_t &psl);
+    char getStatus();
+    void setStatus(char status);
+};
+
+template <typename K, typename V>
+HashMapEntryOA<K, V>::HashMapEntryOA() : HashMapEntry<K, V>(K(), V()), _hash(0), _psl(0), _status('f') {}
+
+template <typename K, typename V>
+HashMapEntryOA<K, V>::HashMapEntryOA(const size_t &hash, const K &key, const V &value)
+        : HashMapEntry<K, V>(key, value), _hash(hash), _psl(0), _status('o') {}
+
+template <typename K, typename V>
+size_t HashMapEntryOA<K, V>::getHash() { return _hash; }
+
+template <typename K, typename V>
+size_t HashMapEntryOA<K, V>::getPSL() { return _psl; }
+
+template <typename K, typename V>
+void HashMapEntryOA<K, V>::setPSL(const size_t &psl) { _psl = psl; }
+
+template <typename K, typename V>
+char HashMapEntryOA<K, V>::getStatus() { return _status; }
+
+template <typename K, typename V>
+void HashMapEntryOA<K, V>::setStatus(char status) { _status = status; }
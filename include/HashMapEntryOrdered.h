@@ -0,0 +1,52 @@
+#pragma once
+
+#include <iostream>
+
+// Entry of the dense array of an insertion-ordered map. The full hash is kept with the key, so the index can be
+// rebuilt and probe lengths recomputed without hashing any key again. Removed entries stay in place as dead ones
+// until the array is compacted.
+template <typename K, typename V>
+class HashMapEntryOrdered {
+private:
+    size_t _hash;
+    K _key;
+    V _value;
+    bool _live;
+
+public:
+    HashMapEntryOrdered();
+    HashMapEntryOrdered(size_t hash, const K &key, const V &value);
+
+    size_t getHash() const;
+    const K &getKeyRef() const;
+    V getValue() const;
+    V &getValueRef();
+    void setValue(const V &value);
+
+    bool isLive() const;
+};
+
+template <typename K, typename V>
+HashMapEntryOrdered<K, V>::HashMapEntryOrdered() : _hash(0), _key(), _value(), _live(false) {}
+
+template <typename K, typename V>
+HashMapEntryOrdered<K, V>::HashMapEntryOrdered(size_t hash, const K &key, const V &value)
+        : _hash(hash), _key(key), _value(value), _live(true) {}
+
+template <typename K, typename V>
+size_t HashMapEntryOrdered<K, V>::getHash() const { return _hash; }
+
+template <typename K, typename V>
+const K &HashMapEntryOrdered<K, V>::getKeyRef() const { return _key; }
+
+template <typename K, typename V>
+V HashMapEntryOrdered<K, V>::getValue() const { return _value; }
+
+template <typename K, typename V>
+V &HashMapEntryOrdered<K, V>::getValueRef() { return _value; }
+
+template <typename K, typename V>
+void HashMapEntryOrdered<K, V>::setValue(const V &value) { _value = value; }
+
+template <typename K, typename V>
+bool HashMapEntryOrdered<K, V>::isLive() const { return _live; }
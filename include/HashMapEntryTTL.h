@@ -0,0 +1,37 @@
+#pragma once
+
+#include "HashMapEntryRH.h"
+
+#include <chrono>
+#include <iostream>
+
+// Robin hood entry with the moment it expires, measured on the clock of its map
+template <typename K, typename V>
+class HashMapEntryTTL : public HashMapEntryRH<K, V> {
+private:
+    std::chrono::nanoseconds _expiresAt;
+
+public:
+    HashMapEntryTTL(const K &key, const V &value, std::chrono::nanoseconds expiresAt);
+    ~HashMapEntryTTL();
+
+    std::chrono::nanoseconds getExpiresAt();
+    void setExpiresAt(std::chrono::nanoseconds expiresAt);
+    bool isExpired(std::chrono::nanoseconds now);
+};
+
+template <typename K, typename V>
+HashMapEntryTTL<K, V>::HashMapEntryTTL(const K &key, const V &value, std::chrono::nanoseconds expiresAt)
+        : HashMapEntryRH<K, V>(key, value), _expiresAt(expiresAt) {}
+
+template <typename K, typename V>
+HashMapEntryTTL<K, V>::~HashMapEntryTTL() = default;
+
+template <typename K, typename V>
+std::chrono::nanoseconds HashMapEntryTTL<K, V>::getExpiresAt() { return _expiresAt; }
+
+template <typename K, typename V>
+void HashMapEntryTTL<K, V>::setExpiresAt(std::chrono::nanoseconds expiresAt) { _expiresAt = expiresAt; }
+
+template <typename K, typename V>
+bool HashMapEntryTTL<K, V>::isExpired(std::chrono::nanoseconds now) { return _expiresAt <= now; }
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "HashMapEntry.h"
+
+#include <iostream>
+
+template <typename K, typename V>
+class HashMapEntryTree : public HashMapEntry<K, V> {
+private:
+    size_t _hash;
+    int _height;
+    HashMapEntryTree *_left;
+    HashMapEntryTree *_right;
+
+public:
+    HashMapEntryTree(const size_t &hash, const K &key, const V &value);
+    ~HashMapEntryTree();
+
+    size_t getHash();
+    int getHeight();
+    void setHeight(int height);
+
+    HashMapEntryTree *getLeft();
+    HashMapEntryTree *getRight();
+    void setLeft(HashMapEntryTree *left);
+    void setRight(HashMapEntryTree *right);
+};
+
+template <typename K, typename V>
+HashMapEntryTree<K, V>::HashMapEntryTree(const size_t &hash, const K &key, const V &value)
+        : HashMapEntry<K, V>(key, value), _hash(hash), _height(1), _left(nullptr), _right(nullptr) {}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V>::~HashMapEntryTree() = default;
+
+template <typename K, typename V>
+size_t HashMapEntryTree<K, V>::getHash() { return _hash; }
+
+template <typename K, typename V>
+int HashMapEntryTree<K, V>::getHeight() { return _height; }
+
+template <typename K, typename V>
+void HashMapEntryTree<K, V>::setHeight(int height) { _height = height; }
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapEntryTree<K, V>::getLeft() { return _left; }
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapEntryTree<K, V>::getRight() { return _right; }
+
+template <typename K, typename V>
+void HashMapEntryTree<K, V>::setLeft(HashMapEntryTree<K, V> *left) { _left = left; }
+
+template <typename K, typename V>
+void HashMapEntryTree<K, V>::setRight(HashMapEntryTree<K, V> *right) { _right = right; }
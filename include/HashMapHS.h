@@ -0,0 +1,311 @@
+#pragma once
+
+#include "HashMapEntryHS.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+// Hopscotch hashing: every key is kept within HOPSCOTCH_NEIGHBORHOOD buckets of its home bucket,
+// whose bitmap tells exactly which of those buckets have to be compared on lookup. Keys of equal hashes share the home
+// bucket at every capacity, so no table fits more than HOPSCOTCH_NEIGHBORHOOD of them; put throws std::length_error
+// right away when the neighborhood is full of such keys, and after HOPSCOTCH_MAX_GROWTHS fruitless doublings otherwise.
+// A put that throws leaves every entry in the map and the capacity as it was.
+template <typename K, typename V, typename H = std::hash<K>>
+class HashMapHS {
+private:
+    static_assert(constants::HOPSCOTCH_NEIGHBORHOOD <= 32, "Neighborhood has to fit in the 32-bit hop bitmap");
+
+    HashMapEntryHS<K, V> *_buckets;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    size_t threshold();
+    size_t distance(size_t from, size_t to);
+
+    int search(size_t hash, const K &key);
+    void move(size_t from, size_t to);
+    bool insert(size_t hash, const K &key, const V &value);
+    bool saturated(size_t hash);
+    bool rebuild(HashMapEntryHS<K, V> *source, size_t sourceCapacity, size_t capacity);
+
+public:
+    HashMapHS();
+    explicit HashMapHS(size_t capacity);
+    HashMapHS(size_t capacity, float loadFactor);
+    ~HashMapHS();
+
+    HashMapHS(const HashMapHS &) = delete;
+    HashMapHS &operator=(const HashMapHS &) = delete;
+    HashMapHS(HashMapHS &&other);
+    HashMapHS &operator=(HashMapHS &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void clear();
+    void swap(HashMapHS &other) noexcept;
+    HashMapHS clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H>::HashMapHS() : _capacity(constants::DEFAULT_CAPACITY), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
+                                  _size(0) {
+    _buckets = new HashMapEntryHS<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H>::HashMapHS(size_t capacity) : _capacity(capacity), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
+                                                 _size(0) {
+    _buckets = new HashMapEntryHS<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H>::HashMapHS(size_t capacity, float loadFactor) : _capacity(capacity), _loadFactor(loadFactor),
+                                                                   _size(0) {
+    _buckets = new HashMapEntryHS<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H>::~HashMapHS() {
+    delete []_buckets;
+}
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H>::HashMapHS(HashMapHS<K, V, H> &&other) : HashMapHS() { this->swap(other); }
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H> &HashMapHS<K, V, H>::operator=(HashMapHS<K, V, H> &&other) {
+    HashMapHS(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H>
+void HashMapHS<K, V, H>::swap(HashMapHS<K, V, H> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+template <typename K, typename V, typename H>
+HashMapHS<K, V, H> HashMapHS<K, V, H>::clone() {
+    HashMapHS copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    allocation::copyBuckets(copy._buckets, _buckets, _capacity);
+
+    copy._size = _size;
+    return copy;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapHS<K, V, H>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H>
+size_t HashMapHS<K, V, H>::getSize() { return _size; }
+
+template <typename K, typename V, typename H>
+float HashMapHS<K, V, H>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H>
+size_t HashMapHS<K, V, H>::distance(size_t from, size_t to) { return (to + _capacity - from) % _capacity; }
+
+template <typename K, typename V, typename H>
+int HashMapHS<K, V, H>::search(size_t hash, const K &key) {
+    size_t home = hash % _capacity;
+    uint32_t hop = _buckets[home].getHop();
+
+    for (size_t i = 0; hop != 0; i++, hop >>= 1) {
+        if ((hop & 1u) == 0) continue;
+
+        size_t idx = (home + i) % _capacity;
+        if (_buckets[idx].getHash() == hash && _buckets[idx].getKey() == key) return static_cast<int>(idx);
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename H>
+void HashMapHS<K, V, H>::move(size_t from, size_t to) {
+    // The hop bitmap belongs to the bucket, only the entry itself travels
+    _buckets[to].setHash(_buckets[from].getHash());
+    _buckets[to].setKey(_buckets[from].getKey());
+    _buckets[to].setValue(_buckets[from].getValue());
+    _buckets[to].setOccupied(true);
+
+    _buckets[from].setKey(K());
+    _buckets[from].setValue(V());
+    _buckets[from].setOccupied(false);
+}
+
+template <typename K, typename V, typename H>
+bool HashMapHS<K, V, H>::saturated(size_t hash) {
+    // A neighborhood full of entries of the same hash stays full at every capacity, growing cannot help
+    size_t home = hash % _capacity;
+    if (_buckets[home].getHop() != UINT32_MAX >> (32 - constants::HOPSCOTCH_NEIGHBORHOOD)) return false;
+
+    for (size_t i = 0; i < constants::HOPSCOTCH_NEIGHBORHOOD; i++) {
+        if (_buckets[(home + i) % _capacity].getHash() != hash) return false;
+    }
+    return true;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapHS<K, V, H>::insert(size_t hash, const K &key, const V &value) {
+    size_t home = hash % _capacity;
+    size_t maxProbe = std::min(constants::HOPSCOTCH_MAX_PROBE, _capacity);
+
+    size_t free = 0; size_t itr = 0;
+    while (itr < maxProbe) {
+        free = (home + itr) % _capacity;
+        if (!_buckets[free].isOccupied()) break;
+        itr++;
+    }
+    if (itr == maxProbe) return false;
+
+    // Hopping the free bucket backwards until it lands in the neighborhood of the home bucket
+    while (this->distance(home, free) >= constants::HOPSCOTCH_NEIGHBORHOOD) {
+        bool moved = false;
+
+        for (size_t back = constants::HOPSCOTCH_NEIGHBORHOOD - 1; back > 0 && !moved; back--) {
+            size_t candidate = (free + _capacity - back) % _capacity;
+            uint32_t hop = _buckets[candidate].getHop();
+
+            for (size_t i = 0; i < back; i++) {
+                if ((hop & (1u << i)) == 0) continue;
+
+                size_t from = (candidate + i) % _capacity;
+                this->move(from, free);
+                _buckets[candidate].setHop((hop & ~(1u << i)) | (1u << back));
+
+                free = from;
+                moved = true;
+                break;
+            }
+        }
+
+        if (!moved) return false;
+    }
+
+    _buckets[free].setHash(hash);
+    _buckets[free].setKey(key);
+    _buckets[free].setValue(value);
+    _buckets[free].setOccupied(true);
+    _buckets[home].setHop(_buckets[home].getHop() | (1u << this->distance(home, free)));
+    return true;
+}
+
+template <typename K, typename V, typename H>
+V HashMapHS<K, V, H>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    int idx = this->search(hash, key);
+
+    if (idx != -1) {
+        V rtnValue = _buckets[idx].getValue();
+        _buckets[idx].setValue(value);
+        return rtnValue;
+    }
+
+    // The table grows before the key goes in, and the old array is kept until the key has found a slot, so all
+    // growths of one put are rebuilt from it and a failure can go back to it
+    HashMapEntryHS<K, V> *prevBuckets = _buckets;
+    size_t prevCapacity = _capacity;
+    size_t capacity = _capacity;
+    bool roomy = this->threshold() >= _size + 1;
+
+    for (size_t growths = 0; !roomy || !this->insert(hash, key, value); growths++) {
+        if (growths == constants::HOPSCOTCH_MAX_GROWTHS || this->saturated(hash)) {
+            if (_buckets != prevBuckets) delete []_buckets;
+            _buckets = prevBuckets;
+            _capacity = prevCapacity;
+            throw std::length_error("CapacityError: Too many keys share the home bucket of given key");
+        }
+        capacity *= 2;
+        roomy = this->rebuild(prevBuckets, prevCapacity, capacity);
+    }
+
+    if (_buckets != prevBuckets) delete []prevBuckets;
+    _size++;
+    return V();
+}
+
+template <typename K, typename V, typename H>
+V HashMapHS<K, V, H>::get(const K &key) {
+    int idx = this->search(_hasher(key), key);
+
+    if (idx != -1) return _buckets[idx].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H>
+V HashMapHS<K, V, H>::remove(const K &key) {
+    size_t hash = _hasher(key);
+    int idx = this->search(hash, key);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    size_t home = hash % _capacity;
+    V rtnValue = _buckets[idx].getValue();
+
+    _buckets[idx].setKey(K());
+    _buckets[idx].setValue(V());
+    _buckets[idx].setOccupied(false);
+    _buckets[home].setHop(_buckets[home].getHop() & ~(1u << this->distance(home, idx)));
+    _size--;
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapHS<K, V, H>::containsKey(const K &key) {
+    if (this->search(_hasher(key), key) == -1) return false;
+    return true;
+}
+
+template <typename K, typename V, typename H>
+bool HashMapHS<K, V, H>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H>
+void HashMapHS<K, V, H>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        _buckets[i] = HashMapEntryHS<K, V>();
+    }
+    _size = 0;
+}
+
+template <typename K, typename V, typename H>
+size_t HashMapHS<K, V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+// Places the entries of source into a new array of given capacity, which replaces the current one unless that is
+// source itself. If they do not all fit the current array stays and false is returned
+template <typename K, typename V, typename H>
+bool HashMapHS<K, V, H>::rebuild(HashMapEntryHS<K, V> *source, size_t sourceCapacity, size_t capacity) {
+    HashMapEntryHS<K, V> *current = _buckets;
+    size_t currentCapacity = _capacity;
+    _capacity = capacity;
+    _buckets = new HashMapEntryHS<K, V>[_capacity]();
+
+    for (size_t i = 0; i < sourceCapacity; i++) {
+        if (source[i].isOccupied() && !this->insert(source[i].getHash(), source[i].getKey(), source[i].getValue())) {
+            delete []_buckets;
+            _buckets = current;
+            _capacity = currentCapacity;
+            return false;
+        }
+    }
+
+    if (current != source) delete []current;
+    return true;
+}
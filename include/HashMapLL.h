@@ -1,91 +1,231 @@
 #pragma once
 
 #include "HashMapEntryLL.h"
+#include "HashMapTreeLL.h"
+#include "Allocation.h"
+#include "ObserverPolicies.h"
+#include "FilterPolicies.h"
 #include "Constants.h"
+#include "Parallel.h"
 
 #include <iostream>
+#include <iterator>
 
-template <typename K, typename V, typename H = std::hash<K>>
+template <typename K, typename V, typename H = std::hash<K>, typename A = allocation::HeapAllocation,
+          typename O = NoObserver, typename B = NoFilter>
 class HashMapLL {
 private:
     HashMapEntryLL<K, V> **_buckets;
-    H _hasher;
+    HashMapTreeLL<K, V> **_trees;
+    [[no_unique_address]] H _hasher;
+    [[no_unique_address]] O _observer;
+    [[no_unique_address]] A _allocator;
+    [[no_unique_address]] B _filter;
     size_t _capacity;
     float _loadFactor;
     size_t _size;
 
     size_t threshold();
+    bool skipsTeardown();
+    void observeProbe(size_t steps);
+    template <typename F> void forEachIn(size_t begin, size_t end, F fn);
+    void filterRemoved(size_t count);
+    void rebuildFilter();
     void rehash();
+    void split(HashMapEntryLL<K, V> **prevBuckets, HashMapTreeLL<K, V> **prevTrees, size_t index, size_t prevCapacity);
+
+    template <typename F> V &findOrInsert(const K &key, F factory, bool &inserted);
+    V &valueOf(size_t hash, const K &key);
+
+    bool isTreeified(size_t index);
+    void treeify(size_t index);
+    void untreeify(size_t index);
 
 public:
     HashMapLL();
     explicit HashMapLL(size_t capacity);
     HashMapLL(size_t capacity, float loadFactor);
+    HashMapLL(size_t capacity, float loadFactor, A allocator);
+    template <typename It> HashMapLL(It first, It last);
+    template <typename It> HashMapLL(It first, It last, float loadFactor);
     ~HashMapLL();
 
+    HashMapLL(const HashMapLL &) = delete;
+    HashMapLL &operator=(const HashMapLL &) = delete;
+    HashMapLL(HashMapLL &&other);
+    HashMapLL &operator=(HashMapLL &&other);
+
     size_t getCapacity();
     size_t getSize();
     float getLoadFactor();
+    O &getObserver();
 
     V put(const K &key, const V &value);
     V get(const K &key);
+    V *find(const K &key);
     V remove(const K &key);
-
+    bool tryRemove(const K &key, V &value);
+    template <typename P> size_t eraseIf(P pred);
+    template <typename F> void forEach(F fn);
+    template <typename F> void parallelForEach(F fn);
+    template <typename T, typename F, typename C> T parallelReduce(T init, F fn, C combine);
+
+    template <typename F> V &upsert(const K &key, F fn);
+    template <typename F> V &computeIfAbsent(const K &key, F factory);
+    template <typename F> V &merge(const K &key, const V &value, F combine);
+    V &operator[](const K &key);
+
+    template <typename It> void buildFrom(It first, It last);
+    void reserve(size_t size);
     void clear();
+    void swap(HashMapLL &other) noexcept;
+    HashMapLL clone();
 
     bool containsKey(const K &key);
     bool isEmpty();
 };
 
-template <typename K, typename V, typename H>
-HashMapLL<K, V, H>::HashMapLL() : _capacity(constants::DEFAULT_CAPACITY), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
-                                _size(0)  {
-    _buckets = new HashMapEntryLL<K, V> *[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::HashMapLL() : HashMapLL(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(size_t capacity) : HashMapLL(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(size_t capacity, float loadFactor) : HashMapLL(capacity, loadFactor, A()) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(size_t capacity, float loadFactor, A allocator)
+        : _trees(nullptr), _allocator(allocator), _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _buckets = _allocator.template allocate<HashMapEntryLL<K, V> *>(_capacity);
+    _filter.reset(this->threshold() + 1);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(It first, It last) : HashMapLL() { this->buildFrom(first, last); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(It first, It last, float loadFactor) : HashMapLL(constants::DEFAULT_CAPACITY, loadFactor) {
+    this->buildFrom(first, last);
 }
 
-template <typename K, typename V, typename H>
-HashMapLL<K, V, H>::HashMapLL(size_t capacity) : _capacity(capacity), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
-                                                _size(0) {
-    _buckets = new HashMapEntryLL<K, V> *[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::~HashMapLL() {
+    // Trees are always heap allocated, without them nothing is left to free one entry at a time
+    bool skipEntries = this->skipsTeardown() && _trees == nullptr;
+    if (!this->isEmpty() && !skipEntries) this->clear();
+    _allocator.deallocate(_buckets, _capacity);
+    if (_trees != nullptr) _allocator.deallocate(_trees, _capacity);
 }
 
-template <typename K, typename V, typename H>
-HashMapLL<K, V, H>::HashMapLL(size_t capacity, float loadFactor) : _capacity(capacity), _loadFactor(loadFactor), _size(0) {
-    _buckets = new HashMapEntryLL<K, V> *[_capacity]();
+// The moved-from map is left empty with the default capacity
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B>::HashMapLL(HashMapLL<K, V, H, A, O, B> &&other) : HashMapLL() { this->swap(other); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B> &HashMapLL<K, V, H, A, O, B>::operator=(HashMapLL<K, V, H, A, O, B> &&other) {
+    HashMapLL(std::move(other)).swap(*this);
+    return *this;
 }
 
-template <typename K, typename V, typename H>
-HashMapLL<K, V, H>::~HashMapLL() {
-    if (!this->isEmpty()) this->clear();
-    delete []_buckets;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::swap(HashMapLL<K, V, H, A, O, B> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_trees, other._trees);
+    std::swap(_hasher, other._hasher);
+    std::swap(_observer, other._observer);
+    std::swap(_allocator, other._allocator);
+    std::swap(_filter, other._filter);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapLL<K, V, H>::getCapacity() { return _capacity; }
+// Buckets are copied one to one, chains node by node in their order, so no key is hashed again
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapLL<K, V, H, A, O, B> HashMapLL<K, V, H, A, O, B>::clone() {
+    HashMapLL copy(_capacity, _loadFactor, _allocator);
+    copy._hasher = _hasher;
+    copy._filter = _filter;
+    if (_trees != nullptr) copy._trees = _allocator.template allocate<HashMapTreeLL<K, V> *>(_capacity);
+
+    for (size_t i = 0; i < _capacity; i++) {
+        if (this->isTreeified(i)) {
+            HashMapTreeLL<K, V> *tree = new HashMapTreeLL<K, V>();
+            _trees[i]->forEach([tree](HashMapEntryTree<K, V> *node) {
+                tree->insert(node->getHash(), node->getKeyRef(), node->getValueRef());
+            });
+            copy._trees[i] = tree;
+            continue;
+        }
 
-template <typename K, typename V, typename H>
-size_t HashMapLL<K, V, H>::getSize() { return _size; }
+        HashMapEntryLL<K, V> *tail = nullptr;
+        for (HashMapEntryLL<K, V> *current = _buckets[i]; current != nullptr; current = current->getNext()) {
+            auto *entry = copy._allocator.template create<HashMapEntryLL<K, V>>(current->getKeyRef(),
+                                                                                 current->getValueRef());
+            if (tail == nullptr) copy._buckets[i] = entry;
+            else tail->setNext(entry);
+            tail = entry;
+        }
+    }
+
+    copy._size = _size;
+    return copy;
+}
 
-template <typename K, typename V, typename H>
-float HashMapLL<K, V, H>::getLoadFactor() { return _loadFactor; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapLL<K, V, H, A, O, B>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapLL<K, V, H, A, O, B>::getSize() { return _size; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+float HashMapLL<K, V, H, A, O, B>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+O &HashMapLL<K, V, H, A, O, B>::getObserver() { return _observer; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapLL<K, V, H, A, O, B>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    size_t hashValue = hash % _capacity;
+
+    if (this->isTreeified(hashValue)) {
+        HashMapEntryTree<K, V> *existing = _trees[hashValue]->insert(hash, key, value);
+        if (existing == nullptr) {
+            _filter.add(hash);
+            _size++;
+            if (this->threshold() < _size) { this->rehash(); }
+            return V();
+        }
+
+        V rtnValue = existing->getValue();
+        existing->setValue(value);
+        return rtnValue;
+    }
 
-template <typename K, typename V, typename H>
-V HashMapLL<K, V, H>::put(const K &key, const V &value) {
-    size_t hashValue = _hasher(key) % _capacity;
     HashMapEntryLL<K, V> *entry = _buckets[hashValue];
     HashMapEntryLL<K, V> *prev = nullptr;
+    size_t length = 0;
 
     while (entry != nullptr && entry->getKey() != key) {
         prev = entry;
         entry = entry->getNext();
+        length++;
     }
+    this->observeProbe(length);
 
     if (entry == nullptr) {
-        if (prev == nullptr) _buckets[hashValue] = new HashMapEntryLL<K, V>(key, value);
-        else prev->setNext(new HashMapEntryLL<K, V>(key, value));
+        auto *created = _allocator.template create<HashMapEntryLL<K, V>>(key, value);
+        if (prev == nullptr) _buckets[hashValue] = created;
+        else prev->setNext(created);
 
+        _filter.add(hash);
         _size++;
         if (this->threshold() < _size) { this->rehash(); }
+        else if (length + 1 >= constants::TREEIFY_THRESHOLD) { this->treeify(hashValue); }
         return V();
     }
 
@@ -94,74 +234,357 @@ V HashMapLL<K, V, H>::put(const K &key, const V &value) {
     return rtnValue;
 }
 
-template <typename K, typename V, typename H>
-V HashMapLL<K, V, H>::get(const K &key) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapLL<K, V, H, A, O, B>::get(const K &key) {
+    V *value = this->find(key);
+    if (value == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return *value;
+}
+
+// Lookup for callers expecting misses, which need neither containsKey before get nor a thrown exception. The pointer
+// stays valid until the map is modified again.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V *HashMapLL<K, V, H, A, O, B>::find(const K &key) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return nullptr;
+    size_t hashValue = hash % _capacity;
+
+    if (this->isTreeified(hashValue)) {
+        HashMapEntryTree<K, V> *entry = _trees[hashValue]->find(hash, key);
+        return entry == nullptr ? nullptr : &entry->getValueRef();
+    }
+
     HashMapEntryLL<K, V> *entry = _buckets[hashValue];
+    size_t length = 0;
+
+    while (entry != nullptr && entry->getKey() != key) {
+        entry = entry->getNext();
+        length++;
+    }
+    this->observeProbe(length);
 
-    while (entry != nullptr && entry->getKey() != key) entry = entry->getNext();
-    if (entry == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
-    return entry->getValue();
+    return entry == nullptr ? nullptr : &entry->getValueRef();
 }
 
-template <typename K, typename V, typename H>
-V HashMapLL<K, V, H>::remove(const K &key) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapLL<K, V, H, A, O, B>::remove(const K &key) {
+    V value;
+    if (!this->tryRemove(key, value)) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return value;
+}
+
+// Removal for callers expecting misses, which copies the value of a removed key into value instead of returning it
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapLL<K, V, H, A, O, B>::tryRemove(const K &key, V &value) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return false;
+    size_t hashValue = hash % _capacity;
+
+    if (this->isTreeified(hashValue)) {
+        HashMapEntryTree<K, V> *entry = _trees[hashValue]->remove(hash, key);
+        if (entry == nullptr) return false;
+
+        value = entry->getValue();
+        _size--;
+        delete entry;
+
+        if (_trees[hashValue]->getSize() <= constants::UNTREEIFY_THRESHOLD) this->untreeify(hashValue);
+        this->filterRemoved(1);
+        return true;
+    }
+
     HashMapEntryLL<K, V> *entry = _buckets[hashValue];
     HashMapEntryLL<K, V> *prev = nullptr;
+    size_t length = 0;
 
     while (entry != nullptr && entry->getKey() != key) {
         prev = entry;
         entry = entry->getNext();
+        length++;
     }
+    this->observeProbe(length);
 
-    if (entry == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
+    if (entry == nullptr) return false;
 
-    V rtnValue;
     if (prev == nullptr) {
-        rtnValue = entry->getValue();
+        value = entry->getValue();
         if (entry->getNext() != nullptr) _buckets[hashValue] = entry->getNext();
         else _buckets[hashValue] = nullptr;
 
         _size--;
-        delete entry;
-        return rtnValue;
+        _allocator.destroy(entry);
+        this->filterRemoved(1);
+        return true;
     }
 
     if (entry->getNext() == nullptr) {
-        rtnValue = entry->getValue();
+        value = entry->getValue();
         prev->setNext(nullptr);
 
         _size--;
-        delete entry;
-        return rtnValue;
+        _allocator.destroy(entry);
+        this->filterRemoved(1);
+        return true;
     }
 
-    rtnValue = entry->getValue();
+    value = entry->getValue();
     prev->setNext(entry->getNext());
 
     _size--;
-    delete entry;
-    return rtnValue;
+    _allocator.destroy(entry);
+    this->filterRemoved(1);
+    return true;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapLL<K, V, H>::containsKey(const K &key) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename P>
+size_t HashMapLL<K, V, H, A, O, B>::eraseIf(P pred) {
+    size_t erased = 0;
+    for (size_t i = 0; i < _capacity; i++) {
+        // Trees are rebuilt from the surviving nodes, which keeps them balanced without a rotation per removal
+        if (this->isTreeified(i)) {
+            auto *tree = new HashMapTreeLL<K, V>();
+            _trees[i]->forEach([&pred, &erased, tree](HashMapEntryTree<K, V> *node) {
+                if (pred(node->getKeyRef(), node->getValueRef())) erased++;
+                else tree->insert(node->getHash(), node->getKey(), node->getValue());
+            });
+
+            delete _trees[i];
+            _trees[i] = tree;
+            if (tree->getSize() <= constants::UNTREEIFY_THRESHOLD) this->untreeify(i);
+            continue;
+        }
+
+        HashMapEntryLL<K, V> *entry = _buckets[i];
+        HashMapEntryLL<K, V> *prev = nullptr;
+        while (entry != nullptr) {
+            HashMapEntryLL<K, V> *next = entry->getNext();
+            if (!pred(entry->getKeyRef(), entry->getValueRef())) {
+                prev = entry;
+                entry = next;
+                continue;
+            }
+
+            if (prev == nullptr) _buckets[i] = next;
+            else prev->setNext(next);
+            erased++;
+            _allocator.destroy(entry);
+            entry = next;
+        }
+    }
+
+    _size -= erased;
+    this->filterRemoved(erased);
+    return erased;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapLL<K, V, H, A, O, B>::forEachIn(size_t begin, size_t end, F fn) {
+    for (size_t i = begin; i < end; i++) {
+        if (this->isTreeified(i)) {
+            _trees[i]->forEach([&fn](HashMapEntryTree<K, V> *node) { fn(node->getKeyRef(), node->getValueRef()); });
+            continue;
+        }
+        for (HashMapEntryLL<K, V> *entry = _buckets[i]; entry != nullptr; entry = entry->getNext()) {
+            fn(entry->getKeyRef(), entry->getValueRef());
+        }
+    }
+}
+
+// Visits every entry in bucket order, fn may change values but not the map
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapLL<K, V, H, A, O, B>::forEach(F fn) { this->forEachIn(0, _capacity, fn); }
+
+// Entries are only read, so concurrent scans are safe as long as nothing writes to the map meanwhile
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapLL<K, V, H, A, O, B>::parallelForEach(F fn) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryLL<K, V> *));
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn](size_t begin, size_t end, size_t) {
+        this->forEachIn(begin, end, fn);
+    });
+}
+
+// Every chunk folds its entries with fn starting from init, which therefore has to be the identity of combine.
+// Partial results are combined in bucket order, so combine only needs to be associative.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename T, typename F, typename C>
+T HashMapLL<K, V, H, A, O, B>::parallelReduce(T init, F fn, C combine) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryLL<K, V> *));
+
+    // Each chunk writes its own cache line, which also keeps std::vector<bool> from packing the results into bits
+    struct alignas(constants::CACHE_LINE_SIZE) Partial { T value; };
+    std::vector<Partial> partials((_capacity + chunk - 1) / chunk, Partial{init});
+
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn, &partials](size_t begin, size_t end, size_t index) {
+        T partial = partials[index].value;
+        this->forEachIn(begin, end, [&fn, &partial](const K &key, const V &value) {
+            partial = fn(std::move(partial), key, value);
+        });
+        partials[index].value = std::move(partial);
+    });
+
+    T result = init;
+    for (Partial &partial : partials) result = combine(std::move(result), partial.value);
+    return result;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapLL<K, V, H, A, O, B>::containsKey(const K &key) {
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return false;
+    size_t hashValue = hash % _capacity;
+
+    if (this->isTreeified(hashValue)) return _trees[hashValue]->find(hash, key) != nullptr;
+
     HashMapEntryLL<K, V> *entry = _buckets[hashValue];
-    while (entry != nullptr && entry->getKey() != key) entry = entry->getNext();
+    size_t length = 0;
+
+    while (entry != nullptr && entry->getKey() != key) {
+        entry = entry->getNext();
+        length++;
+    }
+    this->observeProbe(length);
 
     if (entry == nullptr) return false;
     return true;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapLL<K, V, H>::isEmpty() { return _size == 0; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapLL<K, V, H, A, O, B>::upsert(const K &key, F fn) {
+    bool inserted;
+    V &value = this->findOrInsert(key, []() { return V(); }, inserted);
+    fn(value);
+    return value;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapLL<K, V, H, A, O, B>::computeIfAbsent(const K &key, F factory) {
+    bool inserted;
+    return this->findOrInsert(key, factory, inserted);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapLL<K, V, H, A, O, B>::merge(const K &key, const V &value, F combine) {
+    bool inserted;
+    V &current = this->findOrInsert(key, [&value]() { return value; }, inserted);
+    if (!inserted) current = combine(current, value);
+    return current;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V &HashMapLL<K, V, H, A, O, B>::operator[](const K &key) {
+    bool inserted;
+    return this->findOrInsert(key, []() { return V(); }, inserted);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapLL<K, V, H, A, O, B>::findOrInsert(const K &key, F factory, bool &inserted) {
+    size_t hash = _hasher(key);
+    size_t hashValue = hash % _capacity;
+    inserted = false;
+
+    if (this->isTreeified(hashValue)) {
+        HashMapEntryTree<K, V> *entry = _trees[hashValue]->findOrInsert(hash, key, factory, inserted);
+        if (!inserted) return entry->getValueRef();
+
+        _filter.add(hash);
+        _size++;
+
+        // Rehashing rebuilds the trees, so the entry is only looked up again when it happened
+        if (this->threshold() < _size) {
+            this->rehash();
+            return this->valueOf(hash, key);
+        }
+        return entry->getValueRef();
+    }
 
-template <typename K, typename V, typename H>
-void HashMapLL<K, V, H>::clear() {
+    HashMapEntryLL<K, V> *entry = _buckets[hashValue];
+    HashMapEntryLL<K, V> *prev = nullptr;
+    size_t length = 0;
+
+    while (entry != nullptr && entry->getKey() != key) {
+        prev = entry;
+        entry = entry->getNext();
+        length++;
+    }
+    this->observeProbe(length);
+    if (entry != nullptr) return entry->getValueRef();
+
+    entry = _allocator.template create<HashMapEntryLL<K, V>>(key, factory());
+    if (prev == nullptr) _buckets[hashValue] = entry;
+    else prev->setNext(entry);
+    _filter.add(hash);
+    inserted = true;
+    _size++;
+
+    // Chained entries are relinked, not copied, by rehash, only treeifying replaces them
+    if (this->threshold() < _size) { this->rehash(); }
+    else if (length + 1 >= constants::TREEIFY_THRESHOLD) {
+        this->treeify(hashValue);
+        return this->valueOf(hash, key);
+    }
+    return entry->getValueRef();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V &HashMapLL<K, V, H, A, O, B>::valueOf(size_t hash, const K &key) {
+    size_t hashValue = hash % _capacity;
+    if (this->isTreeified(hashValue)) return _trees[hashValue]->find(hash, key)->getValueRef();
+
+    HashMapEntryLL<K, V> *entry = _buckets[hashValue];
+    while (entry->getKey() != key) entry = entry->getNext();
+    return entry->getValueRef();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+void HashMapLL<K, V, H, A, O, B>::buildFrom(It first, It last) {
+    // Sizing the table up front means the puts below never trigger an intermediate rehash
+    this->reserve(_size + static_cast<size_t>(std::distance(first, last)));
+    for (; first != last; ++first) this->put(first->first, first->second);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::reserve(size_t size) {
+    size_t capacity = _capacity;
+    while (static_cast<size_t>(capacity * _loadFactor) < size) capacity *= 2;
+    if (capacity == _capacity) return;
+
+    if (this->isEmpty()) {
+        _allocator.deallocate(_buckets, _capacity);
+        if (_trees != nullptr) _allocator.deallocate(_trees, _capacity);
+        _trees = nullptr;
+        _capacity = capacity;
+        _buckets = _allocator.template allocate<HashMapEntryLL<K, V> *>(_capacity);
+        _filter.reset(this->threshold() + 1);
+        return;
+    }
+    while (_capacity < capacity) this->rehash();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapLL<K, V, H, A, O, B>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::clear() {
+    bool skipEntries = this->skipsTeardown();
     for (size_t i = 0; i < _capacity; i++) {
-        HashMapEntryLL<K, V> *current = _buckets[i];
+        if (this->isTreeified(i)) {
+            _size -= _trees[i]->getSize();
+            delete _trees[i];
+            _trees[i] = nullptr;
+        }
+
+        HashMapEntryLL<K, V> *current = skipEntries ? nullptr : _buckets[i];
         HashMapEntryLL<K, V> *helper;
 
         while (current != nullptr) {
@@ -169,32 +592,147 @@ void HashMapLL<K, V, H>::clear() {
             current = current->getNext();
 
             _size--;
-            delete helper;
+            _allocator.destroy(helper);
         }
         _buckets[i] = nullptr;
     }
+    _size = 0;
+    _filter.reset(this->threshold() + 1);
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapLL<K, V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapLL<K, V, H, A, O, B>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
 
-template <typename K, typename V, typename H>
-void HashMapLL<K, V, H>::rehash() {
-    size_t prevCapacity = _capacity; _capacity *= 2;
-    HashMapEntryLL<K, V> **temp = _buckets;
-    _buckets = new HashMapEntryLL<K, V> *[_capacity]();
-    _size = 0;
+// Chained entries are left to the memory resource when destroying them would run no destructor and free nothing
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapLL<K, V, H, A, O, B>::skipsTeardown() {
+    return std::is_trivially_destructible<K>::value && std::is_trivially_destructible<V>::value &&
+           !_allocator.needsDeallocation();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::observeProbe(size_t steps) {
+    if (steps > O::longProbe) _observer.onLongProbe(steps);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::filterRemoved(size_t count) {
+    if (count > 0 && _filter.removed(count)) this->rebuildFilter();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::rebuildFilter() {
+    if constexpr (B::enabled) {
+        _filter.reset(this->threshold() + 1);
+        for (size_t i = 0; i < _capacity; i++) {
+            if (this->isTreeified(i)) {
+                _trees[i]->forEach([this](HashMapEntryTree<K, V> *node) { _filter.add(node->getHash()); });
+                continue;
+            }
+            for (HashMapEntryLL<K, V> *entry = _buckets[i]; entry != nullptr; entry = entry->getNext()) {
+                _filter.add(_hasher(entry->getKeyRef()));
+            }
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapLL<K, V, H, A, O, B>::isTreeified(size_t index) { return _trees != nullptr && _trees[index] != nullptr; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::treeify(size_t index) {
+    // Without operator< colliding keys cannot be ordered, such buckets stay as plain chains
+    if constexpr (isLessComparable<K>::value) {
+        if (_trees == nullptr) _trees = _allocator.template allocate<HashMapTreeLL<K, V> *>(_capacity);
 
-    for (size_t i = 0; i < prevCapacity; i++) {
-        HashMapEntryLL<K, V> *current = temp[i];
+        auto *tree = new HashMapTreeLL<K, V>();
+        HashMapEntryLL<K, V> *current = _buckets[index];
         HashMapEntryLL<K, V> *helper;
 
         while (current != nullptr) {
-            this->put(current->getKey(), current->getValue());
+            tree->insert(_hasher(current->getKey()), current->getKey(), current->getValue());
             helper = current;
             current = current->getNext();
-            delete helper;
+            _allocator.destroy(helper);
         }
+
+        _buckets[index] = nullptr;
+        _trees[index] = tree;
+    }
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::untreeify(size_t index) {
+    HashMapEntryLL<K, V> *head = nullptr;
+    HashMapEntryLL<K, V> *tail = nullptr;
+
+    _trees[index]->forEach([this, &head, &tail](HashMapEntryTree<K, V> *node) {
+        auto *entry = _allocator.template create<HashMapEntryLL<K, V>>(node->getKey(), node->getValue());
+        if (tail == nullptr) head = entry;
+        else tail->setNext(entry);
+        tail = entry;
+    });
+
+    delete _trees[index];
+    _trees[index] = nullptr;
+    _buckets[index] = head;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::split(HashMapEntryLL<K, V> **prevBuckets, HashMapTreeLL<K, V> **prevTrees,
+                                        size_t index, size_t prevCapacity) {
+    // After doubling, entries of old bucket i can only land in new buckets i and i + prevCapacity
+    HashMapEntryLL<K, V> *heads[2] = {nullptr, nullptr};
+    HashMapEntryLL<K, V> *tails[2] = {nullptr, nullptr};
+
+    HashMapEntryLL<K, V> *current = prevBuckets[index];
+    while (current != nullptr) {
+        HashMapEntryLL<K, V> *next = current->getNext();
+        int half = _hasher(current->getKey()) % _capacity == index ? 0 : 1;
+
+        current->setNext(nullptr);
+        if (tails[half] == nullptr) heads[half] = current;
+        else tails[half]->setNext(current);
+        tails[half] = current;
+        current = next;
     }
-    delete []temp;
+
+    _buckets[index] = heads[0];
+    _buckets[index + prevCapacity] = heads[1];
+
+    if (prevTrees == nullptr || prevTrees[index] == nullptr) return;
+
+    HashMapTreeLL<K, V> *trees[2] = {new HashMapTreeLL<K, V>(), new HashMapTreeLL<K, V>()};
+    prevTrees[index]->forEach([this, &trees, index](HashMapEntryTree<K, V> *node) {
+        int half = node->getHash() % _capacity == index ? 0 : 1;
+        trees[half]->insert(node->getHash(), node->getKey(), node->getValue());
+    });
+    delete prevTrees[index];
+
+    _trees[index] = trees[0];
+    _trees[index + prevCapacity] = trees[1];
+    if (trees[0]->getSize() <= constants::UNTREEIFY_THRESHOLD) this->untreeify(index);
+    if (trees[1]->getSize() <= constants::UNTREEIFY_THRESHOLD) this->untreeify(index + prevCapacity);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapLL<K, V, H, A, O, B>::rehash() {
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    _observer.onRehashStart(prevCapacity, _capacity);
+    HashMapEntryLL<K, V> **temp = _buckets;
+    HashMapTreeLL<K, V> **tempTrees = _trees;
+    _buckets = _allocator.template allocate<HashMapEntryLL<K, V> *>(_capacity);
+    _trees = tempTrees == nullptr ? nullptr : _allocator.template allocate<HashMapTreeLL<K, V> *>(_capacity);
+
+    // Old buckets split into disjoint pairs of new buckets, so ranges are relinked concurrently without locking.
+    // Splitting a tree may create entries, which stays on one thread when the allocator is not thread safe.
+    parallel::forRanges(prevCapacity, A::threadSafe ? parallel::threadCount(prevCapacity) : 1,
+                        [this, temp, tempTrees, prevCapacity](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) this->split(temp, tempTrees, i, prevCapacity);
+    });
+
+    _allocator.deallocate(temp, prevCapacity);
+    if (tempTrees != nullptr) _allocator.deallocate(tempTrees, prevCapacity);
+    this->rebuildFilter();
+    _observer.onRehashEnd(prevCapacity, _capacity);
 }
@@ -1,81 +1,175 @@
 #pragma once
 
 #include "HashMapEntryRH.h"
+#include "Allocation.h"
+#include "ObserverPolicies.h"
+#include "FilterPolicies.h"
 #include "Constants.h"
+#include "Parallel.h"
+#include "RadixSort.h"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
+#include <vector>
 
-template <typename K, typename V, typename H = std::hash<K>>
+template <typename K, typename V, typename H = std::hash<K>, typename A = allocation::HeapAllocation,
+          typename O = NoObserver, typename B = NoFilter>
 class HashMapRH {
 private:
     HashMapEntryRH<K, V> **_buckets;
-    H _hasher;
+    [[no_unique_address]] H _hasher;
+    [[no_unique_address]] O _observer;
+    [[no_unique_address]] A _allocator;
+    [[no_unique_address]] B _filter;
     size_t _capacity;
     float _loadFactor;
     size_t _size;
 
     size_t threshold();
+    bool skipsTeardown();
+    void observeProbe(size_t steps);
+    template <typename F> void forEachIn(size_t begin, size_t end, F fn);
+    void filterRemoved(size_t count);
+    void rebuildFilter();
     int search(const K &key);
+    template <typename F> V &findOrInsert(const K &key, F factory, bool &inserted);
     void rehash();
+    void place(HashMapEntryRH<K, V> *entry);
+    size_t clusterBoundary(HashMapEntryRH<K, V> **prevBuckets, size_t prevCapacity, size_t boundary);
+    void distribute(HashMapEntryRH<K, V> **prevBuckets, size_t prevCapacity, size_t begin, size_t end, size_t from,
+                    size_t to, std::vector<HashMapEntryRH<K, V> *> &spill);
 
 public:
     HashMapRH();
     explicit HashMapRH(size_t capacity);
     HashMapRH(size_t capacity, float loadFactor);
+    HashMapRH(size_t capacity, float loadFactor, A allocator);
+    template <typename It> HashMapRH(It first, It last);
+    template <typename It> HashMapRH(It first, It last, float loadFactor);
     ~HashMapRH();
 
+    HashMapRH(const HashMapRH &) = delete;
+    HashMapRH &operator=(const HashMapRH &) = delete;
+    HashMapRH(HashMapRH &&other);
+    HashMapRH &operator=(HashMapRH &&other);
+
     size_t getCapacity();
     size_t getSize();
     float getLoadFactor();
+    O &getObserver();
 
     V put(const K &key, const V &value);
     V get(const K &key);
+    V *find(const K &key);
     V remove(const K &key);
-
+    bool tryRemove(const K &key, V &value);
+    template <typename P> size_t eraseIf(P pred);
+    template <typename F> void forEach(F fn);
+    template <typename F> void parallelForEach(F fn);
+    template <typename T, typename F, typename C> T parallelReduce(T init, F fn, C combine);
+
+    template <typename F> V &upsert(const K &key, F fn);
+    template <typename F> V &computeIfAbsent(const K &key, F factory);
+    template <typename F> V &merge(const K &key, const V &value, F combine);
+    V &operator[](const K &key);
+
+    template <typename It> void buildFrom(It first, It last);
+    void reserve(size_t size);
     void clear();
+    void swap(HashMapRH &other) noexcept;
+    HashMapRH clone();
 
     bool containsKey(const K &key);
     bool isEmpty();
 };
 
-template <typename K, typename V, typename H>
-HashMapRH<K, V, H>::HashMapRH() : _capacity(constants::DEFAULT_CAPACITY), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
-                                _size(0) {
-    _buckets = new HashMapEntryRH<K, V> *[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::HashMapRH() : HashMapRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(size_t capacity) : HashMapRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(size_t capacity, float loadFactor) : HashMapRH(capacity, loadFactor, A()) {}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(size_t capacity, float loadFactor, A allocator)
+        : _allocator(allocator), _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _buckets = _allocator.template allocate<HashMapEntryRH<K, V> *>(_capacity);
+    _filter.reset(this->threshold() + 1);
 }
 
-template <typename K, typename V, typename H>
-HashMapRH<K, V, H>::HashMapRH(size_t capacity) : _capacity(capacity), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
-                                                _size(0) {
-    _buckets = new HashMapEntryRH<K, V> *[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(It first, It last) : HashMapRH() { this->buildFrom(first, last); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(It first, It last, float loadFactor) : HashMapRH(constants::DEFAULT_CAPACITY, loadFactor) {
+    this->buildFrom(first, last);
 }
 
-template <typename K, typename V, typename H>
-HashMapRH<K, V, H>::HashMapRH(size_t capacity, float loadFactor) : _capacity(capacity), _loadFactor(loadFactor),
-                                                                    _size(0) {
-    _buckets = new HashMapEntryRH<K, V> *[_capacity]();
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::~HashMapRH() {
+    if (!this->isEmpty() && !this->skipsTeardown()) this->clear();
+    _allocator.deallocate(_buckets, _capacity);
 }
 
-template <typename K, typename V, typename H>
-HashMapRH<K, V, H>::~HashMapRH() {
-     if (!this->isEmpty()) this->clear();
-     delete []_buckets;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B>::HashMapRH(HashMapRH<K, V, H, A, O, B> &&other) : HashMapRH() { this->swap(other); }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B> &HashMapRH<K, V, H, A, O, B>::operator=(HashMapRH<K, V, H, A, O, B> &&other) {
+    HashMapRH(std::move(other)).swap(*this);
+    return *this;
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapRH<K, V, H>::getCapacity() { return _capacity; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::swap(HashMapRH<K, V, H, A, O, B> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_observer, other._observer);
+    std::swap(_allocator, other._allocator);
+    std::swap(_filter, other._filter);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+// Entries are copied into the same slots with their PSLs, so no key is hashed or probed for again
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+HashMapRH<K, V, H, A, O, B> HashMapRH<K, V, H, A, O, B>::clone() {
+    HashMapRH copy(_capacity, _loadFactor, _allocator);
+    copy._hasher = _hasher;
+    copy._filter = _filter;
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i] == nullptr) continue;
+        copy._buckets[i] = copy._allocator.template create<HashMapEntryRH<K, V>>(*_buckets[i]);
+    }
+
+    copy._size = _size;
+    return copy;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapRH<K, V, H, A, O, B>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapRH<K, V, H, A, O, B>::getSize() { return _size; }
 
-template <typename K, typename V, typename H>
-size_t HashMapRH<K, V, H>::getSize() { return _size; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+float HashMapRH<K, V, H, A, O, B>::getLoadFactor() { return _loadFactor; }
 
-template <typename K, typename V, typename H>
-float HashMapRH<K, V, H>::getLoadFactor() { return _loadFactor; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+O &HashMapRH<K, V, H, A, O, B>::getObserver() { return _observer; }
 
-template <typename K, typename V, typename H>
-V HashMapRH<K, V, H>::put(const K &key, const V &value) {
-    size_t hashValue = _hasher(key) % _capacity;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapRH<K, V, H, A, O, B>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    size_t hashValue = hash % _capacity;
 
-    auto *entry = new HashMapEntryRH<K, V>(key, value);
+    auto *entry = _allocator.template create<HashMapEntryRH<K, V>>(key, value);
     HashMapEntryRH<K, V> *current;
 
     size_t itr = 0; size_t idx;
@@ -84,7 +178,9 @@ V HashMapRH<K, V, H>::put(const K &key, const V &value) {
         current = _buckets[idx];
 
         if (current == nullptr) {
+            this->observeProbe(itr);
             _buckets[idx] = entry;
+            _filter.add(hash);
             _size++;
 
             if (this->threshold() < _size) this->rehash();
@@ -93,32 +189,55 @@ V HashMapRH<K, V, H>::put(const K &key, const V &value) {
 
         if (current->getKey() == key) break;
 
-        if (current->getPSL() < entry->getPSL()) std::swap(_buckets[idx], entry);
+        if (current->getPSL() < entry->getPSL()) {
+            _observer.onRobinHoodSwap(current->getPSL());
+            std::swap(_buckets[idx], entry);
+        }
         entry->setPSL(entry->getPSL() + 1);
         itr++;
     }
+    this->observeProbe(itr);
+    _allocator.destroy(entry);
 
     V rtnValue = current->getValue();
     current->setValue(value);
     return rtnValue;
 }
 
-template <typename K, typename V, typename H>
-V HashMapRH<K, V, H>::get(const K &key) {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapRH<K, V, H, A, O, B>::get(const K &key) {
     int idx = this->search(key);
 
     if (idx != -1) return _buckets[idx]->getValue();
     throw std::out_of_range("KeyError: Given key does not exist in map");
 }
 
-template <typename K, typename V, typename H>
-V HashMapRH<K, V, H>::remove(const K &key) {
+// Lookup for callers expecting misses, which need neither containsKey before get nor a thrown exception. The pointer
+// stays valid until the map is modified again.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V *HashMapRH<K, V, H, A, O, B>::find(const K &key) {
     int idx = this->search(key);
-    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return idx == -1 ? nullptr : &_buckets[idx]->getValueRef();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V HashMapRH<K, V, H, A, O, B>::remove(const K &key) {
+    V value;
+    if (!this->tryRemove(key, value)) throw std::out_of_range("KeyError: Given key does not exist in map");
+    return value;
+}
 
-    V rtnValue = _buckets[idx]->getValue();
-    delete _buckets[idx];
+// Removal for callers expecting misses, which copies the value of a removed key into value instead of returning it
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapRH<K, V, H, A, O, B>::tryRemove(const K &key, V &value) {
+    int idx = this->search(key);
+    if (idx == -1) return false;
+
+    value = _buckets[idx]->getValue();
+    _allocator.destroy(_buckets[idx]);
+    _buckets[idx] = nullptr;
     _size--;
+    this->filterRemoved(1);
 
     HashMapEntryRH<K, V> *next; int itr;
     while (true) {
@@ -133,23 +252,284 @@ V HashMapRH<K, V, H>::remove(const K &key) {
         idx = itr;
     }
 
-    return rtnValue;
+    return true;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapRH<K, V, H>::containsKey(const K &key) {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename P>
+size_t HashMapRH<K, V, H, A, O, B>::eraseIf(P pred) {
+    if (this->isEmpty()) return 0;
+
+    // The sweep starts at a free slot or an entry in its home, no probe sequence runs across either of them.
+    // Positions are counted from there, every survivor moves back to its home or right behind the previous
+    // survivor of its cluster, whichever is later, which is where a backward shift per removal would have left it.
+    size_t start = 0;
+    while (_buckets[start] != nullptr && _buckets[start]->getPSL() > 0) start++;
+
+    size_t erased = 0;
+    size_t next = 0;
+    for (size_t pos = 0; pos < _capacity; pos++) {
+        size_t idx = (start + pos) % _capacity;
+        HashMapEntryRH<K, V> *current = _buckets[idx];
+
+        if (current == nullptr) {
+            next = pos + 1;
+            continue;
+        }
+
+        if (pred(current->getKeyRef(), current->getValueRef())) {
+            _allocator.destroy(current);
+            _buckets[idx] = nullptr;
+            erased++;
+            continue;
+        }
+
+        size_t target = std::max(pos - current->getPSL(), next);
+        if (target != pos) {
+            current->setPSL(current->getPSL() - (pos - target));
+            _buckets[(start + target) % _capacity] = current;
+            _buckets[idx] = nullptr;
+        }
+        next = target + 1;
+    }
+
+    _size -= erased;
+    this->filterRemoved(erased);
+    return erased;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapRH<K, V, H, A, O, B>::forEachIn(size_t begin, size_t end, F fn) {
+    for (size_t i = begin; i < end; i++) {
+        if (_buckets[i] != nullptr) fn(_buckets[i]->getKeyRef(), _buckets[i]->getValueRef());
+    }
+}
+
+// Visits every entry in bucket order, fn may change values but not the map
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapRH<K, V, H, A, O, B>::forEach(F fn) { this->forEachIn(0, _capacity, fn); }
+
+// Entries are only read, so concurrent scans are safe as long as nothing writes to the map meanwhile
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+void HashMapRH<K, V, H, A, O, B>::parallelForEach(F fn) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryRH<K, V> *));
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn](size_t begin, size_t end, size_t) {
+        this->forEachIn(begin, end, fn);
+    });
+}
+
+// Every chunk folds its entries with fn starting from init, which therefore has to be the identity of combine.
+// Partial results are combined in bucket order, so combine only needs to be associative.
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename T, typename F, typename C>
+T HashMapRH<K, V, H, A, O, B>::parallelReduce(T init, F fn, C combine) {
+    size_t threads = parallel::threadCount(_capacity);
+    size_t chunk = parallel::chunkSize(_capacity, threads, sizeof(HashMapEntryRH<K, V> *));
+
+    // Each chunk writes its own cache line, which also keeps std::vector<bool> from packing the results into bits
+    struct alignas(constants::CACHE_LINE_SIZE) Partial { T value; };
+    std::vector<Partial> partials((_capacity + chunk - 1) / chunk, Partial{init});
+
+    parallel::forChunks(_capacity, chunk, threads, [this, &fn, &partials](size_t begin, size_t end, size_t index) {
+        T partial = partials[index].value;
+        this->forEachIn(begin, end, [&fn, &partial](const K &key, const V &value) {
+            partial = fn(std::move(partial), key, value);
+        });
+        partials[index].value = std::move(partial);
+    });
+
+    T result = init;
+    for (Partial &partial : partials) result = combine(std::move(result), partial.value);
+    return result;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapRH<K, V, H, A, O, B>::containsKey(const K &key) {
     if (this->search(key) == -1) return false;
     return true;
 }
 
-template <typename K, typename V, typename H>
-bool HashMapRH<K, V, H>::isEmpty() { return _size == 0; }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapRH<K, V, H, A, O, B>::upsert(const K &key, F fn) {
+    bool inserted;
+    V &value = this->findOrInsert(key, []() { return V(); }, inserted);
+    fn(value);
+    return value;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapRH<K, V, H, A, O, B>::computeIfAbsent(const K &key, F factory) {
+    bool inserted;
+    return this->findOrInsert(key, factory, inserted);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapRH<K, V, H, A, O, B>::merge(const K &key, const V &value, F combine) {
+    bool inserted;
+    V &current = this->findOrInsert(key, [&value]() { return value; }, inserted);
+    if (!inserted) current = combine(current, value);
+    return current;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+V &HashMapRH<K, V, H, A, O, B>::operator[](const K &key) {
+    bool inserted;
+    return this->findOrInsert(key, []() { return V(); }, inserted);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename F>
+V &HashMapRH<K, V, H, A, O, B>::findOrInsert(const K &key, F factory, bool &inserted) {
+    size_t hash = _hasher(key);
+    size_t hashValue = hash % _capacity;
+    inserted = false;
+
+    // The lookup stops at the first slot poorer than the probe, which is exactly where a missing key is inserted
+    size_t itr = 0; size_t idx = hashValue;
+    for (; itr < _capacity; itr++) {
+        idx = (hashValue + itr) % _capacity;
+        HashMapEntryRH<K, V> *current = _buckets[idx];
+
+        if (current == nullptr || current->getPSL() < itr) break;
+        if (current->getKey() == key) {
+            this->observeProbe(itr);
+            return current->getValueRef();
+        }
+    }
+    this->observeProbe(itr);
+
+    auto *entry = _allocator.template create<HashMapEntryRH<K, V>>(key, factory());
+    entry->setPSL(itr);
+
+    HashMapEntryRH<K, V> *displaced = entry;
+    std::swap(_buckets[idx], displaced);
+    while (displaced != nullptr) {
+        _observer.onRobinHoodSwap(displaced->getPSL());
+        idx = (idx + 1) % _capacity;
+        displaced->setPSL(displaced->getPSL() + 1);
+        while (_buckets[idx] != nullptr && _buckets[idx]->getPSL() >= displaced->getPSL()) {
+            idx = (idx + 1) % _capacity;
+            displaced->setPSL(displaced->getPSL() + 1);
+        }
+        std::swap(_buckets[idx], displaced);
+    }
+    _filter.add(hash);
+    inserted = true;
+    _size++;
+
+    if (this->threshold() < _size) this->rehash();
+    return entry->getValueRef();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+template <typename It>
+void HashMapRH<K, V, H, A, O, B>::buildFrom(It first, It last) {
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    this->reserve(_size + count);
 
-template<typename K, typename V, typename H>
-int HashMapRH<K, V, H>::search(const K &key) {
+    if (!this->isEmpty()) {
+        for (; first != last; ++first) this->put(first->first, first->second);
+        return;
+    }
+
+    std::vector<HashMapEntryRH<K, V> *> entries;
+    entries.reserve(count);
+    for (; first != last; ++first) entries.push_back(_allocator.template create<HashMapEntryRH<K, V>>(first->first, first->second));
+
+    std::vector<size_t> hashes(count);
+    std::vector<size_t> homes(count);
+    parallel::forRanges(count, parallel::threadCount(count),
+                        [this, &entries, &hashes, &homes](size_t begin, size_t end, size_t) {
+        for (size_t i = begin; i < end; i++) {
+            hashes[i] = _hasher(entries[i]->getKey());
+            homes[i] = hashes[i] % _capacity;
+        }
+    });
+
+    // With entries ordered by home bucket a Robin Hood table is laid out greedily in one pass, each entry goes
+    // to its home or right behind the previous one. Within a home entries are ordered by full hash, so duplicate
+    // keys sit next to each other; both sorts are stable, so the later value wins as with put. Entries running past
+    // the end wrap around via place.
+    std::vector<size_t> order = radix::sortedOrder(homes, _capacity);
+    for (size_t begin = 0, end = 0; begin < count; begin = end) {
+        while (end < count && homes[order[end]] == homes[order[begin]]) end++;
+        if (end - begin > 1) {
+            std::stable_sort(order.begin() + begin, order.begin() + end, [&hashes](size_t left, size_t right) {
+                return hashes[left] < hashes[right];
+            });
+        }
+    }
+
+    std::vector<HashMapEntryRH<K, V> *> overflow;
+    // Distinct keys of the current full hash, only keys whose hashes collide are ever compared with each other
+    std::vector<HashMapEntryRH<K, V> *> group;
+    size_t next = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        HashMapEntryRH<K, V> *entry = entries[order[i]];
+        size_t hashValue = homes[order[i]];
+        if (i == 0 || hashes[order[i - 1]] != hashes[order[i]]) group.clear();
+
+        auto previous = std::find_if(group.begin(), group.end(), [entry](HashMapEntryRH<K, V> *live) {
+            return live->getKey() == entry->getKey();
+        });
+        if (previous != group.end()) {
+            (*previous)->setValue(entry->getValue());
+            _allocator.destroy(entry);
+            entries[order[i]] = nullptr;
+            continue;
+        }
+        group.push_back(entry);
+
+        _size++;
+        size_t idx = std::max(hashValue, next);
+        if (idx >= _capacity) {
+            overflow.push_back(entry);
+            continue;
+        }
+
+        entry->setPSL(idx - hashValue);
+        _buckets[idx] = entry;
+        next = idx + 1;
+    }
+
+    for (HashMapEntryRH<K, V> *entry : overflow) this->place(entry);
+    this->rebuildFilter();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::reserve(size_t size) {
+    size_t capacity = _capacity;
+    while (static_cast<size_t>(capacity * _loadFactor) < size) capacity *= 2;
+    if (capacity == _capacity) return;
+
+    if (this->isEmpty()) {
+        _allocator.deallocate(_buckets, _capacity);
+        _capacity = capacity;
+        _buckets = _allocator.template allocate<HashMapEntryRH<K, V> *>(_capacity);
+        _filter.reset(this->threshold() + 1);
+        return;
+    }
+    while (_capacity < capacity) this->rehash();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapRH<K, V, H, A, O, B>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+int HashMapRH<K, V, H, A, O, B>::search(const K &key) {
     if (this->isEmpty()) return -1;
 
-    size_t hashValue = _hasher(key) % _capacity;
+    size_t hash = _hasher(key);
+    if (!_filter.mayContain(hash)) return -1;
+    size_t hashValue = hash % _capacity;
     HashMapEntryRH<K, V> *current;
 
     size_t itr = 0; size_t idx;
@@ -159,41 +539,148 @@ int HashMapRH<K, V, H>::search(const K &key) {
 
         if (current == nullptr) break;
         if (itr > current->getPSL()) break;
-        if (current->getKey() == key) return static_cast<int>(idx);
+        if (current->getKey() == key) {
+            this->observeProbe(itr);
+            return static_cast<int>(idx);
+        }
         itr++;
     }
 
+    this->observeProbe(itr);
     return -1;
 }
 
-template <typename K, typename V, typename H>
-void HashMapRH<K, V, H>::clear() {
-    for (size_t i = 0; i < _capacity; i++) {
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::clear() {
+    if (this->skipsTeardown()) {
+        std::fill(_buckets, _buckets + _capacity, nullptr);
+        _size = 0;
+    }
+
+    for (size_t i = 0; i < _capacity && _size > 0; i++) {
         HashMapEntryRH<K, V> *current = _buckets[i];
         if (current != nullptr) {
-            delete current;
+            _allocator.destroy(current);
             _buckets[i] = nullptr;
             _size--;
         }
     }
+    _filter.reset(this->threshold() + 1);
 }
 
-template <typename K, typename V, typename H>
-size_t HashMapRH<K, V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapRH<K, V, H, A, O, B>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
 
-template <typename K, typename V, typename H>
-void HashMapRH<K, V, H>::rehash() {
-    size_t prevCapacity = _capacity; _capacity *= 2;
-    HashMapEntryRH<K, V> **temp = _buckets;
-    _buckets = new HashMapEntryRH<K, V> *[_capacity]();
-    _size = 0;
+// Entries are left to the memory resource when destroying them would run no destructor and free nothing
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+bool HashMapRH<K, V, H, A, O, B>::skipsTeardown() {
+    return std::is_trivially_destructible<K>::value && std::is_trivially_destructible<V>::value &&
+           !_allocator.needsDeallocation();
+}
 
-    for (size_t i = 0; i < prevCapacity; i++) {
-        HashMapEntryRH<K, V> *current = temp[i];
-        if (current != nullptr) {
-            this->put(current->getKey(), current->getValue());
-            delete current;
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::observeProbe(size_t steps) {
+    if (steps > O::longProbe) _observer.onLongProbe(steps);
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::filterRemoved(size_t count) {
+    if (count > 0 && _filter.removed(count)) this->rebuildFilter();
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::rebuildFilter() {
+    if constexpr (B::enabled) {
+        _filter.reset(this->threshold() + 1);
+        for (size_t i = 0; i < _capacity; i++) {
+            if (_buckets[i] != nullptr) _filter.add(_hasher(_buckets[i]->getKeyRef()));
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::place(HashMapEntryRH<K, V> *entry) {
+    size_t hashValue = _hasher(entry->getKey()) % _capacity;
+    entry->setPSL(0);
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = (hashValue + itr) % _capacity;
+        if (_buckets[idx] == nullptr) {
+            _buckets[idx] = entry;
+            return;
+        }
+
+        if (_buckets[idx]->getPSL() < entry->getPSL()) std::swap(_buckets[idx], entry);
+        entry->setPSL(entry->getPSL() + 1);
+    }
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+size_t HashMapRH<K, V, H, A, O, B>::clusterBoundary(HashMapEntryRH<K, V> **prevBuckets, size_t prevCapacity, size_t boundary) {
+    // First position from the boundary on which no entry homed before the boundary is stored
+    size_t pos = boundary;
+    HashMapEntryRH<K, V> *current = prevBuckets[pos % prevCapacity];
+
+    while (current != nullptr && current->getPSL() > pos - boundary) {
+        pos++;
+        current = prevBuckets[pos % prevCapacity];
+    }
+    return pos;
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::distribute(HashMapEntryRH<K, V> **prevBuckets, size_t prevCapacity, size_t begin, size_t end,
+                                    size_t from, size_t to, std::vector<HashMapEntryRH<K, V> *> &spill) {
+    // Positions [from, to) hold exactly the entries homed in [begin, end), in order of their old home, which
+    // stays sorted in both halves of the doubled array, so each half is laid out greedily and only entries
+    // running past the range are spilled
+    size_t next[2] = {begin, begin + prevCapacity};
+    size_t limit[2] = {end, end + prevCapacity};
+
+    for (size_t pos = from; pos < to; pos++) {
+        HashMapEntryRH<K, V> *entry = prevBuckets[pos % prevCapacity];
+        if (entry == nullptr) continue;
+
+        size_t hashValue = _hasher(entry->getKey()) % _capacity;
+        int half = hashValue < prevCapacity ? 0 : 1;
+        size_t idx = std::max(hashValue, next[half]);
+
+        if (idx >= limit[half]) {
+            spill.push_back(entry);
+            continue;
         }
+
+        entry->setPSL(idx - hashValue);
+        _buckets[idx] = entry;
+        next[half] = idx + 1;
     }
-    delete []temp;
-}
\ No newline at end of file
+}
+
+template <typename K, typename V, typename H, typename A, typename O, typename B>
+void HashMapRH<K, V, H, A, O, B>::rehash() {
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    _observer.onRehashStart(prevCapacity, _capacity);
+    HashMapEntryRH<K, V> **temp = _buckets;
+    _buckets = _allocator.template allocate<HashMapEntryRH<K, V> *>(_capacity);
+
+    // Every range of old home buckets owns the matching ranges of the new array. Range borders are moved past
+    // the clusters crossing them up front, so no thread reads an entry another one is updating. Entries that
+    // do not fit into their range are staged per thread and placed afterwards with regular Robin Hood insertion.
+    size_t threads = parallel::threadCount(prevCapacity);
+    std::vector<size_t> homes = parallel::boundaries(prevCapacity, threads);
+    std::vector<size_t> positions(homes.size());
+    for (size_t t = 0; t < homes.size(); t++) positions[t] = this->clusterBoundary(temp, prevCapacity, homes[t]);
+
+    std::vector<std::vector<HashMapEntryRH<K, V> *>> spills(threads);
+    parallel::forBoundaries(homes, [this, temp, prevCapacity, &positions, &spills](size_t begin, size_t end,
+                                                                                   size_t thread) {
+        this->distribute(temp, prevCapacity, begin, end, positions[thread], positions[thread + 1], spills[thread]);
+    });
+
+    for (auto &spill : spills) {
+        for (HashMapEntryRH<K, V> *entry : spill) this->place(entry);
+    }
+    _allocator.deallocate(temp, prevCapacity);
+    this->rebuildFilter();
+    _observer.onRehashEnd(prevCapacity, _capacity);
+}
@@ -0,0 +1,251 @@
+#pragma once
+
+#include "HashMapEntryTree.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+template <typename T, typename = void>
+struct isLessComparable : std::false_type {};
+
+template <typename T>
+struct isLessComparable<T, std::void_t<decltype(std::declval<const T &>() < std::declval<const T &>())>>
+        : std::true_type {};
+
+// Balanced (AVL) bucket used by HashMapLL once a chain grows past constants::TREEIFY_THRESHOLD.
+// Entries are ordered by full hash value first and by key second.
+template <typename K, typename V>
+class HashMapTreeLL {
+private:
+    HashMapEntryTree<K, V> *_root;
+    size_t _size;
+
+    int compare(const size_t &hash, const K &key, HashMapEntryTree<K, V> *node);
+    int height(HashMapEntryTree<K, V> *node);
+    void update(HashMapEntryTree<K, V> *node);
+
+    HashMapEntryTree<K, V> *rotateLeft(HashMapEntryTree<K, V> *node);
+    HashMapEntryTree<K, V> *rotateRight(HashMapEntryTree<K, V> *node);
+    HashMapEntryTree<K, V> *balance(HashMapEntryTree<K, V> *node);
+
+    template <typename F>
+    HashMapEntryTree<K, V> *insertAt(HashMapEntryTree<K, V> *node, const size_t &hash, const K &key, F &factory,
+                                     HashMapEntryTree<K, V> *&found, bool &inserted);
+    HashMapEntryTree<K, V> *removeAt(HashMapEntryTree<K, V> *node, const size_t &hash, const K &key,
+                                     HashMapEntryTree<K, V> *&removed);
+    HashMapEntryTree<K, V> *detachMin(HashMapEntryTree<K, V> *node, HashMapEntryTree<K, V> *&min);
+
+    template <typename F>
+    void traverse(HashMapEntryTree<K, V> *node, F &fn);
+    void destroy(HashMapEntryTree<K, V> *node);
+
+public:
+    HashMapTreeLL();
+    ~HashMapTreeLL();
+
+    size_t getSize();
+
+    HashMapEntryTree<K, V> *find(const size_t &hash, const K &key);
+    HashMapEntryTree<K, V> *insert(const size_t &hash, const K &key, const V &value);
+    template <typename F>
+    HashMapEntryTree<K, V> *findOrInsert(const size_t &hash, const K &key, F factory, bool &inserted);
+    HashMapEntryTree<K, V> *remove(const size_t &hash, const K &key);
+
+    template <typename F>
+    void forEach(F fn);
+};
+
+template <typename K, typename V>
+HashMapTreeLL<K, V>::HashMapTreeLL() : _root(nullptr), _size(0) {}
+
+template <typename K, typename V>
+HashMapTreeLL<K, V>::~HashMapTreeLL() { this->destroy(_root); }
+
+template <typename K, typename V>
+size_t HashMapTreeLL<K, V>::getSize() { return _size; }
+
+template <typename K, typename V>
+int HashMapTreeLL<K, V>::compare(const size_t &hash, const K &key, HashMapEntryTree<K, V> *node) {
+    if (hash < node->getHash()) return -1;
+    if (hash > node->getHash()) return 1;
+
+    // HashMapLL never builds trees for keys without operator<, this branch only keeps them compiling
+    if constexpr (isLessComparable<K>::value) {
+        const K &other = node->getKeyRef();
+        if (key < other) return -1;
+        if (other < key) return 1;
+        return 0;
+    } else {
+        return 0;
+    }
+}
+
+template <typename K, typename V>
+int HashMapTreeLL<K, V>::height(HashMapEntryTree<K, V> *node) { return node == nullptr ? 0 : node->getHeight(); }
+
+template <typename K, typename V>
+void HashMapTreeLL<K, V>::update(HashMapEntryTree<K, V> *node) {
+    node->setHeight(1 + std::max(this->height(node->getLeft()), this->height(node->getRight())));
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::rotateLeft(HashMapEntryTree<K, V> *node) {
+    HashMapEntryTree<K, V> *right = node->getRight();
+    node->setRight(right->getLeft());
+    right->setLeft(node);
+
+    this->update(node);
+    this->update(right);
+    return right;
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::rotateRight(HashMapEntryTree<K, V> *node) {
+    HashMapEntryTree<K, V> *left = node->getLeft();
+    node->setLeft(left->getRight());
+    left->setRight(node);
+
+    this->update(node);
+    this->update(left);
+    return left;
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::balance(HashMapEntryTree<K, V> *node) {
+    this->update(node);
+    int factor = this->height(node->getLeft()) - this->height(node->getRight());
+
+    if (factor > 1) {
+        HashMapEntryTree<K, V> *left = node->getLeft();
+        if (this->height(left->getLeft()) < this->height(left->getRight())) node->setLeft(this->rotateLeft(left));
+        return this->rotateRight(node);
+    }
+
+    if (factor < -1) {
+        HashMapEntryTree<K, V> *right = node->getRight();
+        if (this->height(right->getRight()) < this->height(right->getLeft())) node->setRight(this->rotateRight(right));
+        return this->rotateLeft(node);
+    }
+
+    return node;
+}
+
+// Descends once, either stopping at the node of given key or creating the entry from factory in the empty slot
+// where the search ended, and rebalances the path on the way back
+template <typename K, typename V>
+template <typename F>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::insertAt(HashMapEntryTree<K, V> *node, const size_t &hash, const K &key,
+                                                      F &factory, HashMapEntryTree<K, V> *&found, bool &inserted) {
+    if (node == nullptr) {
+        found = new HashMapEntryTree<K, V>(hash, key, factory());
+        inserted = true;
+        _size++;
+        return found;
+    }
+
+    int cmp = this->compare(hash, key, node);
+    if (cmp == 0) {
+        found = node;
+        return node;
+    }
+
+    if (cmp < 0) node->setLeft(this->insertAt(node->getLeft(), hash, key, factory, found, inserted));
+    else node->setRight(this->insertAt(node->getRight(), hash, key, factory, found, inserted));
+    return inserted ? this->balance(node) : node;
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::detachMin(HashMapEntryTree<K, V> *node, HashMapEntryTree<K, V> *&min) {
+    if (node->getLeft() == nullptr) {
+        min = node;
+        return node->getRight();
+    }
+
+    node->setLeft(this->detachMin(node->getLeft(), min));
+    return this->balance(node);
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::removeAt(HashMapEntryTree<K, V> *node, const size_t &hash, const K &key,
+                                                      HashMapEntryTree<K, V> *&removed) {
+    if (node == nullptr) return nullptr;
+
+    int cmp = this->compare(hash, key, node);
+    if (cmp < 0) node->setLeft(this->removeAt(node->getLeft(), hash, key, removed));
+    else if (cmp > 0) node->setRight(this->removeAt(node->getRight(), hash, key, removed));
+    else {
+        removed = node;
+        if (node->getLeft() == nullptr) return node->getRight();
+        if (node->getRight() == nullptr) return node->getLeft();
+
+        HashMapEntryTree<K, V> *min;
+        HashMapEntryTree<K, V> *rest = this->detachMin(node->getRight(), min);
+        min->setLeft(node->getLeft());
+        min->setRight(rest);
+        node = min;
+    }
+
+    return this->balance(node);
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::find(const size_t &hash, const K &key) {
+    HashMapEntryTree<K, V> *current = _root;
+
+    while (current != nullptr) {
+        int cmp = this->compare(hash, key, current);
+        if (cmp == 0) return current;
+        current = cmp < 0 ? current->getLeft() : current->getRight();
+    }
+    return nullptr;
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::insert(const size_t &hash, const K &key, const V &value) {
+    bool inserted = false;
+    HashMapEntryTree<K, V> *existing = this->findOrInsert(hash, key, [&value]() { return value; }, inserted);
+    return inserted ? nullptr : existing;
+}
+
+template <typename K, typename V>
+template <typename F>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::findOrInsert(const size_t &hash, const K &key, F factory, bool &inserted) {
+    HashMapEntryTree<K, V> *found = nullptr;
+    inserted = false;
+    _root = this->insertAt(_root, hash, key, factory, found, inserted);
+    return found;
+}
+
+template <typename K, typename V>
+HashMapEntryTree<K, V> *HashMapTreeLL<K, V>::remove(const size_t &hash, const K &key) {
+    HashMapEntryTree<K, V> *removed = nullptr;
+    _root = this->removeAt(_root, hash, key, removed);
+    if (removed == nullptr) return nullptr;
+
+    removed->setLeft(nullptr);
+    removed->setRight(nullptr);
+    _size--;
+    return removed;
+}
+
+template <typename K, typename V>
+template <typename F>
+void HashMapTreeLL<K, V>::traverse(HashMapEntryTree<K, V> *node, F &fn) {
+    if (node == nullptr) return;
+    this->traverse(node->getLeft(), fn);
+    fn(node);
+    this->traverse(node->getRight(), fn);
+}
+
+template <typename K, typename V>
+template <typename F>
+void HashMapTreeLL<K, V>::forEach(F fn) { this->traverse(_root, fn); }
+
+template <typename K, typename V>
+void HashMapTreeLL<K, V>::destroy(HashMapEntryTree<K, V> *node) {
+    if (node == nullptr) return;
+    this->destroy(node->getLeft());
+    this->destroy(node->getRight());
+    delete node;
+}
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "HashSetEntryDH.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <utility>
+#include <cmath>
+
+template <typename K, typename H = std::hash<K>, typename A = allocation::HeapAllocation>
+class HashSetDH {
+private:
+    HashSetEntryDH<K> *_buckets;
+    H _hasher;
+    A _allocator;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+    size_t _how_much_free;
+
+    size_t threshold();
+    void rehash();
+    int searchHashed(size_t hash, const K &key);
+    bool insertHashed(size_t hash, const K &key);
+    void eraseAt(size_t index);
+    size_t getNextPrime(size_t capacity);
+    bool isPrime(size_t n);
+
+public:
+    HashSetDH();
+    explicit HashSetDH(size_t capacity);
+    HashSetDH(size_t capacity, float loadFactor);
+    HashSetDH(size_t capacity, float loadFactor, A allocator);
+    ~HashSetDH();
+
+    HashSetDH(const HashSetDH &) = delete;
+    HashSetDH &operator=(const HashSetDH &) = delete;
+    HashSetDH(HashSetDH &&other);
+    HashSetDH &operator=(HashSetDH &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    bool insert(const K &key);
+    bool contains(const K &key);
+    bool erase(const K &key);
+
+    void addAll(HashSetDH &other);
+    void retainAll(HashSetDH &other);
+    void removeAll(HashSetDH &other);
+
+    void reserve(size_t size);
+    void clear();
+    void swap(HashSetDH &other) noexcept;
+
+    bool isEmpty();
+};
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::HashSetDH() : HashSetDH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::HashSetDH(size_t capacity) : HashSetDH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::HashSetDH(size_t capacity, float loadFactor) : HashSetDH(capacity, loadFactor, A()) {}
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::HashSetDH(size_t capacity, float loadFactor, A allocator)
+        : _allocator(allocator), _loadFactor(loadFactor), _size(0) {
+    _capacity = getNextPrime(capacity);
+    _buckets = _allocator.template allocate<HashSetEntryDH<K>>(_capacity);
+    _how_much_free = _capacity;
+}
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::~HashSetDH() {
+    _allocator.deallocate(_buckets, _capacity);
+}
+
+// The moved-from set is left empty with the default capacity
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A>::HashSetDH(HashSetDH<K, H, A> &&other) : HashSetDH() { this->swap(other); }
+
+template <typename K, typename H, typename A>
+HashSetDH<K, H, A> &HashSetDH<K, H, A>::operator=(HashSetDH<K, H, A> &&other) {
+    HashSetDH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::swap(HashSetDH<K, H, A> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_allocator, other._allocator);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+    std::swap(_how_much_free, other._how_much_free);
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetDH<K, H, A>::getCapacity() { return _capacity; }
+
+template <typename K, typename H, typename A>
+size_t HashSetDH<K, H, A>::getSize() { return _size; }
+
+template <typename K, typename H, typename A>
+float HashSetDH<K, H, A>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::isPrime(size_t n) {
+    if (n <= 1) return false;
+    if (n <= 3) return true;
+    if (n % 2 == 0 || n % 3 == 0) return false;
+    for (size_t i = 5; i * i <= n; i = i + 6) {
+        if (n % i == 0 || n % (i + 2) == 0) return false;
+    }
+    return true;
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetDH<K, H, A>::getNextPrime(size_t capacity) {
+    if (capacity <= 1) return 2;
+    while (!isPrime(capacity)) capacity++;
+    return capacity;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::insert(const K &key) { return this->insertHashed(_hasher(key), key); }
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::contains(const K &key) { return this->searchHashed(_hasher(key), key) != -1; }
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::erase(const K &key) {
+    int idx = this->searchHashed(_hasher(key), key);
+    if (idx == -1) return false;
+
+    this->eraseAt(idx);
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::addAll(HashSetDH &other) {
+    if (&other == this) return;
+
+    // Double hashing scatters keys over the whole array, so every occupied slot of the other set is visited
+    // once and its key hashed a single time for both the lookup and the insertion
+    this->reserve(_size + other._size);
+    for (size_t i = 0; i < other._capacity; i++) {
+        if (other._buckets[i].getStatus() != 'o') continue;
+        this->insertHashed(_hasher(other._buckets[i].getKey()), other._buckets[i].getKey());
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::retainAll(HashSetDH &other) {
+    if (&other == this) return;
+
+    // Erased slots only become tombstones, so the array is scanned in place
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i].getStatus() != 'o') continue;
+        if (!other.contains(_buckets[i].getKey())) this->eraseAt(i);
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::removeAll(HashSetDH &other) {
+    if (&other == this) {
+        this->clear();
+        return;
+    }
+
+    for (size_t i = 0; i < other._capacity; i++) {
+        if (other._buckets[i].getStatus() != 'o') continue;
+
+        int idx = this->searchHashed(_hasher(other._buckets[i].getKey()), other._buckets[i].getKey());
+        if (idx != -1) this->eraseAt(idx);
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::reserve(size_t size) {
+    while (this->threshold() < size) this->rehash();
+}
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::isEmpty() { return _size == 0; }
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::clear() {
+    _allocator.deallocate(_buckets, _capacity);
+    _buckets = _allocator.template allocate<HashSetEntryDH<K>>(_capacity);
+    _size = 0;
+    _how_much_free = _capacity;
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetDH<K, H, A>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename H, typename A>
+int HashSetDH<K, H, A>::searchHashed(size_t hash, const K &key) {
+    size_t hashValue = hash % _capacity;
+    size_t step = 1 + hash % (_capacity - 1);
+
+    for (size_t itr = 0; itr < _capacity && _buckets[hashValue].getStatus() != 'f'; itr++) {
+        if (_buckets[hashValue].getStatus() == 'o' && _buckets[hashValue].getKey() == key) {
+            return static_cast<int>(hashValue);
+        }
+        hashValue = (hashValue + step) % _capacity;
+    }
+    return -1;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetDH<K, H, A>::insertHashed(size_t hash, const K &key) {
+    size_t hashValue = hash % _capacity;
+    size_t step = 1 + hash % (_capacity - 1);
+    size_t first_a = _capacity;
+
+    while (_buckets[hashValue].getStatus() != 'f') {
+        if (_buckets[hashValue].getStatus() == 'o' && _buckets[hashValue].getKey() == key) return false;
+        if (_buckets[hashValue].getStatus() == 'a' && first_a == _capacity) first_a = hashValue;
+        hashValue = (hashValue + step) % _capacity;
+    }
+
+    _size++;
+    if (first_a != _capacity) {
+        _buckets[first_a] = HashSetEntryDH<K>(key);
+        return true;
+    }
+
+    _buckets[hashValue] = HashSetEntryDH<K>(key);
+    _how_much_free--;
+
+    // Like the chained and Robin Hood sets, the array grows once the used slots exceed the threshold,
+    // or when the last free slot is taken and further probes could not terminate
+    if (_capacity - _how_much_free > this->threshold() || _how_much_free == 0) this->rehash();
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::eraseAt(size_t index) {
+    _buckets[index].setStatus('a');
+    _buckets[index].setKey(K());
+    _size--;
+}
+
+template <typename K, typename H, typename A>
+void HashSetDH<K, H, A>::rehash() {
+    size_t prevCapacity = _capacity;
+    _capacity = getNextPrime(_capacity * 2);
+    HashSetEntryDH<K> *temp = _buckets;
+    _buckets = _allocator.template allocate<HashSetEntryDH<K>>(_capacity);
+    _size = 0;
+    _how_much_free = _capacity;
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        if (temp[i].getStatus() == 'o') this->insertHashed(_hasher(temp[i].getKey()), temp[i].getKey());
+    }
+
+    _allocator.deallocate(temp, prevCapacity);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+template <typename K>
+class HashSetEntry {
+protected:
+    K _key;
+
+public:
+    explicit HashSetEntry(const K &key);
+    ~HashSetEntry();
+
+    K getKey();
+    void setKey(const K &key);
+};
+
+template <typename K>
+HashSetEntry<K>::HashSetEntry(const K &key) : _key(key) {}
+
+template <typename K>
+HashSetEntry<K>::~HashSetEntry() = default;
+
+template <typename K>
+K HashSetEntry<K>::getKey() { return _key; }
+
+template <typename K>
+void HashSetEntry<K>::setKey(const K &key) { _key = key; }
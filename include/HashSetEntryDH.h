@@ -0,0 +1,32 @@
+#pragma once
+
+#include "HashSetEntry.h"
+
+template <typename K>
+class HashSetEntryDH : public HashSetEntry<K> {
+private:
+    char _status;   //'f'=free,'a'=accessed,'o'occupied
+
+public:
+    HashSetEntryDH();
+    explicit HashSetEntryDH(const K &key);
+    ~HashSetEntryDH();
+
+    char getStatus();
+    void setStatus(char status);
+};
+
+template <typename K>
+HashSetEntryDH<K>::HashSetEntryDH() : HashSetEntry<K>(K()), _status('f') {}
+
+template <typename K>
+HashSetEntryDH<K>::HashSetEntryDH(const K &key) : HashSetEntry<K>(key), _status('o') {}
+
+template <typename K>
+HashSetEntryDH<K>::~HashSetEntryDH() = default;
+
+template <typename K>
+char HashSetEntryDH<K>::getStatus() { return _status; }
+
+template <typename K>
+void HashSetEntryDH<K>::setStatus(char status) { _status = status; }
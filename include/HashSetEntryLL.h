@@ -0,0 +1,28 @@
+#pragma once
+
+#include "HashSetEntry.h"
+
+template <typename K>
+class HashSetEntryLL : public HashSetEntry<K> {
+private:
+    HashSetEntryLL *_next;
+
+public:
+    explicit HashSetEntryLL(const K &key);
+    ~HashSetEntryLL();
+
+    HashSetEntryLL *getNext();
+    void setNext(HashSetEntryLL *next);
+};
+
+template <typename K>
+HashSetEntryLL<K>::HashSetEntryLL(const K &key) : HashSetEntry<K>(key), _next(nullptr) {}
+
+template <typename K>
+HashSetEntryLL<K>::~HashSetEntryLL() = default;
+
+template <typename K>
+HashSetEntryLL<K> *HashSetEntryLL<K>::getNext() { return _next; }
+
+template <typename K>
+void HashSetEntryLL<K>::setNext(HashSetEntryLL<K> *next) { _next = next; }
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "HashSetEntry.h"
+
+#include <iostream>
+
+template <typename K>
+class HashSetEntryRH : public HashSetEntry<K> {
+private:
+    size_t _psl;
+
+public:
+    explicit HashSetEntryRH(const K &key);
+    ~HashSetEntryRH();
+
+    size_t getPSL();
+    void setPSL(const size_t &psl);
+};
+
+template <typename K>
+HashSetEntryRH<K>::HashSetEntryRH(const K &key) : HashSetEntry<K>(key), _psl(0) {}
+
+template <typename K>
+HashSetEntryRH<K>::~HashSetEntryRH() = default;
+
+template <typename K>
+size_t HashSetEntryRH<K>::getPSL() { return _psl; }
+
+template <typename K>
+void HashSetEntryRH<K>::setPSL(const size_t &psl) { _psl = psl; }
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "HashSetEntryLL.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <utility>
+
+template <typename K, typename H = std::hash<K>, typename A = allocation::HeapAllocation>
+class HashSetLL {
+private:
+    HashSetEntryLL<K> **_buckets;
+    H _hasher;
+    A _allocator;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    size_t threshold();
+    void rehash();
+    bool insertAt(size_t index, const K &key);
+    bool containsAt(size_t index, const K &key);
+    bool eraseAt(size_t index, const K &key);
+    void keepWhere(HashSetLL &other, bool present);
+
+public:
+    HashSetLL();
+    explicit HashSetLL(size_t capacity);
+    HashSetLL(size_t capacity, float loadFactor);
+    HashSetLL(size_t capacity, float loadFactor, A allocator);
+    ~HashSetLL();
+
+    HashSetLL(const HashSetLL &) = delete;
+    HashSetLL &operator=(const HashSetLL &) = delete;
+    HashSetLL(HashSetLL &&other);
+    HashSetLL &operator=(HashSetLL &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    bool insert(const K &key);
+    bool contains(const K &key);
+    bool erase(const K &key);
+
+    void addAll(HashSetLL &other);
+    void retainAll(HashSetLL &other);
+    void removeAll(HashSetLL &other);
+
+    void reserve(size_t size);
+    void clear();
+    void swap(HashSetLL &other) noexcept;
+
+    bool isEmpty();
+};
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::HashSetLL() : HashSetLL(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::HashSetLL(size_t capacity) : HashSetLL(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::HashSetLL(size_t capacity, float loadFactor) : HashSetLL(capacity, loadFactor, A()) {}
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::HashSetLL(size_t capacity, float loadFactor, A allocator)
+        : _allocator(allocator), _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _buckets = _allocator.template allocate<HashSetEntryLL<K> *>(_capacity);
+}
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::~HashSetLL() {
+    if (!this->isEmpty()) this->clear();
+    _allocator.deallocate(_buckets, _capacity);
+}
+
+// The moved-from set is left empty with the default capacity
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A>::HashSetLL(HashSetLL<K, H, A> &&other) : HashSetLL() { this->swap(other); }
+
+template <typename K, typename H, typename A>
+HashSetLL<K, H, A> &HashSetLL<K, H, A>::operator=(HashSetLL<K, H, A> &&other) {
+    HashSetLL(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::swap(HashSetLL<K, H, A> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_allocator, other._allocator);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetLL<K, H, A>::getCapacity() { return _capacity; }
+
+template <typename K, typename H, typename A>
+size_t HashSetLL<K, H, A>::getSize() { return _size; }
+
+template <typename K, typename H, typename A>
+float HashSetLL<K, H, A>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::insert(const K &key) {
+    if (!this->insertAt(_hasher(key) % _capacity, key)) return false;
+
+    _size++;
+    if (this->threshold() < _size) this->rehash();
+    return true;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::contains(const K &key) { return this->containsAt(_hasher(key) % _capacity, key); }
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::erase(const K &key) {
+    if (!this->eraseAt(_hasher(key) % _capacity, key)) return false;
+
+    _size--;
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::addAll(HashSetLL &other) {
+    if (&other == this) return;
+
+    // When the capacity of this set divides the other one, the bucket of every key follows from the bucket
+    // it occupies in the other set, so the other set is merged bucket by bucket without hashing its keys again
+    this->reserve(_size + other._size);
+    bool aligned = other._capacity % _capacity == 0;
+
+    for (size_t i = 0; i < other._capacity; i++) {
+        for (HashSetEntryLL<K> *entry = other._buckets[i]; entry != nullptr; entry = entry->getNext()) {
+            size_t index = aligned ? i % _capacity : _hasher(entry->getKey()) % _capacity;
+            if (this->insertAt(index, entry->getKey())) _size++;
+        }
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::retainAll(HashSetLL &other) {
+    if (&other == this) return;
+    this->keepWhere(other, true);
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::removeAll(HashSetLL &other) {
+    if (&other == this) {
+        this->clear();
+        return;
+    }
+
+    // A larger set is filtered in its own bucket order, since only the bucket in the smaller set follows
+    // from the bucket in the larger one
+    if (_capacity > other._capacity && _capacity % other._capacity == 0) {
+        this->keepWhere(other, false);
+        return;
+    }
+    bool aligned = other._capacity % _capacity == 0;
+
+    for (size_t i = 0; i < other._capacity; i++) {
+        for (HashSetEntryLL<K> *entry = other._buckets[i]; entry != nullptr; entry = entry->getNext()) {
+            size_t index = aligned ? i % _capacity : _hasher(entry->getKey()) % _capacity;
+            if (this->eraseAt(index, entry->getKey())) _size--;
+        }
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::reserve(size_t size) {
+    while (this->threshold() < size) this->rehash();
+}
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::isEmpty() { return _size == 0; }
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        HashSetEntryLL<K> *current = _buckets[i];
+        HashSetEntryLL<K> *helper;
+
+        while (current != nullptr) {
+            helper = current;
+            current = current->getNext();
+
+            _size--;
+            _allocator.destroy(helper);
+        }
+        _buckets[i] = nullptr;
+    }
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetLL<K, H, A>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::keepWhere(HashSetLL &other, bool present) {
+    bool aligned = _capacity % other._capacity == 0;
+
+    for (size_t i = 0; i < _capacity; i++) {
+        HashSetEntryLL<K> *entry = _buckets[i];
+        HashSetEntryLL<K> *prev = nullptr;
+
+        while (entry != nullptr) {
+            HashSetEntryLL<K> *next = entry->getNext();
+            bool found = aligned ? other.containsAt(i % other._capacity, entry->getKey())
+                                 : other.contains(entry->getKey());
+
+            if (found == present) {
+                prev = entry;
+            } else {
+                if (prev == nullptr) _buckets[i] = next;
+                else prev->setNext(next);
+
+                _size--;
+                _allocator.destroy(entry);
+            }
+            entry = next;
+        }
+    }
+}
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::insertAt(size_t index, const K &key) {
+    HashSetEntryLL<K> *entry = _buckets[index];
+    HashSetEntryLL<K> *prev = nullptr;
+
+    while (entry != nullptr) {
+        if (entry->getKey() == key) return false;
+        prev = entry;
+        entry = entry->getNext();
+    }
+
+    if (prev == nullptr) _buckets[index] = _allocator.template create<HashSetEntryLL<K>>(key);
+    else prev->setNext(_allocator.template create<HashSetEntryLL<K>>(key));
+    return true;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::containsAt(size_t index, const K &key) {
+    HashSetEntryLL<K> *entry = _buckets[index];
+    while (entry != nullptr && entry->getKey() != key) entry = entry->getNext();
+    return entry != nullptr;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetLL<K, H, A>::eraseAt(size_t index, const K &key) {
+    HashSetEntryLL<K> *entry = _buckets[index];
+    HashSetEntryLL<K> *prev = nullptr;
+
+    while (entry != nullptr && entry->getKey() != key) {
+        prev = entry;
+        entry = entry->getNext();
+    }
+    if (entry == nullptr) return false;
+
+    if (prev == nullptr) _buckets[index] = entry->getNext();
+    else prev->setNext(entry->getNext());
+
+    _allocator.destroy(entry);
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetLL<K, H, A>::rehash() {
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    HashSetEntryLL<K> **temp = _buckets;
+    _buckets = _allocator.template allocate<HashSetEntryLL<K> *>(_capacity);
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        HashSetEntryLL<K> *current = temp[i];
+        while (current != nullptr) {
+            HashSetEntryLL<K> *next = current->getNext();
+            size_t index = _hasher(current->getKey()) % _capacity;
+
+            current->setNext(_buckets[index]);
+            _buckets[index] = current;
+            current = next;
+        }
+    }
+
+    _allocator.deallocate(temp, prevCapacity);
+}
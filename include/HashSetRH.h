@@ -0,0 +1,301 @@
+#pragma once
+
+#include "HashSetEntryRH.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <utility>
+
+template <typename K, typename H = std::hash<K>, typename A = allocation::HeapAllocation>
+class HashSetRH {
+private:
+    HashSetEntryRH<K> **_buckets;
+    H _hasher;
+    A _allocator;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    size_t threshold();
+    void rehash();
+    size_t home(size_t index);
+    int searchFrom(size_t hashValue, const K &key);
+    bool insertAt(size_t hashValue, const K &key);
+    void eraseAt(size_t index);
+    void keepWhere(HashSetRH &other, bool present);
+
+public:
+    HashSetRH();
+    explicit HashSetRH(size_t capacity);
+    HashSetRH(size_t capacity, float loadFactor);
+    HashSetRH(size_t capacity, float loadFactor, A allocator);
+    ~HashSetRH();
+
+    HashSetRH(const HashSetRH &) = delete;
+    HashSetRH &operator=(const HashSetRH &) = delete;
+    HashSetRH(HashSetRH &&other);
+    HashSetRH &operator=(HashSetRH &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    bool insert(const K &key);
+    bool contains(const K &key);
+    bool erase(const K &key);
+
+    void addAll(HashSetRH &other);
+    void retainAll(HashSetRH &other);
+    void removeAll(HashSetRH &other);
+
+    void reserve(size_t size);
+    void clear();
+    void swap(HashSetRH &other) noexcept;
+
+    bool isEmpty();
+};
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::HashSetRH() : HashSetRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::HashSetRH(size_t capacity) : HashSetRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::HashSetRH(size_t capacity, float loadFactor) : HashSetRH(capacity, loadFactor, A()) {}
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::HashSetRH(size_t capacity, float loadFactor, A allocator)
+        : _allocator(allocator), _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _buckets = _allocator.template allocate<HashSetEntryRH<K> *>(_capacity);
+}
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::~HashSetRH() {
+    if (!this->isEmpty()) this->clear();
+    _allocator.deallocate(_buckets, _capacity);
+}
+
+// The moved-from set is left empty with the default capacity
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A>::HashSetRH(HashSetRH<K, H, A> &&other) : HashSetRH() { this->swap(other); }
+
+template <typename K, typename H, typename A>
+HashSetRH<K, H, A> &HashSetRH<K, H, A>::operator=(HashSetRH<K, H, A> &&other) {
+    HashSetRH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::swap(HashSetRH<K, H, A> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_allocator, other._allocator);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetRH<K, H, A>::getCapacity() { return _capacity; }
+
+template <typename K, typename H, typename A>
+size_t HashSetRH<K, H, A>::getSize() { return _size; }
+
+template <typename K, typename H, typename A>
+float HashSetRH<K, H, A>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename H, typename A>
+bool HashSetRH<K, H, A>::insert(const K &key) {
+    if (!this->insertAt(_hasher(key) % _capacity, key)) return false;
+
+    _size++;
+    if (this->threshold() < _size) this->rehash();
+    return true;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetRH<K, H, A>::contains(const K &key) { return this->searchFrom(_hasher(key) % _capacity, key) != -1; }
+
+template <typename K, typename H, typename A>
+bool HashSetRH<K, H, A>::erase(const K &key) {
+    int idx = this->searchFrom(_hasher(key) % _capacity, key);
+    if (idx == -1) return false;
+
+    this->eraseAt(idx);
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::addAll(HashSetRH &other) {
+    if (&other == this) return;
+
+    // The home bucket of every entry follows from its position and PSL, and when the capacity of this set
+    // divides the other one it also gives the home in this set, so the other set is merged in one pass
+    // over its array without hashing its keys again
+    this->reserve(_size + other._size);
+    bool aligned = other._capacity % _capacity == 0;
+
+    for (size_t i = 0; i < other._capacity; i++) {
+        HashSetEntryRH<K> *entry = other._buckets[i];
+        if (entry == nullptr) continue;
+
+        size_t hashValue = aligned ? other.home(i) % _capacity : _hasher(entry->getKey()) % _capacity;
+        if (this->insertAt(hashValue, entry->getKey())) _size++;
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::retainAll(HashSetRH &other) {
+    if (&other == this) return;
+    this->keepWhere(other, true);
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::removeAll(HashSetRH &other) {
+    if (&other == this) {
+        this->clear();
+        return;
+    }
+
+    // A larger set is filtered in its own array order, since only the home in the smaller set follows
+    // from the home in the larger one
+    if (_capacity > other._capacity && _capacity % other._capacity == 0) {
+        this->keepWhere(other, false);
+        return;
+    }
+    bool aligned = other._capacity % _capacity == 0;
+
+    for (size_t i = 0; i < other._capacity; i++) {
+        HashSetEntryRH<K> *entry = other._buckets[i];
+        if (entry == nullptr) continue;
+
+        size_t hashValue = aligned ? other.home(i) % _capacity : _hasher(entry->getKey()) % _capacity;
+        int idx = this->searchFrom(hashValue, entry->getKey());
+        if (idx != -1) this->eraseAt(idx);
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::reserve(size_t size) {
+    while (this->threshold() < size) this->rehash();
+}
+
+template <typename K, typename H, typename A>
+bool HashSetRH<K, H, A>::isEmpty() { return _size == 0; }
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        if (_buckets[i] != nullptr) {
+            _allocator.destroy(_buckets[i]);
+            _buckets[i] = nullptr;
+            _size--;
+        }
+    }
+}
+
+template <typename K, typename H, typename A>
+size_t HashSetRH<K, H, A>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename H, typename A>
+size_t HashSetRH<K, H, A>::home(size_t index) {
+    return (index + _capacity - _buckets[index]->getPSL() % _capacity) % _capacity;
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::keepWhere(HashSetRH &other, bool present) {
+    bool aligned = _capacity % other._capacity == 0;
+
+    // Backward shift moves the next entry onto an erased slot, so the position is examined again
+    size_t i = 0;
+    while (i < _capacity) {
+        HashSetEntryRH<K> *entry = _buckets[i];
+        if (entry == nullptr) {
+            i++;
+            continue;
+        }
+
+        size_t hashValue = aligned ? this->home(i) % other._capacity : _hasher(entry->getKey()) % other._capacity;
+        if ((other.searchFrom(hashValue, entry->getKey()) != -1) == present) i++;
+        else this->eraseAt(i);
+    }
+}
+
+template <typename K, typename H, typename A>
+int HashSetRH<K, H, A>::searchFrom(size_t hashValue, const K &key) {
+    if (this->isEmpty()) return -1;
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = (hashValue + itr) % _capacity;
+        HashSetEntryRH<K> *current = _buckets[idx];
+
+        if (current == nullptr) break;
+        if (itr > current->getPSL()) break;
+        if (current->getKey() == key) return static_cast<int>(idx);
+    }
+    return -1;
+}
+
+template <typename K, typename H, typename A>
+bool HashSetRH<K, H, A>::insertAt(size_t hashValue, const K &key) {
+    if (this->searchFrom(hashValue, key) != -1) return false;
+
+    auto *entry = _allocator.template create<HashSetEntryRH<K>>(key);
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = (hashValue + itr) % _capacity;
+        if (_buckets[idx] == nullptr) {
+            _buckets[idx] = entry;
+            return true;
+        }
+
+        if (_buckets[idx]->getPSL() < entry->getPSL()) std::swap(_buckets[idx], entry);
+        entry->setPSL(entry->getPSL() + 1);
+    }
+    return true;
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::eraseAt(size_t index) {
+    _allocator.destroy(_buckets[index]);
+    _buckets[index] = nullptr;
+    _size--;
+
+    size_t next = (index + 1) % _capacity;
+    while (_buckets[next] != nullptr && _buckets[next]->getPSL() > 0) {
+        _buckets[next]->setPSL(_buckets[next]->getPSL() - 1);
+        _buckets[index] = _buckets[next];
+        _buckets[next] = nullptr;
+
+        index = next;
+        next = (index + 1) % _capacity;
+    }
+}
+
+template <typename K, typename H, typename A>
+void HashSetRH<K, H, A>::rehash() {
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    HashSetEntryRH<K> **temp = _buckets;
+    _buckets = _allocator.template allocate<HashSetEntryRH<K> *>(_capacity);
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        HashSetEntryRH<K> *entry = temp[i];
+        if (entry == nullptr) continue;
+
+        size_t hashValue = _hasher(entry->getKey()) % _capacity;
+        entry->setPSL(0);
+        for (size_t itr = 0; itr < _capacity; itr++) {
+            size_t idx = (hashValue + itr) % _capacity;
+            if (_buckets[idx] == nullptr) {
+                _buckets[idx] = entry;
+                break;
+            }
+
+            if (_buckets[idx]->getPSL() < entry->getPSL()) std::swap(_buckets[idx], entry);
+            entry->setPSL(entry->getPSL() + 1);
+        }
+    }
+
+    _allocator.deallocate(temp, prevCapacity);
+}
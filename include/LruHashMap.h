@@ -0,0 +1,337 @@
+#pragma once
+
+#include "HashMapEntryLRU.h"
+#include "EvictionPolicies.h"
+#include "Constants.h"
+
+#include <functional>
+#include <iostream>
+#include <utility>
+
+// Chained hash map bounded by the total weight of its entries, every entry weighs 1 unless a weigher is given.
+// A doubly linked recency list runs through the entries themselves, so touching and evicting are O(1).
+template <typename K, typename V, typename H = std::hash<K>, typename Policy = LruEviction>
+class LruHashMap {
+private:
+    HashMapEntryLRU<K, V> **_buckets;
+    HashMapEntryLRU<K, V> *_newest;
+    HashMapEntryLRU<K, V> *_oldest;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+    size_t _weight;
+    size_t _maxWeight;
+    std::function<size_t(const K &, const V &)> _weigher;
+    std::function<void(const K &, const V &)> _listener;
+
+    size_t threshold();
+    void rehash();
+    size_t weigh(const K &key, const V &value);
+    HashMapEntryLRU<K, V> *find(size_t hashValue, const K &key);
+
+    void link(HashMapEntryLRU<K, V> *entry);
+    void unlink(HashMapEntryLRU<K, V> *entry);
+    void touch(HashMapEntryLRU<K, V> *entry);
+    void detach(size_t hashValue, HashMapEntryLRU<K, V> *entry);
+    void evict();
+
+public:
+    explicit LruHashMap(size_t maxWeight);
+    LruHashMap(size_t maxWeight, std::function<size_t(const K &, const V &)> weigher);
+    ~LruHashMap();
+
+    LruHashMap(const LruHashMap &) = delete;
+    LruHashMap &operator=(const LruHashMap &) = delete;
+    LruHashMap(LruHashMap &&other);
+    LruHashMap &operator=(LruHashMap &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    size_t getWeight();
+    size_t getMaxWeight();
+    float getLoadFactor();
+
+    void setEvictionListener(std::function<void(const K &, const V &)> listener);
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void clear();
+    void swap(LruHashMap &other) noexcept;
+    LruHashMap clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy>::LruHashMap(size_t maxWeight) : LruHashMap(maxWeight, nullptr) {}
+
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy>::LruHashMap(size_t maxWeight, std::function<size_t(const K &, const V &)> weigher)
+        : _newest(nullptr), _oldest(nullptr), _capacity(constants::DEFAULT_CAPACITY),
+          _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0), _weight(0), _maxWeight(maxWeight),
+          _weigher(std::move(weigher)) {
+    _buckets = new HashMapEntryLRU<K, V> *[_capacity]();
+}
+
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy>::~LruHashMap() {
+    if (!this->isEmpty()) this->clear();
+    delete []_buckets;
+}
+
+// The moved-from map is left empty, with the same bound but without a weigher
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy>::LruHashMap(LruHashMap<K, V, H, Policy> &&other) : LruHashMap(other._maxWeight) { this->swap(other); }
+
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy> &LruHashMap<K, V, H, Policy>::operator=(LruHashMap<K, V, H, Policy> &&other) {
+    LruHashMap(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::swap(LruHashMap<K, V, H, Policy> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_newest, other._newest);
+    std::swap(_oldest, other._oldest);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+    std::swap(_weight, other._weight);
+    std::swap(_maxWeight, other._maxWeight);
+    std::swap(_weigher, other._weigher);
+    std::swap(_listener, other._listener);
+}
+
+// Entries are linked into the copy from the oldest to the newest, so both maps go on to evict in the same order
+template <typename K, typename V, typename H, typename Policy>
+LruHashMap<K, V, H, Policy> LruHashMap<K, V, H, Policy>::clone() {
+    LruHashMap copy(_maxWeight, _weigher);
+    copy._hasher = _hasher;
+    copy._listener = _listener;
+
+    delete []copy._buckets;
+    copy._capacity = _capacity;
+    copy._loadFactor = _loadFactor;
+    copy._buckets = new HashMapEntryLRU<K, V> *[_capacity]();
+
+    for (HashMapEntryLRU<K, V> *current = _oldest; current != nullptr; current = current->getNewer()) {
+        auto *entry = new HashMapEntryLRU<K, V>(current->getKeyRef(), current->getValueRef(), current->getWeight());
+        entry->setReferenced(current->isReferenced());
+
+        size_t hashValue = _hasher(entry->getKeyRef()) % _capacity;
+        entry->setNext(copy._buckets[hashValue]);
+        copy._buckets[hashValue] = entry;
+        copy.link(entry);
+    }
+
+    copy._size = _size;
+    copy._weight = _weight;
+    return copy;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::getSize() { return _size; }
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::getWeight() { return _weight; }
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::getMaxWeight() { return _maxWeight; }
+
+template <typename K, typename V, typename H, typename Policy>
+float LruHashMap<K, V, H, Policy>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::setEvictionListener(std::function<void(const K &, const V &)> listener) {
+    _listener = std::move(listener);
+}
+
+template <typename K, typename V, typename H, typename Policy>
+V LruHashMap<K, V, H, Policy>::put(const K &key, const V &value) {
+    size_t hashValue = _hasher(key) % _capacity;
+    HashMapEntryLRU<K, V> *entry = this->find(hashValue, key);
+
+    if (entry != nullptr) {
+        V rtnValue = entry->getValue();
+        _weight -= entry->getWeight();
+        entry->setValue(value);
+        entry->setWeight(this->weigh(key, value));
+        _weight += entry->getWeight();
+
+        this->touch(entry);
+        this->evict();
+        return rtnValue;
+    }
+
+    entry = new HashMapEntryLRU<K, V>(key, value, this->weigh(key, value));
+    entry->setNext(_buckets[hashValue]);
+    _buckets[hashValue] = entry;
+    this->link(entry);
+
+    _size++;
+    _weight += entry->getWeight();
+    if (this->threshold() < _size) this->rehash();
+
+    this->evict();
+    return V();
+}
+
+template <typename K, typename V, typename H, typename Policy>
+V LruHashMap<K, V, H, Policy>::get(const K &key) {
+    HashMapEntryLRU<K, V> *entry = this->find(_hasher(key) % _capacity, key);
+    if (entry == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    this->touch(entry);
+    return entry->getValue();
+}
+
+template <typename K, typename V, typename H, typename Policy>
+V LruHashMap<K, V, H, Policy>::remove(const K &key) {
+    size_t hashValue = _hasher(key) % _capacity;
+    HashMapEntryLRU<K, V> *entry = this->find(hashValue, key);
+    if (entry == nullptr) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    V rtnValue = entry->getValue();
+    this->detach(hashValue, entry);
+    this->unlink(entry);
+
+    _size--;
+    _weight -= entry->getWeight();
+    delete entry;
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+bool LruHashMap<K, V, H, Policy>::containsKey(const K &key) {
+    return this->find(_hasher(key) % _capacity, key) != nullptr;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+bool LruHashMap<K, V, H, Policy>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::clear() {
+    HashMapEntryLRU<K, V> *current = _newest;
+    while (current != nullptr) {
+        HashMapEntryLRU<K, V> *helper = current;
+        current = current->getOlder();
+        delete helper;
+    }
+
+    for (size_t i = 0; i < _capacity; i++) _buckets[i] = nullptr;
+    _newest = nullptr;
+    _oldest = nullptr;
+    _size = 0;
+    _weight = 0;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename V, typename H, typename Policy>
+size_t LruHashMap<K, V, H, Policy>::weigh(const K &key, const V &value) {
+    return _weigher ? _weigher(key, value) : 1;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+HashMapEntryLRU<K, V> *LruHashMap<K, V, H, Policy>::find(size_t hashValue, const K &key) {
+    HashMapEntryLRU<K, V> *entry = _buckets[hashValue];
+    while (entry != nullptr && entry->getKey() != key) entry = static_cast<HashMapEntryLRU<K, V> *>(entry->getNext());
+    return entry;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::link(HashMapEntryLRU<K, V> *entry) {
+    entry->setNewer(nullptr);
+    entry->setOlder(_newest);
+    if (_newest != nullptr) _newest->setNewer(entry);
+    else _oldest = entry;
+    _newest = entry;
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::unlink(HashMapEntryLRU<K, V> *entry) {
+    if (entry->getNewer() != nullptr) entry->getNewer()->setOlder(entry->getOlder());
+    else _newest = entry->getOlder();
+
+    if (entry->getOlder() != nullptr) entry->getOlder()->setNewer(entry->getNewer());
+    else _oldest = entry->getNewer();
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::touch(HashMapEntryLRU<K, V> *entry) {
+    if constexpr (Policy::touchOnRead) {
+        if (entry == _newest) return;
+        this->unlink(entry);
+        this->link(entry);
+    } else {
+        entry->setReferenced(true);
+    }
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::detach(size_t hashValue, HashMapEntryLRU<K, V> *entry) {
+    if (_buckets[hashValue] == entry) {
+        _buckets[hashValue] = static_cast<HashMapEntryLRU<K, V> *>(entry->getNext());
+        return;
+    }
+
+    HashMapEntryLL<K, V> *prev = _buckets[hashValue];
+    while (prev->getNext() != entry) prev = prev->getNext();
+    prev->setNext(entry->getNext());
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::evict() {
+    while (_weight > _maxWeight && _oldest != nullptr) {
+        HashMapEntryLRU<K, V> *victim = _oldest;
+
+        // CLOCK hand: referenced entries lose their bit and go around once more instead of being evicted
+        if constexpr (!Policy::touchOnRead) {
+            if (victim->isReferenced()) {
+                victim->setReferenced(false);
+                this->unlink(victim);
+                this->link(victim);
+                continue;
+            }
+        }
+
+        this->detach(_hasher(victim->getKey()) % _capacity, victim);
+        this->unlink(victim);
+        _size--;
+        _weight -= victim->getWeight();
+
+        if (_listener) _listener(victim->getKey(), victim->getValue());
+        delete victim;
+    }
+}
+
+template <typename K, typename V, typename H, typename Policy>
+void LruHashMap<K, V, H, Policy>::rehash() {
+    size_t prevCapacity = _capacity; _capacity *= 2;
+    HashMapEntryLRU<K, V> **temp = _buckets;
+    _buckets = new HashMapEntryLRU<K, V> *[_capacity]();
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        HashMapEntryLRU<K, V> *current = temp[i];
+        while (current != nullptr) {
+            auto *next = static_cast<HashMapEntryLRU<K, V> *>(current->getNext());
+            size_t hashValue = _hasher(current->getKey()) % _capacity;
+
+            current->setNext(_buckets[hashValue]);
+            _buckets[hashValue] = current;
+            current = next;
+        }
+    }
+
+    delete []temp;
+}
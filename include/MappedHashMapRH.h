@@ -0,0 +1,418 @@
+#pragma once
+
+#include "HashMapEntryMapped.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Robin hood map whose slot array lives in a shared mapping of a file, so tables larger than memory are paged in and
+// out by the OS and a map reopened from the same file is usable immediately. Keys and values are stored by value and
+// the hasher has to give the same hashes in every process that opens the file.
+template <typename K, typename V, typename H = std::hash<K>>
+class MappedHashMapRH {
+    static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+                  "MappedHashMapRH stores keys and values in a file, so they have to be trivially copyable");
+
+private:
+    struct Header {
+        uint64_t magic;
+        uint64_t keySize;
+        uint64_t valueSize;
+        uint64_t capacity;
+        uint64_t size;
+        float loadFactor;
+    };
+
+    std::string _path;
+    int _fd;
+    char *_memory;
+    size_t _length;
+    Header *_header;
+    HashMapEntryMapped<K, V> *_buckets;
+    H _hasher;
+
+    static size_t fileLength(size_t capacity);
+    static char *create(const std::string &path, size_t capacity, float loadFactor, int &fd);
+    static char *map(int fd, size_t length, const std::string &path);
+    void open(size_t length);
+    void attach(int fd, char *memory, size_t length);
+    void unmap();
+    void syncDirectory();
+
+    // Returned by search for keys the map does not hold, no slot index reaches it
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+
+    size_t threshold();
+    size_t search(const K &key);
+    void place(HashMapEntryMapped<K, V> *buckets, size_t capacity, HashMapEntryMapped<K, V> entry);
+    void rehash();
+
+public:
+    explicit MappedHashMapRH(const std::string &path);
+    MappedHashMapRH(const std::string &path, size_t capacity);
+    MappedHashMapRH(const std::string &path, size_t capacity, float loadFactor);
+    ~MappedHashMapRH();
+
+    MappedHashMapRH(const MappedHashMapRH &) = delete;
+    MappedHashMapRH &operator=(const MappedHashMapRH &) = delete;
+    MappedHashMapRH(MappedHashMapRH &&other) noexcept;
+    MappedHashMapRH &operator=(MappedHashMapRH &&other) noexcept;
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void sync();
+    void clear();
+    void swap(MappedHashMapRH &other) noexcept;
+    MappedHashMapRH clone(const std::string &path);
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H>::MappedHashMapRH(const std::string &path)
+        : MappedHashMapRH(path, constants::DEFAULT_CAPACITY, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H>::MappedHashMapRH(const std::string &path, size_t capacity)
+        : MappedHashMapRH(path, capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+// Capacity and load factor only apply when the file is created, an existing file keeps its own
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H>::MappedHashMapRH(const std::string &path, size_t capacity, float loadFactor)
+        : _path(path), _fd(-1), _memory(nullptr), _length(0), _header(nullptr), _buckets(nullptr) {
+    struct stat status{};
+    if (::stat(path.c_str(), &status) == 0 && status.st_size > 0) {
+        this->open(static_cast<size_t>(status.st_size));
+    } else {
+        int fd;
+        char *memory = create(path, capacity, loadFactor, fd);
+        this->attach(fd, memory, fileLength(capacity));
+    }
+}
+
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H>::~MappedHashMapRH() {
+    this->unmap();
+    if (_fd != -1) ::close(_fd);
+}
+
+// The moved-from map no longer owns a file, it can only be assigned to or destroyed
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H>::MappedHashMapRH(MappedHashMapRH<K, V, H> &&other) noexcept
+        : _path(std::move(other._path)), _fd(other._fd), _memory(other._memory), _length(other._length),
+          _header(other._header), _buckets(other._buckets), _hasher(std::move(other._hasher)) {
+    other._fd = -1;
+    other._memory = nullptr;
+    other._length = 0;
+    other._header = nullptr;
+    other._buckets = nullptr;
+}
+
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H> &MappedHashMapRH<K, V, H>::operator=(MappedHashMapRH<K, V, H> &&other) noexcept {
+    MappedHashMapRH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::swap(MappedHashMapRH<K, V, H> &other) noexcept {
+    std::swap(_path, other._path);
+    std::swap(_fd, other._fd);
+    std::swap(_memory, other._memory);
+    std::swap(_length, other._length);
+    std::swap(_header, other._header);
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+}
+
+// Writes the slots as they are into a new file at path, which replaces any file already there
+template <typename K, typename V, typename H>
+MappedHashMapRH<K, V, H> MappedHashMapRH<K, V, H>::clone(const std::string &path) {
+    if (path == _path) throw std::invalid_argument("Cannot clone " + _path + " onto itself");
+    std::remove(path.c_str());
+
+    MappedHashMapRH copy(path, _header->capacity, _header->loadFactor);
+    copy._hasher = _hasher;
+    allocation::copyBuckets(copy._buckets, _buckets, _header->capacity);
+    copy._header->size = _header->size;
+    return copy;
+}
+
+template <typename K, typename V, typename H>
+size_t MappedHashMapRH<K, V, H>::getCapacity() { return _header->capacity; }
+
+template <typename K, typename V, typename H>
+size_t MappedHashMapRH<K, V, H>::getSize() { return _header->size; }
+
+template <typename K, typename V, typename H>
+float MappedHashMapRH<K, V, H>::getLoadFactor() { return _header->loadFactor; }
+
+template <typename K, typename V, typename H>
+V MappedHashMapRH<K, V, H>::put(const K &key, const V &value) {
+    size_t capacity = _header->capacity;
+    size_t hashValue = _hasher(key) % capacity;
+    HashMapEntryMapped<K, V> entry(key, value);
+
+    for (size_t itr = 0; itr < capacity; itr++) {
+        HashMapEntryMapped<K, V> &current = _buckets[(hashValue + itr) % capacity];
+
+        if (!current.isOccupied()) {
+            current = entry;
+            _header->size++;
+
+            if (this->threshold() < _header->size) this->rehash();
+            return V();
+        }
+
+        if (current.getKey() == key) {
+            V rtnValue = current.getValue();
+            current.setValue(value);
+            return rtnValue;
+        }
+
+        if (current.getPSL() < entry.getPSL()) std::swap(current, entry);
+        entry.setPSL(entry.getPSL() + 1);
+    }
+    return V();
+}
+
+template <typename K, typename V, typename H>
+V MappedHashMapRH<K, V, H>::get(const K &key) {
+    size_t idx = this->search(key);
+
+    if (idx != NOT_FOUND) return _buckets[idx].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H>
+V MappedHashMapRH<K, V, H>::remove(const K &key) {
+    size_t index = this->search(key);
+    if (index == NOT_FOUND) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    size_t capacity = _header->capacity;
+    V rtnValue = _buckets[index].getValue();
+    _buckets[index] = HashMapEntryMapped<K, V>();
+    _header->size--;
+
+    size_t next = (index + 1) % capacity;
+    while (_buckets[next].isOccupied() && _buckets[next].getPSL() > 0) {
+        _buckets[next].setPSL(_buckets[next].getPSL() - 1);
+        _buckets[index] = _buckets[next];
+        _buckets[next] = HashMapEntryMapped<K, V>();
+
+        index = next;
+        next = (index + 1) % capacity;
+    }
+
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H>
+bool MappedHashMapRH<K, V, H>::containsKey(const K &key) { return this->search(key) != NOT_FOUND; }
+
+template <typename K, typename V, typename H>
+bool MappedHashMapRH<K, V, H>::isEmpty() { return _header->size == 0; }
+
+// Checkpoint: returns once every modified page, header included, is written back to the file
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::sync() {
+    if (::msync(_memory, _length, MS_SYNC) == -1) {
+        throw std::system_error(errno, std::generic_category(), "Cannot sync " + _path);
+    }
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::clear() {
+    std::memset(static_cast<void *>(_buckets), 0, _header->capacity * sizeof(HashMapEntryMapped<K, V>));
+    _header->size = 0;
+}
+
+template <typename K, typename V, typename H>
+size_t MappedHashMapRH<K, V, H>::fileLength(size_t capacity) {
+    return constants::MAPPED_HEADER_SIZE + capacity * sizeof(HashMapEntryMapped<K, V>);
+}
+
+// Creates a file at path holding an empty table and maps it, on failure neither the file descriptor nor the mapping
+// is left open
+template <typename K, typename V, typename H>
+char *MappedHashMapRH<K, V, H>::create(const std::string &path, size_t capacity, float loadFactor, int &fd) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "Cannot create " + path);
+
+    // Extending the file leaves it sparse and zeroed, so every slot starts out free without being written
+    size_t length = fileLength(capacity);
+    if (::ftruncate(fd, static_cast<off_t>(length)) == -1) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot resize " + path);
+    }
+
+    char *memory = map(fd, length, path);
+    auto *header = reinterpret_cast<Header *>(memory);
+    *header = Header{constants::MAPPED_MAGIC, sizeof(K), sizeof(V), capacity, 0, loadFactor};
+    return memory;
+}
+
+// Maps the whole file, closing the file descriptor if that fails
+template <typename K, typename V, typename H>
+char *MappedHashMapRH<K, V, H>::map(int fd, size_t length, const std::string &path) {
+    void *memory = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (memory == MAP_FAILED) {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+    }
+
+    // Probes land on unrelated pages, reading ahead would only evict pages which are still needed
+    ::madvise(memory, length, MADV_RANDOM);
+    return static_cast<char *>(memory);
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::open(size_t length) {
+    if (length < constants::MAPPED_HEADER_SIZE) throw std::invalid_argument(_path + " is not a mapped hash map");
+
+    int fd = ::open(_path.c_str(), O_RDWR);
+    if (fd == -1) throw std::system_error(errno, std::generic_category(), "Cannot open " + _path);
+    char *memory = map(fd, length, _path);
+
+    const Header *header = reinterpret_cast<const Header *>(memory);
+    if (header->magic != constants::MAPPED_MAGIC || header->keySize != sizeof(K) ||
+        header->valueSize != sizeof(V) || fileLength(header->capacity) != length) {
+        ::munmap(memory, length);
+        ::close(fd);
+        throw std::invalid_argument(_path + " holds a map of different layout");
+    }
+    this->attach(fd, memory, length);
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::attach(int fd, char *memory, size_t length) {
+    _fd = fd;
+    _memory = memory;
+    _length = length;
+    _header = reinterpret_cast<Header *>(_memory);
+    _buckets = reinterpret_cast<HashMapEntryMapped<K, V> *>(_memory + constants::MAPPED_HEADER_SIZE);
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::unmap() {
+    if (_memory != nullptr) ::munmap(_memory, _length);
+    _memory = nullptr;
+    _header = nullptr;
+    _buckets = nullptr;
+}
+
+template <typename K, typename V, typename H>
+size_t MappedHashMapRH<K, V, H>::threshold() {
+    return static_cast<size_t>(_header->capacity * _header->loadFactor);
+}
+
+template <typename K, typename V, typename H>
+size_t MappedHashMapRH<K, V, H>::search(const K &key) {
+    if (this->isEmpty()) return NOT_FOUND;
+    size_t capacity = _header->capacity;
+    size_t hashValue = _hasher(key) % capacity;
+
+    for (size_t itr = 0; itr < capacity; itr++) {
+        size_t idx = (hashValue + itr) % capacity;
+        const HashMapEntryMapped<K, V> &current = _buckets[idx];
+
+        if (!current.isOccupied()) break;
+        if (itr > current.getPSL()) break;
+        if (current.getKey() == key) return idx;
+    }
+    return NOT_FOUND;
+}
+
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::place(HashMapEntryMapped<K, V> *buckets, size_t capacity,
+                                     HashMapEntryMapped<K, V> entry) {
+    size_t hashValue = _hasher(entry.getKey()) % capacity;
+    entry.setPSL(0);
+
+    for (size_t itr = 0; itr < capacity; itr++) {
+        HashMapEntryMapped<K, V> &current = buckets[(hashValue + itr) % capacity];
+        if (!current.isOccupied()) {
+            current = entry;
+            return;
+        }
+
+        if (current.getPSL() < entry.getPSL()) std::swap(current, entry);
+        entry.setPSL(entry.getPSL() + 1);
+    }
+}
+
+// Makes the rename of a rehashed file durable, without it the directory could still name the old file after a crash
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::syncDirectory() {
+    size_t slash = _path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : _path.substr(0, slash == 0 ? 1 : slash);
+
+    int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+    if (fd == -1 || ::fsync(fd) == -1) {
+        int error = errno;
+        if (fd != -1) ::close(fd);
+        throw std::system_error(error, std::generic_category(), "Cannot sync directory of " + _path);
+    }
+    ::close(fd);
+}
+
+// The larger table is built and synced in a separate file which then replaces the old one, so the file on disk holds
+// a complete table at every moment. The map switches to the new file only once it is in place; until then a failure
+// removes the new file and leaves the map on the old one
+template <typename K, typename V, typename H>
+void MappedHashMapRH<K, V, H>::rehash() {
+    std::string rehashPath = _path + ".rehash";
+    size_t capacity = _header->capacity * 2;
+    size_t length = fileLength(capacity);
+
+    int fd;
+    char *memory;
+    try {
+        memory = create(rehashPath, capacity, _header->loadFactor, fd);
+    } catch (...) {
+        ::unlink(rehashPath.c_str());
+        throw;
+    }
+
+    auto *buckets = reinterpret_cast<HashMapEntryMapped<K, V> *>(memory + constants::MAPPED_HEADER_SIZE);
+    for (size_t i = 0; i < _header->capacity; i++) {
+        if (_buckets[i].isOccupied()) this->place(buckets, capacity, _buckets[i]);
+    }
+    reinterpret_cast<Header *>(memory)->size = _header->size;
+
+    if (::msync(memory, length, MS_SYNC) == -1 || ::fsync(fd) == -1 ||
+        std::rename(rehashPath.c_str(), _path.c_str()) == -1) {
+        int error = errno;
+        ::munmap(memory, length);
+        ::close(fd);
+        ::unlink(rehashPath.c_str());
+        throw std::system_error(error, std::generic_category(), "Cannot replace " + _path);
+    }
+
+    this->unmap();
+    ::close(_fd);
+    this->attach(fd, memory, length);
+    this->syncDirectory();
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <limits>
+
+// Observer policies for HashMapLL, HashMapDH and HashMapRH. A map holds one observer and calls it on:
+//   onLongProbe(steps)             - a lookup or insertion walked more than longProbe entries
+//   onRehashStart(prev, capacity)  - the bucket array is about to grow from prev to capacity
+//   onRehashEnd(prev, capacity)    - every entry has been moved to the new array
+//   onTombstoneReuse(index)        - HashMapDH stored a new entry in a slot freed by a removal
+//   onRobinHoodSwap(psl)           - HashMapRH displaced an entry with the given PSL while inserting
+// NoObserver has empty inline callbacks and a longProbe no probe can exceed, so observed maps compile to the same
+// code as unobserved ones. The maps hold their policies as [[no_unique_address]] members, so it takes no space either.
+
+struct NoObserver {
+    static constexpr size_t longProbe = std::numeric_limits<size_t>::max();
+
+    void onLongProbe(size_t) {}
+    void onRehashStart(size_t, size_t) {}
+    void onRehashEnd(size_t, size_t) {}
+    void onTombstoneReuse(size_t) {}
+    void onRobinHoodSwap(size_t) {}
+};
+
+// Counts every event and keeps the last Events of them in a ring buffer, together with the time spent rehashing
+template <size_t LongProbe = 16, size_t Events = 256>
+class CountingObserver {
+public:
+    static constexpr size_t longProbe = LongProbe;
+
+    enum class Kind { LONG_PROBE, REHASH, TOMBSTONE_REUSE, ROBIN_HOOD_SWAP };
+
+    struct Event {
+        Kind kind;
+        size_t first;
+        size_t second;
+    };
+
+private:
+    std::array<Event, Events> _events{};
+    size_t _recorded = 0;
+
+    size_t _longProbes = 0;
+    size_t _longestProbe = 0;
+    size_t _rehashes = 0;
+    size_t _tombstoneReuses = 0;
+    size_t _robinHoodSwaps = 0;
+    std::chrono::steady_clock::time_point _rehashStart;
+    std::chrono::nanoseconds _rehashTime{0};
+
+    void record(Kind kind, size_t first, size_t second) { _events[_recorded++ % Events] = Event{kind, first, second}; }
+
+public:
+    void onLongProbe(size_t steps) {
+        _longProbes++;
+        if (steps > _longestProbe) _longestProbe = steps;
+        this->record(Kind::LONG_PROBE, steps, 0);
+    }
+
+    void onRehashStart(size_t, size_t) { _rehashStart = std::chrono::steady_clock::now(); }
+
+    void onRehashEnd(size_t prevCapacity, size_t capacity) {
+        _rehashes++;
+        _rehashTime += std::chrono::steady_clock::now() - _rehashStart;
+        this->record(Kind::REHASH, prevCapacity, capacity);
+    }
+
+    void onTombstoneReuse(size_t index) {
+        _tombstoneReuses++;
+        this->record(Kind::TOMBSTONE_REUSE, index, 0);
+    }
+
+    void onRobinHoodSwap(size_t psl) {
+        _robinHoodSwaps++;
+        this->record(Kind::ROBIN_HOOD_SWAP, psl, 0);
+    }
+
+    size_t getLongProbes() const { return _longProbes; }
+    size_t getLongestProbe() const { return _longestProbe; }
+    size_t getRehashes() const { return _rehashes; }
+    size_t getTombstoneReuses() const { return _tombstoneReuses; }
+    size_t getRobinHoodSwaps() const { return _robinHoodSwaps; }
+    std::chrono::nanoseconds getRehashTime() const { return _rehashTime; }
+
+    // Visits the retained events from the oldest to the newest
+    template <typename F>
+    void forEachEvent(F fn) const {
+        size_t begin = _recorded > Events ? _recorded - Events : 0;
+        for (size_t i = begin; i < _recorded; i++) fn(_events[i % Events]);
+    }
+
+    void reset() { *this = CountingObserver(); }
+};
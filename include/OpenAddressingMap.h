@@ -0,0 +1,307 @@
+#pragma once
+
+#include "HashMapEntryOA.h"
+#include "Allocation.h"
+#include "ProbePolicies.h"
+#include "DeletionPolicies.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <utility>
+
+template <typename K, typename V, typename H = std::hash<K>, typename Probe = LinearProbing,
+          typename Delete = TombstoneDeletion>
+class OpenAddressingMap {
+private:
+    static_assert(Delete::tombstones || Probe::contiguous,
+                  "Backward shift deletion requires a contiguous probe sequence");
+
+    HashMapEntryOA<K, V> *_buckets;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+    size_t _used;   // occupied buckets including tombstones
+
+    size_t threshold();
+    int search(size_t hash, const K &key);
+    size_t insert(size_t hash, const K &key, const V &value);
+    void erase(size_t idx);
+    void rehash();
+
+public:
+    OpenAddressingMap();
+    explicit OpenAddressingMap(size_t capacity);
+    OpenAddressingMap(size_t capacity, float loadFactor);
+    ~OpenAddressingMap();
+
+    OpenAddressingMap(const OpenAddressingMap &) = delete;
+    OpenAddressingMap &operator=(const OpenAddressingMap &) = delete;
+    OpenAddressingMap(OpenAddressingMap &&other);
+    OpenAddressingMap &operator=(OpenAddressingMap &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V *find(const K &key);
+    V remove(const K &key);
+    template <typename F> V &upsert(const K &key, F fn);
+
+    void clear();
+    void swap(OpenAddressingMap &other) noexcept;
+    OpenAddressingMap clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete>::OpenAddressingMap()
+        : _capacity(Probe::capacity(constants::DEFAULT_CAPACITY)), _loadFactor(constants::DEFAULT_LOAD_FACTOR),
+          _size(0), _used(0) {
+    _buckets = new HashMapEntryOA<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete>::OpenAddressingMap(size_t capacity)
+        : _capacity(Probe::capacity(capacity)), _loadFactor(constants::DEFAULT_LOAD_FACTOR), _size(0), _used(0) {
+    _buckets = new HashMapEntryOA<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete>::OpenAddressingMap(size_t capacity, float loadFactor)
+        : _capacity(Probe::capacity(capacity)), _loadFactor(loadFactor), _size(0), _used(0) {
+    _buckets = new HashMapEntryOA<K, V>[_capacity]();
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete>::~OpenAddressingMap() {
+    delete []_buckets;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete>::OpenAddressingMap(OpenAddressingMap<K, V, H, Probe, Delete> &&other) : OpenAddressingMap() { this->swap(other); }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete> &OpenAddressingMap<K, V, H, Probe, Delete>::operator=(OpenAddressingMap<K, V, H, Probe, Delete> &&other) {
+    OpenAddressingMap(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+void OpenAddressingMap<K, V, H, Probe, Delete>::swap(OpenAddressingMap<K, V, H, Probe, Delete> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+    std::swap(_used, other._used);
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+OpenAddressingMap<K, V, H, Probe, Delete> OpenAddressingMap<K, V, H, Probe, Delete>::clone() {
+    OpenAddressingMap copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    allocation::copyBuckets(copy._buckets, _buckets, _capacity);
+
+    copy._size = _size;
+    copy._used = _used;
+    return copy;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+size_t OpenAddressingMap<K, V, H, Probe, Delete>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+size_t OpenAddressingMap<K, V, H, Probe, Delete>::getSize() { return _size; }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+float OpenAddressingMap<K, V, H, Probe, Delete>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+int OpenAddressingMap<K, V, H, Probe, Delete>::search(size_t hash, const K &key) {
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = Probe::index(hash, itr, _capacity);
+        HashMapEntryOA<K, V> &current = _buckets[idx];
+
+        if (current.getStatus() == 'f') break;
+        if constexpr (Probe::robinHood) {
+            if (current.getPSL() < itr) break;
+        }
+        if (current.getStatus() == 'o' && current.getHash() == hash && current.getKey() == key) {
+            return static_cast<int>(idx);
+        }
+    }
+    return -1;
+}
+
+// Returns the bucket the inserted key ended up in, which Robin Hood swaps may leave before the end of the probe
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+size_t OpenAddressingMap<K, V, H, Probe, Delete>::insert(size_t hash, const K &key, const V &value) {
+    HashMapEntryOA<K, V> entry(hash, key, value);
+    size_t landed = _capacity;
+
+    while (true) {
+        size_t idx = Probe::index(entry.getHash(), entry.getPSL(), _capacity);
+        HashMapEntryOA<K, V> &current = _buckets[idx];
+
+        if (current.getStatus() == 'f') {
+            current = entry;
+            _used++;
+            return landed == _capacity ? idx : landed;
+        }
+
+        if (current.getStatus() == 'a') {
+            // Tombstones keep their PSL, so Robin Hood lookups stay correct only if the new PSL is not smaller
+            if (!Probe::robinHood || current.getPSL() < entry.getPSL()) {
+                current = entry;
+                return landed == _capacity ? idx : landed;
+            }
+        } else if (Probe::robinHood && current.getPSL() < entry.getPSL()) {
+            std::swap(current, entry);
+            if (landed == _capacity) landed = idx;
+        }
+
+        entry.setPSL(entry.getPSL() + 1);
+    }
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+void OpenAddressingMap<K, V, H, Probe, Delete>::erase(size_t idx) {
+    _size--;
+
+    if constexpr (Delete::tombstones) {
+        _buckets[idx].setStatus('a');
+        _buckets[idx].setKey(K());
+        _buckets[idx].setValue(V());
+    } else {
+        // Shifting back every following entry that may legally occupy the hole
+        size_t hole = idx;
+        size_t distance = 1;
+        _buckets[hole] = HashMapEntryOA<K, V>();
+        _used--;
+
+        for (size_t next = (hole + 1) % _capacity; distance < _capacity; next = (next + 1) % _capacity) {
+            HashMapEntryOA<K, V> &current = _buckets[next];
+            if (current.getStatus() == 'f') break;
+
+            if (current.getPSL() >= distance) {
+                current.setPSL(current.getPSL() - distance);
+                _buckets[hole] = current;
+                current = HashMapEntryOA<K, V>();
+
+                hole = next;
+                distance = 1;
+                continue;
+            }
+
+            if constexpr (Probe::robinHood) break;
+            distance++;
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+V OpenAddressingMap<K, V, H, Probe, Delete>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    int idx = this->search(hash, key);
+
+    if (idx != -1) {
+        V rtnValue = _buckets[idx].getValue();
+        _buckets[idx].setValue(value);
+        return rtnValue;
+    }
+
+    this->insert(hash, key, value);
+    _size++;
+
+    if (this->threshold() < _used || _used == _capacity) this->rehash();
+    return V();
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+V OpenAddressingMap<K, V, H, Probe, Delete>::get(const K &key) {
+    int idx = this->search(_hasher(key), key);
+
+    if (idx != -1) return _buckets[idx].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+// Lookup for callers expecting misses, the pointer stays valid until the map is modified again
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+V *OpenAddressingMap<K, V, H, Probe, Delete>::find(const K &key) {
+    int idx = this->search(_hasher(key), key);
+    return idx == -1 ? nullptr : &_buckets[idx].getValueRef();
+}
+
+// Missing keys are inserted with a default value passed to fn, probing again only if the insertion rehashed the table
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+template <typename F>
+V &OpenAddressingMap<K, V, H, Probe, Delete>::upsert(const K &key, F fn) {
+    size_t hash = _hasher(key);
+    int idx = this->search(hash, key);
+    if (idx != -1) {
+        fn(_buckets[idx].getValueRef());
+        return _buckets[idx].getValueRef();
+    }
+
+    size_t landed = this->insert(hash, key, V());
+    _size++;
+    if (this->threshold() < _used || _used == _capacity) {
+        this->rehash();
+        landed = static_cast<size_t>(this->search(hash, key));
+    }
+
+    fn(_buckets[landed].getValueRef());
+    return _buckets[landed].getValueRef();
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+V OpenAddressingMap<K, V, H, Probe, Delete>::remove(const K &key) {
+    int idx = this->search(_hasher(key), key);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    V rtnValue = _buckets[idx].getValue();
+    this->erase(idx);
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+bool OpenAddressingMap<K, V, H, Probe, Delete>::containsKey(const K &key) {
+    if (this->search(_hasher(key), key) == -1) return false;
+    return true;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+bool OpenAddressingMap<K, V, H, Probe, Delete>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+void OpenAddressingMap<K, V, H, Probe, Delete>::clear() {
+    for (size_t i = 0; i < _capacity; i++) {
+        _buckets[i] = HashMapEntryOA<K, V>();
+    }
+    _size = 0;
+    _used = 0;
+}
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+size_t OpenAddressingMap<K, V, H, Probe, Delete>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename V, typename H, typename Probe, typename Delete>
+void OpenAddressingMap<K, V, H, Probe, Delete>::rehash() {
+    size_t prevCapacity = _capacity;
+    HashMapEntryOA<K, V> *temp = _buckets;
+
+    // Tables filled mostly with tombstones are only cleaned up, not grown
+    if (2 * _size > this->threshold()) _capacity = Probe::capacity(_capacity * 2);
+    _buckets = new HashMapEntryOA<K, V>[_capacity]();
+    _used = 0;
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        if (temp[i].getStatus() == 'o') this->insert(temp[i].getHash(), temp[i].getKey(), temp[i].getValue());
+    }
+    delete []temp;
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include "HashMapEntryOrdered.h"
+#include "Constants.h"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// Insertion-ordered map with entries appended to a dense array and a robin hood index of entry positions. Index slots
+// are 1, 2, 4 or 8 bytes wide, the narrowest that fits the number of entries the table may hold, so the part that
+// gets probed is a fraction of a slot array storing entries by value. Iteration runs over the dense array in the
+// order keys were first inserted, and rehashing only rebuilds the index from the hashes kept in the entries.
+template <typename K, typename V, typename H = std::hash<K>>
+class OrderedHashMapRH {
+private:
+    std::vector<HashMapEntryOrdered<K, V>> _entries;
+    uint8_t *_index;
+    size_t _width;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    static size_t widthFor(size_t entries);
+    size_t slot(size_t pos) const;
+    void setSlot(size_t pos, size_t value);
+    size_t pslOf(size_t pos, size_t value) const;
+
+    size_t threshold();
+    int search(const K &key, size_t hash);
+    void place(size_t pos, size_t psl, size_t value);
+    void rehash(size_t capacity);
+
+public:
+    OrderedHashMapRH();
+    explicit OrderedHashMapRH(size_t capacity);
+    OrderedHashMapRH(size_t capacity, float loadFactor);
+    ~OrderedHashMapRH();
+
+    OrderedHashMapRH(const OrderedHashMapRH &) = delete;
+    OrderedHashMapRH &operator=(const OrderedHashMapRH &) = delete;
+    OrderedHashMapRH(OrderedHashMapRH &&other);
+    OrderedHashMapRH &operator=(OrderedHashMapRH &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+    size_t getIndexWidth();
+    size_t getIndexBytes();
+    size_t getEntryBytes();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+    template <typename F> void forEach(F fn);
+
+    void clear();
+    void swap(OrderedHashMapRH &other) noexcept;
+    OrderedHashMapRH clone();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H>::OrderedHashMapRH() : OrderedHashMapRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H>::OrderedHashMapRH(size_t capacity)
+        : OrderedHashMapRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H>::OrderedHashMapRH(size_t capacity, float loadFactor)
+        : _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _width = widthFor(this->threshold() + 1);
+    _index = new uint8_t[_capacity * _width]();
+    _entries.reserve(this->threshold() + 1);
+}
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H>::~OrderedHashMapRH() {
+    delete []_index;
+}
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H>::OrderedHashMapRH(OrderedHashMapRH<K, V, H> &&other) : OrderedHashMapRH() {
+    this->swap(other);
+}
+
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H> &OrderedHashMapRH<K, V, H>::operator=(OrderedHashMapRH<K, V, H> &&other) {
+    OrderedHashMapRH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename K, typename V, typename H>
+void OrderedHashMapRH<K, V, H>::swap(OrderedHashMapRH<K, V, H> &other) noexcept {
+    std::swap(_entries, other._entries);
+    std::swap(_index, other._index);
+    std::swap(_width, other._width);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+// The index holds positions only, so the copy gets the same bytes and entries are copied in their order
+template <typename K, typename V, typename H>
+OrderedHashMapRH<K, V, H> OrderedHashMapRH<K, V, H>::clone() {
+    OrderedHashMapRH copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    copy._entries = _entries;
+    std::memcpy(copy._index, _index, _capacity * _width);
+
+    copy._size = _size;
+    return copy;
+}
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::getCapacity() { return _capacity; }
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::getSize() { return _size; }
+
+template <typename K, typename V, typename H>
+float OrderedHashMapRH<K, V, H>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::getIndexWidth() { return _width; }
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::getIndexBytes() { return _capacity * _width; }
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::getEntryBytes() { return _entries.capacity() * sizeof(HashMapEntryOrdered<K, V>); }
+
+template <typename K, typename V, typename H>
+V OrderedHashMapRH<K, V, H>::put(const K &key, const V &value) {
+    size_t hash = _hasher(key);
+    size_t home = hash % _capacity;
+
+    // The probe stops at a free slot or at the first slot poorer than itself, which is where the key goes if missing
+    size_t psl = 0;
+    size_t pos = home;
+    for (; psl < _capacity; psl++) {
+        pos = (home + psl) % _capacity;
+        size_t current = this->slot(pos);
+        if (current == 0 || this->pslOf(pos, current) < psl) break;
+
+        HashMapEntryOrdered<K, V> &entry = _entries[current - 1];
+        if (entry.getHash() == hash && entry.getKeyRef() == key) {
+            V rtnValue = entry.getValue();
+            entry.setValue(value);
+            return rtnValue;
+        }
+    }
+
+    _entries.emplace_back(hash, key, value);
+    this->place(pos, psl, _entries.size());
+    _size++;
+
+    // Dead entries count against the threshold as well, when they make up most of it compacting is enough
+    if (this->threshold() < _entries.size()) this->rehash(_size > this->threshold() / 2 ? _capacity * 2 : _capacity);
+    return V();
+}
+
+template <typename K, typename V, typename H>
+V OrderedHashMapRH<K, V, H>::get(const K &key) {
+    int pos = this->search(key, _hasher(key));
+
+    if (pos != -1) return _entries[this->slot(pos) - 1].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H>
+V OrderedHashMapRH<K, V, H>::remove(const K &key) {
+    int found = this->search(key, _hasher(key));
+    if (found == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    size_t pos = found;
+    size_t idx = this->slot(pos) - 1;
+    V rtnValue = _entries[idx].getValue();
+    _entries[idx] = HashMapEntryOrdered<K, V>();
+    _size--;
+
+    // Dead entries at the end of the array are dropped right away, so removing the newest keys reclaims their room
+    while (!_entries.empty() && !_entries.back().isLive()) _entries.pop_back();
+
+    size_t next = (pos + 1) % _capacity;
+    while (this->slot(next) != 0 && this->pslOf(next, this->slot(next)) > 0) {
+        this->setSlot(pos, this->slot(next));
+        pos = next;
+        next = (pos + 1) % _capacity;
+    }
+    this->setSlot(pos, 0);
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H>
+template <typename F>
+void OrderedHashMapRH<K, V, H>::forEach(F fn) {
+    for (HashMapEntryOrdered<K, V> &entry : _entries) {
+        if (entry.isLive()) fn(entry.getKeyRef(), entry.getValueRef());
+    }
+}
+
+template <typename K, typename V, typename H>
+bool OrderedHashMapRH<K, V, H>::containsKey(const K &key) { return this->search(key, _hasher(key)) != -1; }
+
+template <typename K, typename V, typename H>
+bool OrderedHashMapRH<K, V, H>::isEmpty() { return _size == 0; }
+
+template <typename K, typename V, typename H>
+void OrderedHashMapRH<K, V, H>::clear() {
+    _entries.clear();
+    std::memset(_index, 0, _capacity * _width);
+    _size = 0;
+}
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::widthFor(size_t entries) {
+    if (entries < UINT8_MAX) return 1;
+    if (entries < UINT16_MAX) return 2;
+    if (entries < UINT32_MAX) return 4;
+    return 8;
+}
+
+// Slots hold the position of their entry plus one, zero marks a free slot
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::slot(size_t pos) const {
+    const uint8_t *bytes = _index + pos * _width;
+    switch (_width) {
+        case 1: return *bytes;
+        case 2: { uint16_t value; std::memcpy(&value, bytes, 2); return value; }
+        case 4: { uint32_t value; std::memcpy(&value, bytes, 4); return value; }
+        default: { uint64_t value; std::memcpy(&value, bytes, 8); return value; }
+    }
+}
+
+template <typename K, typename V, typename H>
+void OrderedHashMapRH<K, V, H>::setSlot(size_t pos, size_t value) {
+    uint8_t *bytes = _index + pos * _width;
+    switch (_width) {
+        case 1: *bytes = static_cast<uint8_t>(value); break;
+        case 2: { auto narrowed = static_cast<uint16_t>(value); std::memcpy(bytes, &narrowed, 2); break; }
+        case 4: { auto narrowed = static_cast<uint32_t>(value); std::memcpy(bytes, &narrowed, 4); break; }
+        default: { auto narrowed = static_cast<uint64_t>(value); std::memcpy(bytes, &narrowed, 8); break; }
+    }
+}
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::pslOf(size_t pos, size_t value) const {
+    size_t home = _entries[value - 1].getHash() % _capacity;
+    return (pos + _capacity - home) % _capacity;
+}
+
+template <typename K, typename V, typename H>
+size_t OrderedHashMapRH<K, V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename K, typename V, typename H>
+int OrderedHashMapRH<K, V, H>::search(const K &key, size_t hash) {
+    if (this->isEmpty()) return -1;
+    size_t home = hash % _capacity;
+
+    for (size_t psl = 0; psl < _capacity; psl++) {
+        size_t pos = (home + psl) % _capacity;
+        size_t current = this->slot(pos);
+        if (current == 0 || this->pslOf(pos, current) < psl) break;
+
+        const HashMapEntryOrdered<K, V> &entry = _entries[current - 1];
+        if (entry.getHash() == hash && entry.getKeyRef() == key) return static_cast<int>(pos);
+    }
+    return -1;
+}
+
+// Stores the value at pos, where its probe sequence length is psl, displacing richer slots further along
+template <typename K, typename V, typename H>
+void OrderedHashMapRH<K, V, H>::place(size_t pos, size_t psl, size_t value) {
+    while (true) {
+        size_t current = this->slot(pos);
+        if (current == 0) {
+            this->setSlot(pos, value);
+            return;
+        }
+
+        size_t currentPsl = this->pslOf(pos, current);
+        if (currentPsl < psl) {
+            this->setSlot(pos, value);
+            value = current;
+            psl = currentPsl;
+        }
+        pos = (pos + 1) % _capacity;
+        psl++;
+    }
+}
+
+// Dead entries are dropped keeping the order of the live ones, then the index is rebuilt from the kept hashes
+template <typename K, typename V, typename H>
+void OrderedHashMapRH<K, V, H>::rehash(size_t capacity) {
+    size_t live = 0;
+    for (size_t i = 0; i < _entries.size(); i++) {
+        if (!_entries[i].isLive()) continue;
+        if (live != i) _entries[live] = std::move(_entries[i]);
+        live++;
+    }
+    _entries.resize(live);
+
+    delete []_index;
+    _capacity = capacity;
+    _width = widthFor(this->threshold() + 1);
+    _index = new uint8_t[_capacity * _width]();
+
+    for (size_t i = 0; i < _entries.size(); i++) {
+        size_t home = _entries[i].getHash() % _capacity;
+        size_t pos = home;
+        size_t psl = 0;
+        while (this->slot(pos) != 0 && this->pslOf(pos, this->slot(pos)) >= psl) {
+            pos = (pos + 1) % _capacity;
+            psl++;
+        }
+        this->place(pos, psl, i + 1);
+    }
+}
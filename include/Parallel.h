@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Constants.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace parallel {
+    // Number of workers for splitting given amount of buckets, HASHMAPS_THREADS overrides the detected core count
+    inline size_t threadCount(size_t work) {
+#ifdef HASHMAPS_THREADS
+        size_t cores = HASHMAPS_THREADS;
+#else
+        size_t cores = std::thread::hardware_concurrency();
+#endif
+        size_t ranges = work / constants::PARALLEL_MIN_RANGE;
+        return std::max<size_t>(1, std::min(cores, ranges));
+    }
+
+    // Splits [0, count) into given number of consecutive ranges, returning their threads + 1 boundaries
+    inline std::vector<size_t> boundaries(size_t count, size_t threads) {
+        std::vector<size_t> bounds(threads + 1);
+        size_t chunk = (count + threads - 1) / threads;
+        for (size_t t = 0; t <= threads; t++) bounds[t] = std::min(count, t * chunk);
+        return bounds;
+    }
+
+    // Calls fn(bounds[t], bounds[t + 1], t) for every range, each one on its own thread
+    template <typename F>
+    void forBoundaries(const std::vector<size_t> &bounds, F fn) {
+        size_t threads = bounds.size() - 1;
+        if (threads <= 1) {
+            fn(bounds[0], bounds[1], 0);
+            return;
+        }
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; t++) workers.emplace_back(fn, bounds[t], bounds[t + 1], t);
+        for (auto &worker : workers) worker.join();
+    }
+
+    // Calls fn(begin, end, thread) for consecutive ranges of [0, count), each one on its own thread
+    template <typename F>
+    void forRanges(size_t count, size_t threads, F fn) {
+        forBoundaries(boundaries(count, threads), fn);
+    }
+
+    // Buckets per chunk when [0, count) is cut into several chunks per thread. Chunks start on cache line boundaries
+    // of an array of given element size, so no two threads read the same line.
+    inline size_t chunkSize(size_t count, size_t threads, size_t elementSize) {
+        size_t perLine = std::max<size_t>(1, constants::CACHE_LINE_SIZE / elementSize);
+        size_t chunk = std::max<size_t>(1, count / (threads * constants::PARALLEL_CHUNKS_PER_THREAD));
+        return (chunk + perLine - 1) / perLine * perLine;
+    }
+
+    // Calls fn(begin, end, chunk) for every chunk of [0, count). Threads take the next chunk from a shared counter
+    // once they are done with theirs, so buckets with long chains or trees do not hold back the whole scan.
+    template <typename F>
+    void forChunks(size_t count, size_t chunk, size_t threads, F fn) {
+        size_t chunks = (count + chunk - 1) / chunk;
+        std::atomic<size_t> next(0);
+        auto work = [&fn, &next, count, chunk, chunks]() {
+            for (size_t c = next++; c < chunks; c = next++) fn(c * chunk, std::min(count, (c + 1) * chunk), c);
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < std::min(threads, chunks); t++) workers.emplace_back(work);
+        work();
+        for (auto &worker : workers) worker.join();
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <iostream>
+
+// Probe sequence policies for OpenAddressingMap. Every policy is a stateless type resolved at compile time:
+//   capacity(n)            - smallest capacity >= n for which the sequence visits every bucket
+//   index(hash, itr, cap)  - bucket visited by the itr-th probe of a key
+//   contiguous             - sequence walks neighbouring buckets, required by backward shift deletion
+//   robinHood              - entries are kept ordered by probe sequence length
+
+struct LinearProbing {
+    static constexpr bool contiguous = true;
+    static constexpr bool robinHood = false;
+
+    static size_t capacity(size_t capacity) { return capacity < 2 ? 2 : capacity; }
+    static size_t index(size_t hash, size_t itr, size_t capacity) { return (hash + itr) % capacity; }
+};
+
+struct TriangularProbing {
+    static constexpr bool contiguous = false;
+    static constexpr bool robinHood = false;
+
+    // Triangular numbers visit every bucket only for power of two capacities
+    static size_t capacity(size_t capacity) {
+        size_t power = 2;
+        while (power < capacity) power *= 2;
+        return power;
+    }
+    static size_t index(size_t hash, size_t itr, size_t capacity) { return (hash + itr * (itr + 1) / 2) % capacity; }
+};
+
+struct DoubleHashing {
+    static constexpr bool contiguous = false;
+    static constexpr bool robinHood = false;
+
+    // Any step visits every bucket only for prime capacities
+    static size_t capacity(size_t capacity) {
+        size_t prime = capacity < 3 ? 3 : capacity;
+        while (!isPrime(prime)) prime++;
+        return prime;
+    }
+    static size_t index(size_t hash, size_t itr, size_t capacity) {
+        return (hash % capacity + itr * (1 + hash % (capacity - 1))) % capacity;
+    }
+
+private:
+    static bool isPrime(size_t n) {
+        if (n <= 3) return n > 1;
+        if (n % 2 == 0 || n % 3 == 0) return false;
+        for (size_t i = 5; i * i <= n; i += 6) {
+            if (n % i == 0 || n % (i + 2) == 0) return false;
+        }
+        return true;
+    }
+};
+
+struct RobinHoodProbing {
+    static constexpr bool contiguous = true;
+    static constexpr bool robinHood = true;
+
+    static size_t capacity(size_t capacity) { return capacity < 2 ? 2 : capacity; }
+    static size_t index(size_t hash, size_t itr, size_t capacity) { return (hash + itr) % capacity; }
+};
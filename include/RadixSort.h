@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace radix {
+    constexpr size_t DIGIT_BITS = 11;
+
+    // Finalizer of splitmix64, std::hash of integers is the identity and would leave the top bits of small keys empty
+    inline uint64_t mix(uint64_t hash) {
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+        return hash ^ (hash >> 31);
+    }
+
+    // One of 2^bits partitions taken from the top bits of the mixed hash, which leaves the low bits tables index with
+    // spread evenly within every partition
+    inline size_t partitionOf(size_t hash, size_t bits) {
+        if (bits == 0) return 0;
+        return static_cast<size_t>(mix(hash) >> (64 - bits));
+    }
+
+    // Stable LSD radix sort returning the permutation that orders keys ascending, every key has to be below limit
+    inline std::vector<size_t> sortedOrder(const std::vector<size_t> &keys, size_t limit) {
+        constexpr size_t digits = static_cast<size_t>(1) << DIGIT_BITS;
+        std::vector<size_t> order(keys.size());
+        std::vector<size_t> buffer(keys.size());
+        std::iota(order.begin(), order.end(), 0);
+
+        for (size_t shift = 0; limit > 1 && ((limit - 1) >> shift) != 0; shift += DIGIT_BITS) {
+            std::vector<size_t> counts(digits + 1, 0);
+            for (size_t idx : order) counts[((keys[idx] >> shift) & (digits - 1)) + 1]++;
+            for (size_t d = 1; d <= digits; d++) counts[d] += counts[d - 1];
+            for (size_t idx : order) buffer[counts[(keys[idx] >> shift) & (digits - 1)]++] = idx;
+            order.swap(buffer);
+        }
+        return order;
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Constants.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace reclamation {
+    constexpr uint64_t IDLE = UINT64_MAX;
+
+    // Announced epoch of one reader thread, padded so that readers never write a cache line shared with others
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{IDLE};
+        std::atomic<bool> used{false};
+    };
+
+    // Epoch based reclamation shared by all maps. Readers announce the epoch they entered in, the writer frees
+    // what it unlinked only once every announced epoch is newer than the one the object was retired in.
+    class EpochDomain {
+    private:
+        std::atomic<uint64_t> _epoch{0};
+        ReaderSlot _slots[constants::MAX_READER_THREADS];
+
+    public:
+        static EpochDomain &instance() {
+            static EpochDomain domain;
+            return domain;
+        }
+
+        ReaderSlot &acquireSlot() {
+            for (ReaderSlot &slot : _slots) {
+                bool expected = false;
+                if (slot.used.compare_exchange_strong(expected, true)) return slot;
+            }
+            throw std::runtime_error("ReclamationError: Too many concurrent reader threads");
+        }
+
+        void releaseSlot(ReaderSlot &slot) { slot.used.store(false, std::memory_order_release); }
+
+        void enter(ReaderSlot &slot) {
+            slot.epoch.store(_epoch.load(std::memory_order_acquire), std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        void leave(ReaderSlot &slot) { slot.epoch.store(IDLE, std::memory_order_release); }
+
+        uint64_t current() { return _epoch.load(std::memory_order_relaxed); }
+
+        // Starts a new epoch and returns the oldest one still in use, objects retired before it can be freed
+        uint64_t advance() {
+            uint64_t oldest = _epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            for (ReaderSlot &slot : _slots) {
+                uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+                if (epoch < oldest) oldest = epoch;
+            }
+            return oldest;
+        }
+    };
+
+    // Slot of the calling thread, taken on its first read and given back when the thread exits
+    inline ReaderSlot &threadSlot() {
+        struct Holder {
+            ReaderSlot *slot;
+            Holder() : slot(&EpochDomain::instance().acquireSlot()) {}
+            ~Holder() { EpochDomain::instance().releaseSlot(*slot); }
+        };
+
+        thread_local Holder holder;
+        return *holder.slot;
+    }
+
+    // Keeps everything reachable at construction alive until destruction
+    class ReadGuard {
+    private:
+        ReaderSlot &_slot;
+
+    public:
+        ReadGuard() : _slot(threadSlot()) { EpochDomain::instance().enter(_slot); }
+        ~ReadGuard() { EpochDomain::instance().leave(_slot); }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+    };
+}
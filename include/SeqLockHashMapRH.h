@@ -0,0 +1,333 @@
+#pragma once
+
+#include "HashMapEntry.h"
+#include "Constants.h"
+#include "Reclamation.h"
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Robin Hood map for one writer thread and any number of concurrent reader threads. Published entries are never
+// modified, so readers take no lock and write no shared memory: they probe optimistically and retry when the
+// sequence counter shows that entries were shifted meanwhile. Unlinked entries and replaced tables are handed
+// to epoch based reclamation. put, remove and clear must only be called from the writer thread.
+template <typename K, typename V, typename H = std::hash<K>>
+class SeqLockHashMapRH {
+private:
+    struct Slot {
+        std::atomic<HashMapEntry<K, V> *> entry{nullptr};
+        std::atomic<size_t> psl{0};
+    };
+
+    struct Table {
+        size_t capacity;
+        Slot *slots;
+
+        explicit Table(size_t capacity) : capacity(capacity), slots(new Slot[capacity]) {}
+        ~Table() { delete []slots; }
+    };
+
+    std::atomic<Table *> _table;
+    std::atomic<uint64_t> _sequence;
+    H _hasher;
+    float _loadFactor;
+    std::atomic<size_t> _size;
+
+    std::vector<std::pair<uint64_t, HashMapEntry<K, V> *>> _retiredEntries;
+    std::vector<std::pair<uint64_t, Table *>> _retiredTables;
+
+    size_t threshold(Table *table);
+    int locate(Table *table, size_t hashValue, const K &key);
+    void beginWrite();
+    void endWrite();
+    void shiftIn(Table *table, size_t idx, HashMapEntry<K, V> *entry, size_t psl);
+    void rehash();
+    void retire(HashMapEntry<K, V> *entry);
+    void retire(Table *table);
+    void collect(bool force);
+
+    template <typename F>
+    bool read(const K &key, F fn);
+
+public:
+    SeqLockHashMapRH();
+    explicit SeqLockHashMapRH(size_t capacity);
+    SeqLockHashMapRH(size_t capacity, float loadFactor);
+    ~SeqLockHashMapRH();
+
+    // Readers may be probing the table of either map at any time, so the map is neither copied nor moved
+    SeqLockHashMapRH(const SeqLockHashMapRH &) = delete;
+    SeqLockHashMapRH &operator=(const SeqLockHashMapRH &) = delete;
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+
+    void clear();
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename H>
+SeqLockHashMapRH<K, V, H>::SeqLockHashMapRH() : SeqLockHashMapRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename H>
+SeqLockHashMapRH<K, V, H>::SeqLockHashMapRH(size_t capacity)
+        : SeqLockHashMapRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename K, typename V, typename H>
+SeqLockHashMapRH<K, V, H>::SeqLockHashMapRH(size_t capacity, float loadFactor) : _table(new Table(capacity)),
+                                                                                 _sequence(0),
+                                                                                 _loadFactor(loadFactor), _size(0) {}
+
+template <typename K, typename V, typename H>
+SeqLockHashMapRH<K, V, H>::~SeqLockHashMapRH() {
+    Table *table = _table.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < table->capacity; i++) delete table->slots[i].entry.load(std::memory_order_relaxed);
+    delete table;
+    this->collect(true);
+}
+
+template <typename K, typename V, typename H>
+size_t SeqLockHashMapRH<K, V, H>::getCapacity() { return _table.load(std::memory_order_acquire)->capacity; }
+
+template <typename K, typename V, typename H>
+size_t SeqLockHashMapRH<K, V, H>::getSize() { return _size.load(std::memory_order_relaxed); }
+
+template <typename K, typename V, typename H>
+float SeqLockHashMapRH<K, V, H>::getLoadFactor() { return _loadFactor; }
+
+template <typename K, typename V, typename H>
+V SeqLockHashMapRH<K, V, H>::put(const K &key, const V &value) {
+    Table *table = _table.load(std::memory_order_relaxed);
+    size_t hashValue = _hasher(key) % table->capacity;
+    auto *entry = new HashMapEntry<K, V>(key, value);
+
+    int idx = this->locate(table, hashValue, key);
+    if (idx != -1) {
+        // Replacing the whole entry keeps the one a reader may be copying intact
+        HashMapEntry<K, V> *previous = table->slots[idx].entry.load(std::memory_order_relaxed);
+        table->slots[idx].entry.store(entry, std::memory_order_release);
+
+        V rtnValue = previous->getValue();
+        this->retire(previous);
+        return rtnValue;
+    }
+
+    size_t itr = 0; size_t pos = hashValue;
+    for (; itr < table->capacity; itr++) {
+        pos = (hashValue + itr) % table->capacity;
+        if (table->slots[pos].entry.load(std::memory_order_relaxed) == nullptr) break;
+        if (table->slots[pos].psl.load(std::memory_order_relaxed) < itr) break;
+    }
+
+    if (table->slots[pos].entry.load(std::memory_order_relaxed) == nullptr) {
+        // A single store into a free slot is atomic for readers, no shift has to be announced
+        table->slots[pos].psl.store(itr, std::memory_order_relaxed);
+        table->slots[pos].entry.store(entry, std::memory_order_release);
+    } else {
+        this->beginWrite();
+        this->shiftIn(table, pos, entry, itr);
+        this->endWrite();
+    }
+
+    _size.fetch_add(1, std::memory_order_relaxed);
+    if (this->threshold(table) < _size.load(std::memory_order_relaxed)) this->rehash();
+    return V();
+}
+
+template <typename K, typename V, typename H>
+V SeqLockHashMapRH<K, V, H>::get(const K &key) {
+    V rtnValue;
+    if (this->read(key, [&rtnValue](HashMapEntry<K, V> *entry) { rtnValue = entry->getValue(); })) return rtnValue;
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename K, typename V, typename H>
+V SeqLockHashMapRH<K, V, H>::remove(const K &key) {
+    Table *table = _table.load(std::memory_order_relaxed);
+    int idx = this->locate(table, _hasher(key) % table->capacity, key);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    HashMapEntry<K, V> *entry = table->slots[idx].entry.load(std::memory_order_relaxed);
+    size_t next = (idx + 1) % table->capacity;
+    bool shift = table->slots[next].entry.load(std::memory_order_relaxed) != nullptr &&
+                 table->slots[next].psl.load(std::memory_order_relaxed) > 0;
+
+    if (shift) this->beginWrite();
+    while (table->slots[next].entry.load(std::memory_order_relaxed) != nullptr &&
+           table->slots[next].psl.load(std::memory_order_relaxed) > 0) {
+        table->slots[idx].psl.store(table->slots[next].psl.load(std::memory_order_relaxed) - 1,
+                                    std::memory_order_relaxed);
+        table->slots[idx].entry.store(table->slots[next].entry.load(std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+        idx = static_cast<int>(next);
+        next = (next + 1) % table->capacity;
+    }
+    table->slots[idx].entry.store(nullptr, std::memory_order_relaxed);
+    if (shift) this->endWrite();
+
+    _size.fetch_sub(1, std::memory_order_relaxed);
+    V rtnValue = entry->getValue();
+    this->retire(entry);
+    return rtnValue;
+}
+
+template <typename K, typename V, typename H>
+bool SeqLockHashMapRH<K, V, H>::containsKey(const K &key) {
+    return this->read(key, [](HashMapEntry<K, V> *) {});
+}
+
+template <typename K, typename V, typename H>
+bool SeqLockHashMapRH<K, V, H>::isEmpty() { return this->getSize() == 0; }
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::clear() {
+    Table *table = _table.load(std::memory_order_relaxed);
+    _table.store(new Table(table->capacity), std::memory_order_release);
+    _size.store(0, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        HashMapEntry<K, V> *entry = table->slots[i].entry.load(std::memory_order_relaxed);
+        if (entry != nullptr) this->retire(entry);
+    }
+    this->retire(table);
+}
+
+template <typename K, typename V, typename H>
+size_t SeqLockHashMapRH<K, V, H>::threshold(Table *table) {
+    return static_cast<size_t>(table->capacity * _loadFactor);
+}
+
+template <typename K, typename V, typename H>
+template <typename F>
+bool SeqLockHashMapRH<K, V, H>::read(const K &key, F fn) {
+    reclamation::ReadGuard guard;
+    size_t hash = _hasher(key);
+
+    while (true) {
+        uint64_t sequence = _sequence.load(std::memory_order_acquire);
+        if (sequence % 2 == 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        Table *table = _table.load(std::memory_order_acquire);
+        size_t hashValue = hash % table->capacity;
+        HashMapEntry<K, V> *found = nullptr;
+
+        for (size_t itr = 0; itr < table->capacity; itr++) {
+            Slot &slot = table->slots[(hashValue + itr) % table->capacity];
+            HashMapEntry<K, V> *current = slot.entry.load(std::memory_order_acquire);
+
+            if (current == nullptr) break;
+            if (itr > slot.psl.load(std::memory_order_relaxed)) break;
+            if (current->getKey() == key) {
+                found = current;
+                break;
+            }
+        }
+        if (found != nullptr) fn(found);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (_sequence.load(std::memory_order_relaxed) == sequence) return found != nullptr;
+    }
+}
+
+template <typename K, typename V, typename H>
+int SeqLockHashMapRH<K, V, H>::locate(Table *table, size_t hashValue, const K &key) {
+    for (size_t itr = 0; itr < table->capacity; itr++) {
+        size_t idx = (hashValue + itr) % table->capacity;
+        HashMapEntry<K, V> *current = table->slots[idx].entry.load(std::memory_order_relaxed);
+
+        if (current == nullptr) break;
+        if (itr > table->slots[idx].psl.load(std::memory_order_relaxed)) break;
+        if (current->getKey() == key) return static_cast<int>(idx);
+    }
+    return -1;
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::beginWrite() {
+    _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::endWrite() {
+    _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::shiftIn(Table *table, size_t idx, HashMapEntry<K, V> *entry, size_t psl) {
+    while (entry != nullptr) {
+        Slot &slot = table->slots[idx];
+        HashMapEntry<K, V> *current = slot.entry.load(std::memory_order_relaxed);
+        size_t currentPSL = slot.psl.load(std::memory_order_relaxed);
+
+        if (current == nullptr || currentPSL < psl) {
+            slot.psl.store(psl, std::memory_order_relaxed);
+            slot.entry.store(entry, std::memory_order_relaxed);
+            entry = current;
+            psl = currentPSL;
+        }
+
+        idx = (idx + 1) % table->capacity;
+        psl++;
+    }
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::rehash() {
+    // The new table is filled privately and published with a single store, readers still probing the old one
+    // see a consistent snapshot since it is never written again
+    Table *table = _table.load(std::memory_order_relaxed);
+    auto *grown = new Table(table->capacity * 2);
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        HashMapEntry<K, V> *entry = table->slots[i].entry.load(std::memory_order_relaxed);
+        if (entry != nullptr) this->shiftIn(grown, _hasher(entry->getKey()) % grown->capacity, entry, 0);
+    }
+
+    _table.store(grown, std::memory_order_release);
+    this->retire(table);
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::retire(HashMapEntry<K, V> *entry) {
+    _retiredEntries.emplace_back(reclamation::EpochDomain::instance().current(), entry);
+    if (_retiredEntries.size() >= constants::RETIRE_BATCH) this->collect(false);
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::retire(Table *table) {
+    _retiredTables.emplace_back(reclamation::EpochDomain::instance().current(), table);
+    this->collect(false);
+}
+
+template <typename K, typename V, typename H>
+void SeqLockHashMapRH<K, V, H>::collect(bool force) {
+    uint64_t oldest = force ? reclamation::IDLE : reclamation::EpochDomain::instance().advance();
+
+    size_t kept = 0;
+    for (auto &retired : _retiredEntries) {
+        if (retired.first < oldest) delete retired.second;
+        else _retiredEntries[kept++] = retired;
+    }
+    _retiredEntries.resize(kept);
+
+    kept = 0;
+    for (auto &retired : _retiredTables) {
+        if (retired.first < oldest) delete retired.second;
+        else _retiredTables[kept++] = retired;
+    }
+    _retiredTables.resize(kept);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "HashMapRH.h"
+#include "Constants.h"
+#include "RadixSort.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// Map split into 2^shardBits independent maps of type Map, each guarded by a mutex of its own, so threads working on
+// different shards never wait for each other. Shards are picked from the top bits of the mixed key hash, leaving the
+// low bits the maps index with spread evenly within every shard. Map can be any of the maps with put, get, find, remove,
+// tryRemove and containsKey, which lets every collision resolution strategy be measured behind the same front-end.
+template <typename K, typename V, typename Map = HashMapRH<K, V>, typename H = std::hash<K>>
+class ShardedHashMap {
+private:
+    // Every shard takes whole cache lines, so locking one does not invalidate the line of its neighbour
+    struct alignas(constants::CACHE_LINE_SIZE) Shard {
+        std::mutex mutex;
+        Map map;
+
+        explicit Shard(size_t capacity) : map(capacity) {}
+    };
+
+    H _hasher;
+    size_t _shardBits;
+    std::vector<Shard *> _shards;
+
+    Shard &shardOf(const K &key);
+
+public:
+    ShardedHashMap();
+    explicit ShardedHashMap(size_t shardBits);
+    ShardedHashMap(size_t shardBits, size_t shardCapacity);
+    ~ShardedHashMap();
+
+    ShardedHashMap(const ShardedHashMap &) = delete;
+    ShardedHashMap &operator=(const ShardedHashMap &) = delete;
+
+    size_t getShards();
+    size_t getSize();
+
+    V put(const K &key, const V &value);
+    V get(const K &key);
+    V remove(const K &key);
+    bool tryGet(const K &key, V &value);
+    bool tryRemove(const K &key, V &value);
+
+    bool containsKey(const K &key);
+    bool isEmpty();
+};
+
+template <typename K, typename V, typename Map, typename H>
+ShardedHashMap<K, V, Map, H>::ShardedHashMap() : ShardedHashMap(constants::SHARD_BITS) {}
+
+template <typename K, typename V, typename Map, typename H>
+ShardedHashMap<K, V, Map, H>::ShardedHashMap(size_t shardBits)
+        : ShardedHashMap(shardBits, constants::DEFAULT_CAPACITY) {}
+
+template <typename K, typename V, typename Map, typename H>
+ShardedHashMap<K, V, Map, H>::ShardedHashMap(size_t shardBits, size_t shardCapacity)
+        : _hasher(), _shardBits(shardBits) {
+    if (shardBits > constants::SHARD_MAX_BITS) throw std::invalid_argument("ValueError: Too many shard bits");
+    for (size_t i = 0; i < (static_cast<size_t>(1) << shardBits); i++) _shards.push_back(new Shard(shardCapacity));
+}
+
+template <typename K, typename V, typename Map, typename H>
+ShardedHashMap<K, V, Map, H>::~ShardedHashMap() {
+    for (Shard *shard : _shards) delete shard;
+}
+
+template <typename K, typename V, typename Map, typename H>
+typename ShardedHashMap<K, V, Map, H>::Shard &ShardedHashMap<K, V, Map, H>::shardOf(const K &key) {
+    return *_shards[radix::partitionOf(_hasher(key), _shardBits)];
+}
+
+template <typename K, typename V, typename Map, typename H>
+size_t ShardedHashMap<K, V, Map, H>::getShards() { return _shards.size(); }
+
+// Sizes of the shards are read one after another, so with concurrent writers the sum is only approximate
+template <typename K, typename V, typename Map, typename H>
+size_t ShardedHashMap<K, V, Map, H>::getSize() {
+    size_t size = 0;
+    for (Shard *shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->map.getSize();
+    }
+    return size;
+}
+
+template <typename K, typename V, typename Map, typename H>
+V ShardedHashMap<K, V, Map, H>::put(const K &key, const V &value) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.put(key, value);
+}
+
+template <typename K, typename V, typename Map, typename H>
+V ShardedHashMap<K, V, Map, H>::get(const K &key) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.get(key);
+}
+
+template <typename K, typename V, typename Map, typename H>
+V ShardedHashMap<K, V, Map, H>::remove(const K &key) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.remove(key);
+}
+
+// Lookups expecting misses go through the single probe of find and tryRemove instead of catching the exception thrown
+// by get and remove
+template <typename K, typename V, typename Map, typename H>
+bool ShardedHashMap<K, V, Map, H>::tryGet(const K &key, V &value) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    V *found = shard.map.find(key);
+    if (found == nullptr) return false;
+    value = *found;
+    return true;
+}
+
+template <typename K, typename V, typename Map, typename H>
+bool ShardedHashMap<K, V, Map, H>::tryRemove(const K &key, V &value) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.tryRemove(key, value);
+}
+
+template <typename K, typename V, typename Map, typename H>
+bool ShardedHashMap<K, V, Map, H>::containsKey(const K &key) {
+    Shard &shard = this->shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.map.containsKey(key);
+}
+
+template <typename K, typename V, typename Map, typename H>
+bool ShardedHashMap<K, V, Map, H>::isEmpty() { return this->getSize() == 0; }
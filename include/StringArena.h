@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace arena {
+    // Bump allocator for string bytes. Strings are addressed by offset, so growing the buffer never invalidates them,
+    // and released bytes are only counted: they are given back by copying the live strings into a fresh arena.
+    class StringArena {
+    private:
+        std::vector<char> _bytes;
+        size_t _released = 0;
+
+    public:
+        size_t append(std::string_view value) {
+            size_t offset = _bytes.size();
+            _bytes.insert(_bytes.end(), value.begin(), value.end());
+            return offset;
+        }
+
+        std::string_view view(size_t offset, size_t length) const {
+            return {_bytes.data() + offset, length};
+        }
+
+        void release(size_t length) { _released += length; }
+        void reserve(size_t length) { _bytes.reserve(length); }
+
+        size_t getSize() const { return _bytes.size(); }
+        size_t getReleasedSize() const { return _released; }
+        size_t getLiveSize() const { return _bytes.size() - _released; }
+
+        void clear() {
+            _bytes.clear();
+            _released = 0;
+        }
+
+        void swap(StringArena &other) {
+            _bytes.swap(other._bytes);
+            std::swap(_released, other._released);
+        }
+    };
+
+    // First bytes of a string packed into a word, zero padded, which tells most mismatching keys apart without
+    // reading the arena
+    inline uint64_t prefixOf(std::string_view value) {
+        uint64_t prefix = 0;
+        if (value.empty()) return prefix;
+        std::memcpy(&prefix, value.data(), value.size() < sizeof(prefix) ? value.size() : sizeof(prefix));
+        return prefix;
+    }
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "HashMapEntryArena.h"
+#include "StringArena.h"
+#include "Allocation.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <string_view>
+#include <utility>
+
+// Robin hood map with string keys copied into an arena owned by the map. Slots are stored inline and refer to their
+// key by offset and length, so an insertion allocates nothing but arena growth. Bytes of removed keys are reclaimed
+// by copying the live keys into a new arena, either on rehashing or once enough of them have been released.
+template <typename V, typename H = std::hash<std::string_view>>
+class StringHashMapRH {
+private:
+    HashMapEntryArena<V> *_buckets;
+    arena::StringArena _arena;
+    H _hasher;
+    size_t _capacity;
+    float _loadFactor;
+    size_t _size;
+
+    size_t threshold();
+    void rehash(size_t capacity);
+    void compact();
+    bool matches(const HashMapEntryArena<V> &entry, std::string_view key, uint64_t prefix);
+    int search(std::string_view key);
+    void place(HashMapEntryArena<V> entry, size_t hashValue);
+
+public:
+    StringHashMapRH();
+    explicit StringHashMapRH(size_t capacity);
+    StringHashMapRH(size_t capacity, float loadFactor);
+    ~StringHashMapRH();
+
+    StringHashMapRH(const StringHashMapRH &) = delete;
+    StringHashMapRH &operator=(const StringHashMapRH &) = delete;
+    StringHashMapRH(StringHashMapRH &&other);
+    StringHashMapRH &operator=(StringHashMapRH &&other);
+
+    size_t getCapacity();
+    size_t getSize();
+    float getLoadFactor();
+    size_t getArenaSize();
+
+    V put(std::string_view key, const V &value);
+    V get(std::string_view key);
+    V remove(std::string_view key);
+
+    void clear();
+    void swap(StringHashMapRH &other) noexcept;
+    StringHashMapRH clone();
+
+    bool containsKey(std::string_view key);
+    bool isEmpty();
+};
+
+template <typename V, typename H>
+StringHashMapRH<V, H>::StringHashMapRH() : StringHashMapRH(constants::DEFAULT_CAPACITY) {}
+
+template <typename V, typename H>
+StringHashMapRH<V, H>::StringHashMapRH(size_t capacity) : StringHashMapRH(capacity, constants::DEFAULT_LOAD_FACTOR) {}
+
+template <typename V, typename H>
+StringHashMapRH<V, H>::StringHashMapRH(size_t capacity, float loadFactor)
+        : _capacity(capacity), _loadFactor(loadFactor), _size(0) {
+    _buckets = new HashMapEntryArena<V>[_capacity]();
+}
+
+template <typename V, typename H>
+StringHashMapRH<V, H>::~StringHashMapRH() {
+    delete []_buckets;
+}
+
+template <typename V, typename H>
+StringHashMapRH<V, H>::StringHashMapRH(StringHashMapRH<V, H> &&other) : StringHashMapRH() { this->swap(other); }
+
+template <typename V, typename H>
+StringHashMapRH<V, H> &StringHashMapRH<V, H>::operator=(StringHashMapRH<V, H> &&other) {
+    StringHashMapRH(std::move(other)).swap(*this);
+    return *this;
+}
+
+template <typename V, typename H>
+void StringHashMapRH<V, H>::swap(StringHashMapRH<V, H> &other) noexcept {
+    std::swap(_buckets, other._buckets);
+    std::swap(_arena, other._arena);
+    std::swap(_hasher, other._hasher);
+    std::swap(_capacity, other._capacity);
+    std::swap(_loadFactor, other._loadFactor);
+    std::swap(_size, other._size);
+}
+
+// Slots only refer to their keys by offset, so copying the arena and the slot array as they are gives a valid map
+template <typename V, typename H>
+StringHashMapRH<V, H> StringHashMapRH<V, H>::clone() {
+    StringHashMapRH copy(_capacity, _loadFactor);
+    copy._hasher = _hasher;
+    copy._arena = _arena;
+    allocation::copyBuckets(copy._buckets, _buckets, _capacity);
+
+    copy._size = _size;
+    return copy;
+}
+
+template <typename V, typename H>
+size_t StringHashMapRH<V, H>::getCapacity() { return _capacity; }
+
+template <typename V, typename H>
+size_t StringHashMapRH<V, H>::getSize() { return _size; }
+
+template <typename V, typename H>
+float StringHashMapRH<V, H>::getLoadFactor() { return _loadFactor; }
+
+template <typename V, typename H>
+size_t StringHashMapRH<V, H>::getArenaSize() { return _arena.getSize(); }
+
+template <typename V, typename H>
+V StringHashMapRH<V, H>::put(std::string_view key, const V &value) {
+    size_t hashValue = _hasher(key) % _capacity;
+    uint64_t prefix = arena::prefixOf(key);
+
+    // The key is copied into the arena only once the probe knows it is new, either when it reaches a free slot or
+    // when robin hood displaces an entry, since no equal key can sit past that point
+    HashMapEntryArena<V> entry(static_cast<uint32_t>(key.size()), prefix, value);
+    bool stored = false;
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        HashMapEntryArena<V> &current = _buckets[(hashValue + itr) % _capacity];
+
+        if (!stored && current.isOccupied() && this->matches(current, key, prefix)) {
+            V rtnValue = current.getValue();
+            current.setValue(value);
+            return rtnValue;
+        }
+
+        if (!current.isOccupied() || current.getPSL() < entry.getPSL()) {
+            if (!stored) {
+                entry.setOffset(_arena.append(key));
+                stored = true;
+            }
+
+            if (!current.isOccupied()) {
+                current = std::move(entry);
+                _size++;
+
+                if (this->threshold() < _size) this->rehash(_capacity * 2);
+                return V();
+            }
+            std::swap(current, entry);
+        }
+        entry.setPSL(entry.getPSL() + 1);
+    }
+    return V();
+}
+
+template <typename V, typename H>
+V StringHashMapRH<V, H>::get(std::string_view key) {
+    int idx = this->search(key);
+
+    if (idx != -1) return _buckets[idx].getValue();
+    throw std::out_of_range("KeyError: Given key does not exist in map");
+}
+
+template <typename V, typename H>
+V StringHashMapRH<V, H>::remove(std::string_view key) {
+    int idx = this->search(key);
+    if (idx == -1) throw std::out_of_range("KeyError: Given key does not exist in map");
+
+    size_t index = idx;
+    V rtnValue = _buckets[index].getValue();
+    _arena.release(_buckets[index].getLength());
+    _buckets[index] = HashMapEntryArena<V>();
+    _size--;
+
+    size_t next = (index + 1) % _capacity;
+    while (_buckets[next].isOccupied() && _buckets[next].getPSL() > 0) {
+        _buckets[next].setPSL(_buckets[next].getPSL() - 1);
+        _buckets[index] = std::move(_buckets[next]);
+        _buckets[next] = HashMapEntryArena<V>();
+
+        index = next;
+        next = (index + 1) % _capacity;
+    }
+
+    // Compacting once the removed bytes outweigh both the live ones and the slot count keeps the arena at most twice
+    // its live size, and the visit of every slot is paid for by the removed bytes even in a mostly empty table
+    size_t released = _arena.getReleasedSize();
+    if (released > _arena.getLiveSize() && released >= _capacity) this->compact();
+    return rtnValue;
+}
+
+template <typename V, typename H>
+bool StringHashMapRH<V, H>::containsKey(std::string_view key) { return this->search(key) != -1; }
+
+template <typename V, typename H>
+bool StringHashMapRH<V, H>::isEmpty() { return _size == 0; }
+
+template <typename V, typename H>
+void StringHashMapRH<V, H>::clear() {
+    for (size_t i = 0; i < _capacity; i++) _buckets[i] = HashMapEntryArena<V>();
+    _arena.clear();
+    _size = 0;
+}
+
+template <typename V, typename H>
+size_t StringHashMapRH<V, H>::threshold() { return static_cast<size_t>(_capacity * _loadFactor); }
+
+template <typename V, typename H>
+bool StringHashMapRH<V, H>::matches(const HashMapEntryArena<V> &entry, std::string_view key, uint64_t prefix) {
+    if (entry.getLength() != key.size() || entry.getPrefix() != prefix) return false;
+    return _arena.view(entry.getOffset(), entry.getLength()) == key;
+}
+
+template <typename V, typename H>
+int StringHashMapRH<V, H>::search(std::string_view key) {
+    if (this->isEmpty()) return -1;
+    size_t hashValue = _hasher(key) % _capacity;
+    uint64_t prefix = arena::prefixOf(key);
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        size_t idx = (hashValue + itr) % _capacity;
+        const HashMapEntryArena<V> &current = _buckets[idx];
+
+        if (!current.isOccupied()) break;
+        if (itr > current.getPSL()) break;
+        if (this->matches(current, key, prefix)) return static_cast<int>(idx);
+    }
+    return -1;
+}
+
+template <typename V, typename H>
+void StringHashMapRH<V, H>::place(HashMapEntryArena<V> entry, size_t hashValue) {
+    entry.setPSL(0);
+
+    for (size_t itr = 0; itr < _capacity; itr++) {
+        HashMapEntryArena<V> &current = _buckets[(hashValue + itr) % _capacity];
+        if (!current.isOccupied()) {
+            current = std::move(entry);
+            return;
+        }
+
+        if (current.getPSL() < entry.getPSL()) std::swap(current, entry);
+        entry.setPSL(entry.getPSL() + 1);
+    }
+}
+
+// Keys are copied into a new arena in slot order, which drops the bytes of removed keys. Slots keep their positions,
+// only their offsets change
+template <typename V, typename H>
+void StringHashMapRH<V, H>::compact() {
+    arena::StringArena compacted;
+    compacted.reserve(_arena.getLiveSize());
+
+    for (size_t i = 0; i < _capacity; i++) {
+        if (!_buckets[i].isOccupied()) continue;
+        _buckets[i].setOffset(compacted.append(_arena.view(_buckets[i].getOffset(), _buckets[i].getLength())));
+    }
+    _arena.swap(compacted);
+}
+
+// Rehashing compacts the arena on the way, since every key is visited anyway
+template <typename V, typename H>
+void StringHashMapRH<V, H>::rehash(size_t capacity) {
+    size_t prevCapacity = _capacity; _capacity = capacity;
+    HashMapEntryArena<V> *temp = _buckets;
+    _buckets = new HashMapEntryArena<V>[_capacity]();
+
+    arena::StringArena compacted;
+    compacted.reserve(_arena.getLiveSize());
+
+    for (size_t i = 0; i < prevCapacity; i++) {
+        if (!temp[i].isOccupied()) continue;
+
+        std::string_view key = _arena.view(temp[i].getOffset(), temp[i].getLength());
+        temp[i].setOffset(compacted.append(key));
+        this->place(std::move(temp[i]), _hasher(key) % _capacity);
+    }
+
+    _arena.swap(compacted);
+    delete []temp;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Binary protocol of the key-value server. Every request is a fixed header followed by the key and the value bytes,
+// every response a fixed header followed by the value bytes. Clients may send any number of requests without waiting,
+// and responses come back in the order of the requests, so neither carries an identifier. Headers are in host byte
+// order, since the server and its clients run on one machine.
+namespace protocol {
+    enum class Op : uint8_t { GET = 1, PUT = 2, REMOVE = 3, CONTAINS = 4 };
+    enum class Status : uint8_t { OK = 0, NOT_FOUND = 1, BAD_REQUEST = 2, SERVER_ERROR = 3 };
+
+    struct RequestHeader {
+        uint8_t op;
+        uint8_t reserved;
+        uint16_t keyLength;
+        uint32_t valueLength;
+    };
+
+    struct ResponseHeader {
+        uint8_t status;
+        uint8_t reserved[3];
+        uint32_t valueLength;
+    };
+
+    constexpr size_t MAX_KEY_LENGTH = static_cast<size_t>(1) << 12;
+    constexpr size_t MAX_VALUE_LENGTH = static_cast<size_t>(1) << 20;
+    constexpr size_t READ_SIZE = static_cast<size_t>(1) << 16;
+    // A connection is closed once more request bytes than this wait to be executed
+    constexpr size_t MAX_PENDING_INPUT = static_cast<size_t>(1) << 24;
+    // A connection is not read from while more response bytes than this wait to be written
+    constexpr size_t MAX_PENDING_OUTPUT = static_cast<size_t>(1) << 22;
+
+    static_assert(MAX_PENDING_INPUT >= sizeof(RequestHeader) + MAX_KEY_LENGTH + MAX_VALUE_LENGTH + READ_SIZE,
+                  "The largest valid request has to fit into the input buffer");
+
+    inline void appendRequest(std::string &buffer, Op op, const std::string &key, const std::string &value = "") {
+        RequestHeader header{static_cast<uint8_t>(op), 0, static_cast<uint16_t>(key.size()),
+                             static_cast<uint32_t>(value.size())};
+        buffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        buffer.append(key);
+        buffer.append(value);
+    }
+
+    inline void appendResponse(std::string &buffer, Status status, const std::string &value = "") {
+        ResponseHeader header{static_cast<uint8_t>(status), {0, 0, 0}, static_cast<uint32_t>(value.size())};
+        buffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+        buffer.append(value);
+    }
+
+    // Size of the message starting at given offset, or 0 if the buffer does not hold all of it yet
+    inline size_t requestLength(const std::string &buffer, size_t offset, RequestHeader &header) {
+        if (buffer.size() - offset < sizeof(header)) return 0;
+        std::memcpy(&header, buffer.data() + offset, sizeof(header));
+        size_t length = sizeof(header) + header.keyLength + header.valueLength;
+        return buffer.size() - offset < length ? 0 : length;
+    }
+
+    // Whether the lengths in the header are within the limits, checked before the body of the request is buffered
+    inline bool validRequest(const RequestHeader &header) {
+        return header.keyLength <= MAX_KEY_LENGTH && header.valueLength <= MAX_VALUE_LENGTH;
+    }
+
+    inline size_t responseLength(const std::string &buffer, size_t offset, ResponseHeader &header) {
+        if (buffer.size() - offset < sizeof(header)) return 0;
+        std::memcpy(&header, buffer.data() + offset, sizeof(header));
+        size_t length = sizeof(header) + header.valueLength;
+        return buffer.size() - offset < length ? 0 : length;
+    }
+
+    // Either unix:<path> for a Unix domain socket or tcp:<port> for a loopback TCP socket
+    struct Address {
+        bool local;
+        std::string path;
+        uint16_t port;
+    };
+
+    inline Address parseAddress(const std::string &text) {
+        if (text.rfind("unix:", 0) == 0 && text.size() > 5) return {true, text.substr(5), 0};
+        if (text.rfind("tcp:", 0) == 0) return {false, "", static_cast<uint16_t>(std::stoi(text.substr(4)))};
+        throw std::invalid_argument("Address has to be unix:<path> or tcp:<port>, got " + text);
+    }
+
+    inline int openSocket(const Address &address, bool listening) {
+        int fd = socket(address.local ? AF_UNIX : AF_INET, SOCK_STREAM, 0);
+        if (fd == -1) throw std::runtime_error("Cannot create socket");
+
+        int result;
+        if (address.local) {
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            if (address.path.size() >= sizeof(addr.sun_path)) throw std::invalid_argument("Socket path is too long");
+            std::strncpy(addr.sun_path, address.path.c_str(), sizeof(addr.sun_path) - 1);
+            if (listening) unlink(address.path.c_str());
+            auto *generic = reinterpret_cast<sockaddr *>(&addr);
+            result = listening ? bind(fd, generic, sizeof(addr)) : connect(fd, generic, sizeof(addr));
+        } else {
+            int enable = 1;
+            setsockopt(fd, listening ? SOL_SOCKET : IPPROTO_TCP, listening ? SO_REUSEADDR : TCP_NODELAY, &enable,
+                       sizeof(enable));
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(address.port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            auto *generic = reinterpret_cast<sockaddr *>(&addr);
+            result = listening ? bind(fd, generic, sizeof(addr)) : connect(fd, generic, sizeof(addr));
+        }
+
+        if (result == 0 && listening) result = listen(fd, SOMAXCONN);
+        if (result != 0) {
+            close(fd);
+            throw std::runtime_error(std::string("Cannot ") + (listening ? "listen on " : "connect to ") +
+                                     (address.local ? address.path : "port " + std::to_string(address.port)));
+        }
+        return fd;
+    }
+}
@@ -0,0 +1,156 @@
+#include "Protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Load generator for the key-value server. Every connection runs on a thread of its own: it first puts its share of
+// the keys, then keeps sending batches of pipelined gets and puts of random keys, waiting for all responses of a batch
+// before sending the next one. The latency of a request is the time from sending its batch to reading its response.
+
+struct Options {
+    protocol::Address address;
+    size_t connections = 4;
+    size_t requests = 100000;
+    size_t pipeline = 16;
+    size_t keys = 100000;
+    size_t putPercent = 10;
+    size_t valueBytes = 32;
+};
+
+struct Results {
+    std::vector<uint32_t> latencies;
+    size_t misses = 0;
+    size_t errors = 0;
+};
+
+std::string keyOf(size_t key) { return "k" + std::to_string(key); }
+
+void sendAll(int fd, const std::string &buffer) {
+    size_t sent = 0;
+    while (sent < buffer.size()) {
+        ssize_t count = write(fd, buffer.data() + sent, buffer.size() - sent);
+        if (count <= 0) throw std::runtime_error("Connection closed while sending");
+        sent += count;
+    }
+}
+
+// Reads responses until given number of them arrived, calling fn with the status of each one as it is parsed
+template <typename F>
+void receive(int fd, std::string &buffer, size_t responses, F fn) {
+    char chunk[protocol::READ_SIZE];
+    size_t offset = 0;
+    protocol::ResponseHeader header{};
+    while (responses > 0) {
+        while (responses > 0) {
+            size_t length = protocol::responseLength(buffer, offset, header);
+            if (length == 0) break;
+            fn(static_cast<protocol::Status>(header.status));
+            offset += length;
+            responses--;
+        }
+        if (responses == 0) break;
+
+        ssize_t count = read(fd, chunk, sizeof(chunk));
+        if (count <= 0) throw std::runtime_error("Connection closed while receiving");
+        buffer.append(chunk, count);
+    }
+    buffer.erase(0, offset);
+}
+
+void load(const Options &options, size_t connection, std::atomic<size_t> &ready, Results &results) {
+    int fd = protocol::openSocket(options.address, false);
+    std::string value(options.valueBytes, 'v');
+    std::string request, response;
+
+    for (size_t key = connection; key < options.keys; key += options.connections * options.pipeline) {
+        size_t batch = 0;
+        for (size_t k = key; k < options.keys && batch < options.pipeline; k += options.connections, batch++) {
+            protocol::appendRequest(request, protocol::Op::PUT, keyOf(k), value);
+        }
+        sendAll(fd, request);
+        request.clear();
+        receive(fd, response, batch, [](protocol::Status) {});
+    }
+
+    // Measuring starts once every connection has loaded its keys
+    ready++;
+    while (ready < options.connections) std::this_thread::yield();
+
+    std::mt19937_64 generator(connection);
+    results.latencies.reserve(options.requests);
+    for (size_t done = 0; done < options.requests; done += options.pipeline) {
+        size_t batch = std::min(options.pipeline, options.requests - done);
+        for (size_t i = 0; i < batch; i++) {
+            std::string key = keyOf(generator() % options.keys);
+            if (generator() % 100 < options.putPercent) protocol::appendRequest(request, protocol::Op::PUT, key, value);
+            else protocol::appendRequest(request, protocol::Op::GET, key);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        sendAll(fd, request);
+        request.clear();
+        receive(fd, response, batch, [&results, start](protocol::Status status) {
+            auto latency = std::chrono::steady_clock::now() - start;
+            results.latencies.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+            if (status == protocol::Status::NOT_FOUND) results.misses++;
+            else if (status != protocol::Status::OK) results.errors++;
+        });
+    }
+    close(fd);
+}
+
+double percentile(const std::vector<uint32_t> &sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    size_t idx = std::min(sorted.size() - 1, static_cast<size_t>(fraction * static_cast<double>(sorted.size())));
+    return sorted[idx] / 1000.0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 8) {
+        std::cerr << "Usage: " << argv[0] << " <unix:path|tcp:port> [connections] [requests per connection] "
+                  << "[pipeline depth] [keys] [put percent] [value bytes]\n";
+        return 1;
+    }
+
+    Options options;
+    options.address = protocol::parseAddress(argv[1]);
+    size_t *numbers[] = {&options.connections, &options.requests, &options.pipeline, &options.keys,
+                         &options.putPercent, &options.valueBytes};
+    for (int i = 2; i < argc; i++) *numbers[i - 2] = std::stoul(argv[i]);
+    if (options.connections == 0 || options.pipeline == 0 || options.keys == 0)
+        throw std::invalid_argument("Connections, pipeline depth and keys must be positive");
+
+    std::atomic<size_t> ready(0);
+    std::vector<Results> results(options.connections);
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < options.connections; c++) {
+        threads.emplace_back(load, std::cref(options), c, std::ref(ready), std::ref(results[c]));
+    }
+
+    while (ready < options.connections) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    for (auto &thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint32_t> latencies;
+    size_t misses = 0, errors = 0;
+    for (auto &result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        misses += result.misses;
+        errors += result.errors;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "Requests: " << latencies.size() << ", misses: " << misses << ", errors: " << errors << "\n"
+              << "Throughput: " << static_cast<size_t>(latencies.size() / seconds) << " requests/s\n"
+              << "Latency [us]: p50 " << percentile(latencies, 0.5) << ", p99 " << percentile(latencies, 0.99)
+              << ", p99.9 " << percentile(latencies, 0.999) << ", max " << percentile(latencies, 1.0) << "\n";
+    return errors == 0 ? 0 : 1;
+}
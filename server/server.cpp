@@ -0,0 +1,223 @@
+#include <hashmaps/HashMapLL.h>
+#include <hashmaps/HashMapDH.h>
+#include <hashmaps/HashMapRH.h>
+#include <hashmaps/ShardedHashMap.h>
+
+#include "Protocol.h"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/epoll.h>
+
+// Serves get, put, remove and contains requests of the protocol in Protocol.h from a sharded map. Every core runs an
+// event loop of its own, which accepts connections from the shared listening socket and then owns them: all complete
+// requests found in a read are executed in order and their responses written back with a single write.
+
+std::atomic<bool> running(true);
+
+struct Connection {
+    int fd;
+    std::string input;
+    std::string output;
+    size_t written = 0;
+    bool reading = true;
+};
+
+template <typename Map>
+void execute(Map &map, const protocol::RequestHeader &header, const char *body, std::string &output) {
+    std::string key(body, header.keyLength);
+    std::string value;
+
+    switch (static_cast<protocol::Op>(header.op)) {
+        case protocol::Op::GET:
+            if (map.tryGet(key, value)) protocol::appendResponse(output, protocol::Status::OK, value);
+            else protocol::appendResponse(output, protocol::Status::NOT_FOUND);
+            break;
+        case protocol::Op::PUT:
+            map.put(key, std::string(body + header.keyLength, header.valueLength));
+            protocol::appendResponse(output, protocol::Status::OK);
+            break;
+        case protocol::Op::REMOVE:
+            if (map.tryRemove(key, value)) protocol::appendResponse(output, protocol::Status::OK, value);
+            else protocol::appendResponse(output, protocol::Status::NOT_FOUND);
+            break;
+        case protocol::Op::CONTAINS:
+            protocol::appendResponse(output, map.containsKey(key) ? protocol::Status::OK : protocol::Status::NOT_FOUND);
+            break;
+        default:
+            protocol::appendResponse(output, protocol::Status::BAD_REQUEST);
+    }
+}
+
+// Executes every complete request in the input buffer, returns false if the client sent a malformed header. Every
+// header is validated as soon as it arrives, so an oversized request is neither executed nor waited for.
+template <typename Map>
+bool executeAll(Map &map, Connection &connection, size_t &served) {
+    size_t offset = 0;
+    bool valid = true;
+    protocol::RequestHeader header{};
+    while (connection.input.size() - offset >= sizeof(header)) {
+        size_t length = protocol::requestLength(connection.input, offset, header);
+        if (!protocol::validRequest(header)) {
+            valid = false;
+            break;
+        }
+        if (length == 0) break;
+
+        // A failing request, e.g. one running out of memory, is answered on its own and the connection goes on
+        try {
+            execute(map, header, connection.input.data() + offset + sizeof(header), connection.output);
+        } catch (const std::exception &) {
+            protocol::appendResponse(connection.output, protocol::Status::SERVER_ERROR);
+        }
+        offset += length;
+        served++;
+    }
+
+    connection.input.erase(0, offset);
+    return valid;
+}
+
+// Reads until the socket is drained, returns false once the peer closed the connection or sent more than the input
+// buffer holds
+bool readAll(Connection &connection) {
+    char buffer[protocol::READ_SIZE];
+    while (true) {
+        ssize_t count = read(connection.fd, buffer, sizeof(buffer));
+        if (count > 0) connection.input.append(buffer, count);
+        else if (count == 0) return false;
+        else return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+        if (connection.input.size() > protocol::MAX_PENDING_INPUT) return false;
+    }
+}
+
+// Writes as much of the pending output as the socket takes, returns false on a broken connection
+bool writeAll(Connection &connection) {
+    while (connection.written < connection.output.size()) {
+        ssize_t count = write(connection.fd, connection.output.data() + connection.written,
+                              connection.output.size() - connection.written);
+        if (count > 0) connection.written += count;
+        else if (count == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+        else if (count == -1 && errno == EINTR) continue;
+        else return false;
+    }
+
+    connection.output.clear();
+    connection.written = 0;
+    return true;
+}
+
+void watch(int epoll, Connection *connection, int operation) {
+    epoll_event event{};
+    bool pending = connection->written < connection->output.size();
+    connection->reading = connection->output.size() - connection->written <= protocol::MAX_PENDING_OUTPUT;
+    event.events = (connection->reading ? EPOLLIN : 0) | (pending ? EPOLLOUT : 0) | EPOLLRDHUP;
+    event.data.ptr = connection;
+    epoll_ctl(epoll, operation, connection->fd, &event);
+}
+
+void disconnect(int epoll, Connection *connection) {
+    epoll_ctl(epoll, EPOLL_CTL_DEL, connection->fd, nullptr);
+    close(connection->fd);
+    delete connection;
+}
+
+template <typename Map>
+void loop(Map &map, int listener, bool tcp, std::atomic<size_t> &served) {
+    int epoll = epoll_create1(0);
+    epoll_event event{};
+    // Exclusive wake-ups hand every new connection to one loop instead of waking all of them
+    event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    event.data.ptr = nullptr;
+    epoll_ctl(epoll, EPOLL_CTL_ADD, listener, &event);
+
+    std::vector<epoll_event> events(256);
+    std::vector<Connection *> connections;
+    size_t count = 0;
+    while (running) {
+        int ready = epoll_wait(epoll, events.data(), static_cast<int>(events.size()), 100);
+        for (int i = 0; i < ready; i++) {
+            if (events[i].data.ptr == nullptr) {
+                int fd;
+                while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) != -1) {
+                    if (tcp) {
+                        int enable = 1;
+                        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+                    }
+                    auto *connection = new Connection{fd};
+                    connections.push_back(connection);
+                    watch(epoll, connection, EPOLL_CTL_ADD);
+                }
+                continue;
+            }
+
+            auto *connection = static_cast<Connection *>(events[i].data.ptr);
+            bool open = !(events[i].events & (EPOLLERR | EPOLLHUP));
+            if (open && (events[i].events & EPOLLIN)) {
+                open = readAll(*connection);
+                open = executeAll(map, *connection, count) && open;
+            }
+            if (open || !connection->output.empty()) open = writeAll(*connection) && open;
+
+            if (!open) {
+                connections.erase(std::find(connections.begin(), connections.end(), connection));
+                disconnect(epoll, connection);
+            } else {
+                watch(epoll, connection, EPOLL_CTL_MOD);
+            }
+        }
+    }
+
+    for (Connection *connection : connections) disconnect(epoll, connection);
+    close(epoll);
+    served += count;
+}
+
+template <typename Map>
+void serve(const protocol::Address &address, size_t loops) {
+    ShardedHashMap<std::string, std::string, Map> map;
+    int listener = protocol::openSocket(address, true);
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+    std::cout << "Serving on " << (address.local ? address.path : "port " + std::to_string(address.port))
+              << " with " << loops << " event loops and " << map.getShards() << " shards\n";
+
+    std::atomic<size_t> served(0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < loops; t++) {
+        threads.emplace_back(loop<decltype(map)>, std::ref(map), listener, !address.local, std::ref(served));
+    }
+    for (auto &thread : threads) thread.join();
+
+    close(listener);
+    if (address.local) unlink(address.path.c_str());
+    std::cout << "Served " << served << " requests, " << map.getSize() << " keys left\n";
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "Usage: " << argv[0] << " <LL|DH|RH> <unix:path|tcp:port> [event loops]\n";
+        return 1;
+    }
+
+    std::string strategy = argv[1];
+    protocol::Address address = protocol::parseAddress(argv[2]);
+    size_t loops = argc == 4 ? std::stoul(argv[3]) : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+    std::signal(SIGINT, [](int) { running = false; });
+    std::signal(SIGTERM, [](int) { running = false; });
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (strategy == "LL") serve<HashMapLL<std::string, std::string>>(address, loops);
+    else if (strategy == "DH") serve<HashMapDH<std::string, std::string>>(address, loops);
+    else if (strategy == "RH") serve<HashMapRH<std::string, std::string>>(address, loops);
+    else throw std::invalid_argument("Map strategy has to be LL, DH or RH, got " + strategy);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <Allocation.h>
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace allocation;
+
+TEST_CASE("Allocating bucket arrays on the heap", "[Allocation]") {
+    int **buckets = HeapAllocation::allocate<int *>(100);
+    for (size_t i = 0; i < 100; i++) REQUIRE(buckets[i] == nullptr);
+    HeapAllocation::deallocate(buckets, 100);
+}
+
+TEST_CASE("Allocating bucket arrays on huge pages", "[Allocation]") {
+    SECTION("Arrays smaller than a page stay on the heap") {
+        REQUIRE(HugePageAllocation::mappedBytes(constants::HUGE_PAGE_SIZE - 1) == 0);
+        REQUIRE(HugePageAllocation::mappedBytes(constants::HUGE_PAGE_SIZE + 1) == 2 * constants::HUGE_PAGE_SIZE);
+
+        int **buckets = HugePageAllocation::allocate<int *>(100);
+        for (size_t i = 0; i < 100; i++) REQUIRE(buckets[i] == nullptr);
+        HugePageAllocation::deallocate(buckets, 100);
+    }
+
+    SECTION("Large arrays are page aligned and value initialized") {
+        size_t count = 3 * constants::HUGE_PAGE_SIZE / sizeof(int *);
+        int **buckets = HugePageAllocation::allocate<int *>(count);
+        REQUIRE(reinterpret_cast<uintptr_t>(buckets) % constants::HUGE_PAGE_SIZE == 0);
+
+        size_t empty = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (buckets[i] == nullptr) empty++;
+            buckets[i] = reinterpret_cast<int *>(i);
+        }
+        REQUIRE(empty == count);
+        HugePageAllocation::deallocate(buckets, count);
+    }
+
+    SECTION("Elements of large arrays are constructed and destroyed") {
+        size_t count = constants::HUGE_PAGE_SIZE / sizeof(std::string) + 1;
+        auto *strings = HugePageAllocation::allocate<std::string>(count);
+        REQUIRE(strings[count - 1].empty());
+
+        strings[count - 1] = std::string(100, 'x');
+        REQUIRE(strings[count - 1].size() == 100);
+        HugePageAllocation::deallocate(strings, count);
+    }
+}
+
+TEST_CASE("Allocating bucket arrays with NUMA placement", "[Allocation]") {
+    size_t count = 2 * constants::HUGE_PAGE_SIZE / sizeof(size_t);
+
+    SECTION("Interleaving over allowed nodes") {
+        auto *buckets = InterleavedAllocation::allocate<size_t>(count);
+        for (size_t i = 0; i < count; i++) buckets[i] = i;
+        REQUIRE(buckets[count - 1] == count - 1);
+        InterleavedAllocation::deallocate(buckets, count);
+    }
+
+    SECTION("Binding to the first node") {
+        auto *buckets = BoundAllocation<0>::allocate<size_t>(count);
+        for (size_t i = 0; i < count; i++) buckets[i] = i;
+        REQUIRE(buckets[count - 1] == count - 1);
+        BoundAllocation<0>::deallocate(buckets, count);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory_resource>
+
+// Memory resource counting the bytes it hands out and takes back, so tests can check that every allocation of a map
+// goes through its allocator and is released again
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocated = 0;
+    size_t deallocated = 0;
+
+    void *do_allocate(size_t bytes, size_t alignment) override {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *memory, size_t bytes, size_t alignment) override {
+        deallocated += bytes;
+        std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+};
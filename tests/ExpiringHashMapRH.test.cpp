@@ -0,0 +1,150 @@
+#include <ExpiringHashMapRH.h>
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+
+// Clock moved by hand so expiry does not depend on the speed of the machine
+struct ManualClock {
+    using duration = std::chrono::nanoseconds;
+    using time_point = std::chrono::time_point<ManualClock, duration>;
+
+    static inline duration elapsed{0};
+    static time_point now() { return time_point(elapsed); }
+};
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Using ExpiringHashMapRH without expiry", "[ExpiringHashMapRH]") {
+    ExpiringHashMapRH<int, int, std::hash<int>, ManualClock> map(16);
+    ManualClock::elapsed = 0ns;
+
+    REQUIRE(map.put(1, 10) == 0);
+    REQUIRE(map.put(17, 170) == 0);
+    REQUIRE(map.put(1, 11) == 10);
+    REQUIRE(map.get(1) == 11);
+    REQUIRE(map.remove(17) == 170);
+    REQUIRE_THROWS_AS(map.get(17), std::out_of_range);
+
+    for (int i = 0; i < 1000; i++) map.put(i, 2 * i);
+    REQUIRE(map.getCapacity() > 1000);
+
+    ManualClock::elapsed = 1h;
+    for (int i = 0; i < 1000; i++) REQUIRE(map.get(i) == 2 * i);
+    REQUIRE(map.getSize() == 1000);
+}
+
+TEST_CASE("Expiring entries of ExpiringHashMapRH", "[ExpiringHashMapRH]") {
+    ExpiringHashMapRH<int, int, std::hash<int>, ManualClock> map(64);
+    ManualClock::elapsed = 0ns;
+
+    SECTION("Expired entries are missing") {
+        map.put(1, 10, 5s);
+        map.put(2, 20);
+        REQUIRE(map.get(1) == 10);
+
+        ManualClock::elapsed = 5s;
+        REQUIRE_FALSE(map.containsKey(1));
+        REQUIRE_THROWS_AS(map.get(1), std::out_of_range);
+        REQUIRE_THROWS_AS(map.remove(1), std::out_of_range);
+        REQUIRE(map.get(2) == 20);
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("Putting again renews or drops the time to live") {
+        map.put(1, 10, 5s);
+        REQUIRE(map.put(1, 11, 10s) == 10);
+
+        ManualClock::elapsed = 9s;
+        REQUIRE(map.get(1) == 11);
+        REQUIRE(map.put(1, 12) == 11);
+
+        ManualClock::elapsed = 1h;
+        REQUIRE(map.get(1) == 12);
+    }
+
+    SECTION("Times to live past the end of the clock never expire") {
+        ManualClock::elapsed = 1h;
+        map.put(1, 10, std::chrono::nanoseconds::max());
+        map.put(2, 20, std::chrono::nanoseconds::max() - 30min);
+        REQUIRE(map.get(1) == 10);
+        REQUIRE(map.get(2) == 20);
+
+        ManualClock::elapsed = std::chrono::nanoseconds::max() - 1ns;
+        REQUIRE(map.get(1) == 10);
+        REQUIRE(map.get(2) == 20);
+    }
+
+    SECTION("Lookups reclaim expired entries of their cluster") {
+        for (int i = 0; i < 5; i++) map.put(3 + 64 * i, i, i % 2 == 0 ? 1s : 1h);
+
+        ManualClock::elapsed = 1s;
+        REQUIRE(map.get(3 + 64 * 3) == 3);
+        REQUIRE(map.getSize() == 3);
+        REQUIRE(map.get(3 + 64 * 1) == 1);
+        REQUIRE_FALSE(map.containsKey(3 + 64 * 4));
+        REQUIRE(map.getSize() == 2);
+    }
+
+    SECTION("Writes sweep expired entries nobody looks up") {
+        for (int i = 0; i < 40; i++) map.put(i, i, 1s);
+
+        ManualClock::elapsed = 1s;
+        for (int i = 0; i < 16; i++) map.put(1000 + 64 * i, i);
+        REQUIRE(map.getCapacity() == 64);
+        REQUIRE(map.getSize() == 16);
+        for (int i = 0; i < 16; i++) REQUIRE(map.get(1000 + 64 * i) == i);
+    }
+
+    SECTION("Reclaimed entries make room before rehashing") {
+        for (int i = 0; i < 40; i++) map.put(i, i, 1s);
+
+        ManualClock::elapsed = 2s;
+        for (int i = 100; i < 148; i++) map.put(i, i, 1s);
+        REQUIRE(map.getCapacity() == 64);
+
+        map.put(1000, 1000, 1s);
+        map.put(1001, 1001, 1s);
+        for (int i = 100; i < 148; i++) REQUIRE(map.get(i) == i);
+        REQUIRE(map.getSize() == 50);
+    }
+
+    SECTION("Clearing") {
+        map.put(1, 10, 1s);
+        map.put(2, 20);
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE_FALSE(map.containsKey(2));
+    }
+}
+
+TEST_CASE("Moving, swapping and cloning ExpiringHashMapRH", "[ExpiringHashMapRH]") {
+    ExpiringHashMapRH<int, int, std::hash<int>, ManualClock> map(16);
+    ManualClock::elapsed = 0ns;
+    for (int i = 0; i < 10; i++) map.put(i, i * 10, 1s);
+    for (int i = 10; i < 20; i++) map.put(i, i * 10);
+
+    SECTION("Moving and swapping") {
+        ExpiringHashMapRH<int, int, std::hash<int>, ManualClock> moved(std::move(map));
+        REQUIRE(moved.getSize() == 20);
+        REQUIRE(map.isEmpty());
+
+        map.swap(moved);
+        REQUIRE(map.get(15) == 150);
+        REQUIRE(moved.isEmpty());
+    }
+
+    SECTION("Cloning keeps expiry times") {
+        ExpiringHashMapRH<int, int, std::hash<int>, ManualClock> copy = map.clone();
+        REQUIRE(copy.getSize() == 20);
+        REQUIRE(copy.get(5) == 50);
+
+        ManualClock::elapsed = 2s;
+        REQUIRE_FALSE(copy.containsKey(5));
+        REQUIRE(copy.get(15) == 150);
+        REQUIRE_FALSE(map.containsKey(5));
+
+        copy.put(15, 0);
+        REQUIRE(map.get(15) == 150);
+    }
+}
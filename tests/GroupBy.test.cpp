@@ -0,0 +1,101 @@
+#include <GroupBy.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using Rows = std::vector<std::pair<int, int>>;
+
+// Aggregates with an ordered map, one row at a time
+std::map<int, Aggregate<int>> groupNaively(const std::vector<Rows> &chunks) {
+    std::map<int, Aggregate<int>> groups;
+    for (auto &chunk : chunks) {
+        for (auto &row : chunk) groups[row.first].add(row.second);
+    }
+    return groups;
+}
+
+template <typename G>
+bool matchesNaive(G &groupBy, const std::vector<Rows> &chunks) {
+    auto expected = groupNaively(chunks);
+    if (groupBy.getGroups() != expected.size()) return false;
+
+    size_t matching = 0;
+    groupBy.forEach([&expected, &matching](const int &key, const Aggregate<int> &aggregate) {
+        auto &other = expected.at(key);
+        if (aggregate.sum == other.sum && aggregate.count == other.count && aggregate.min == other.min &&
+            aggregate.max == other.max) matching++;
+    });
+    return matching == expected.size();
+}
+
+TEST_CASE("Aggregating small chunks with GroupBy", "[GroupBy]") {
+    GroupBy<std::string, double> groupBy;
+    groupBy.add({{"a", 1.5}, {"b", 2}, {"a", -3}});
+    groupBy.add({{"c", 4}, {"a", 10}});
+    REQUIRE(groupBy.getRows() == 5);
+    REQUIRE(groupBy.getGroups() == 0);
+
+    groupBy.finish();
+    REQUIRE(groupBy.getGroups() == 3);
+
+    Aggregate<double> a = groupBy.get("a");
+    REQUIRE(a.sum == 8.5);
+    REQUIRE(a.count == 3);
+    REQUIRE(a.min == -3);
+    REQUIRE(a.max == 10);
+    REQUIRE(groupBy.get("b").count == 1);
+    REQUIRE_THROWS_AS(groupBy.get("d"), std::out_of_range);
+
+    SECTION("Rows added after finishing are merged by the next finish") {
+        groupBy.add({{"a", 20}, {"d", 1}});
+        groupBy.finish();
+        REQUIRE(groupBy.get("a").max == 20);
+        REQUIRE(groupBy.get("a").count == 4);
+        REQUIRE(groupBy.getGroups() == 4);
+    }
+
+    SECTION("Invalid parameters") {
+        REQUIRE_THROWS_AS((GroupBy<int, int>(0)), std::invalid_argument);
+        REQUIRE_THROWS_AS((GroupBy<int, int>(16, constants::GROUP_MAX_PARTITION_BITS + 1)), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Aggregating large chunks with GroupBy in parallel", "[GroupBy]") {
+    std::mt19937 rng(11);
+    std::vector<Rows> chunks(4);
+    for (auto &chunk : chunks) {
+        for (int i = 0; i < 50000; i++) {
+            chunk.push_back({static_cast<int>(rng() % 20000), static_cast<int>(rng() % 1000) - 500});
+        }
+    }
+
+    SECTION("Local maps larger than the groups") {
+        GroupBy<int, int> groupBy;
+        for (auto &chunk : chunks) groupBy.add(chunk);
+        groupBy.finish();
+        REQUIRE(groupBy.getRows() == 200000);
+        REQUIRE(matchesNaive(groupBy, chunks));
+    }
+
+    SECTION("Local maps spilled many times") {
+        GroupBy<int, int> groupBy(100, 3);
+        for (auto &chunk : chunks) groupBy.add(chunk);
+        groupBy.finish();
+        REQUIRE(matchesNaive(groupBy, chunks));
+    }
+
+    SECTION("A single partition") {
+        GroupBy<int, int> groupBy(1000, 0);
+        groupBy.add(chunks[0]);
+        groupBy.finish();
+        groupBy.add(chunks[1]);
+        groupBy.add(chunks[2]);
+        groupBy.add(chunks[3]);
+        groupBy.finish();
+        REQUIRE(matchesNaive(groupBy, chunks));
+    }
+}
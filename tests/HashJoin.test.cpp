@@ -0,0 +1,105 @@
+#include <HashJoin.h>
+#include <OpenAddressingMap.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using Join = HashJoin<int, std::string, int>;
+
+// Joins with a nested loop, the order of matches follows the probe side and then the build side
+std::vector<std::pair<std::string, int>> joinNaively(const std::vector<Join::BuildRow> &build,
+                                                     const std::vector<Join::ProbeRow> &probe) {
+    std::vector<std::pair<std::string, int>> matches;
+    std::multimap<int, std::string> byKey;
+    for (auto &row : build) byKey.insert({row.first, row.second});
+    for (auto &row : probe) {
+        auto range = byKey.equal_range(row.first);
+        for (auto it = range.first; it != range.second; it++) matches.push_back({it->second, row.second});
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+template <typename J>
+std::vector<std::pair<std::string, int>> joinWith(J &join, const std::vector<Join::BuildRow> &build,
+                                                  const std::vector<Join::ProbeRow> &probe, size_t &batches) {
+    std::vector<std::pair<std::string, int>> matches;
+    std::mutex mutex;
+    size_t count = join.join(build, probe, [&matches, &mutex, &batches](const std::vector<typename J::Match> &batch) {
+        std::lock_guard<std::mutex> lock(mutex);
+        batches++;
+        for (auto &match : batch) {
+            REQUIRE(match.build->first == match.probe->first);
+            matches.push_back({match.build->second, match.probe->second});
+        }
+    });
+    REQUIRE(count == matches.size());
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+TEST_CASE("Joining small relations with HashJoin", "[HashJoin]") {
+    std::vector<Join::BuildRow> build = {{1, "a"}, {2, "b"}, {2, "c"}, {3, "d"}, {5, "e"}};
+    std::vector<Join::ProbeRow> probe = {{2, 20}, {3, 30}, {4, 40}, {2, 21}, {5, 50}, {6, 60}};
+    size_t batches = 0;
+
+    SECTION("Duplicate keys on both sides are all matched") {
+        Join join;
+        auto matches = joinWith(join, build, probe, batches);
+        REQUIRE(join.getPartitionBits() == 0);
+        REQUIRE(matches == joinNaively(build, probe));
+        REQUIRE(matches.size() == 6);
+        REQUIRE(batches == 1);
+    }
+
+    SECTION("Matches are emitted in batches of given size") {
+        Join join(2, 2);
+        auto matches = joinWith(join, build, probe, batches);
+        REQUIRE(matches == joinNaively(build, probe));
+        REQUIRE(batches >= 3);
+    }
+
+    SECTION("Empty relations give no matches") {
+        Join join(3);
+        REQUIRE(joinWith(join, {}, probe, batches).empty());
+        REQUIRE(joinWith(join, build, {}, batches).empty());
+        REQUIRE(batches == 0);
+    }
+
+    SECTION("Invalid parameters") {
+        REQUIRE_THROWS_AS(Join(constants::JOIN_MAX_PARTITION_BITS + 1), std::invalid_argument);
+        REQUIRE_THROWS_AS(Join(2, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Joining large relations with HashJoin in parallel", "[HashJoin]") {
+    std::mt19937 rng(7);
+    std::vector<Join::BuildRow> build;
+    std::vector<Join::ProbeRow> probe;
+    for (int i = 0; i < 100000; i++) build.push_back({static_cast<int>(rng() % 80000), std::to_string(i)});
+    for (int i = 0; i < 100000; i++) probe.push_back({static_cast<int>(rng() % 160000), i});
+    size_t batches = 0;
+
+    SECTION("Partitions are picked from the size of the build side") {
+        Join join;
+        auto matches = joinWith(join, build, probe, batches);
+        REQUIRE(join.getPartitionBits() > 0);
+        REQUIRE(matches == joinNaively(build, probe));
+    }
+
+    SECTION("More partitions than needed give the same matches") {
+        Join join(constants::JOIN_MAX_PARTITION_BITS);
+        REQUIRE(joinWith(join, build, probe, batches) == joinNaively(build, probe));
+    }
+
+    SECTION("Partitions are joined with flat tables too") {
+        HashJoin<int, std::string, int, std::hash<int>, OpenAddressingMap<int, size_t>> join;
+        REQUIRE(joinWith(join, build, probe, batches) == joinNaively(build, probe));
+    }
+}
@@ -0,0 +1,261 @@
+#include <HashMapCK.h>
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+HashMapCK<int, int> *map;
+
+struct ConstantHash {
+    size_t operator()(int) const { return 7; }
+};
+
+TEST_CASE("Creating HashMapCK of given capacities and load factors", "[HashMapCK]") {
+    SECTION("Using default capacity") {
+        map = new HashMapCK<int, int>();
+        REQUIRE(map->isEmpty());
+        REQUIRE(map->getCapacity() == 32);
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Setting the HashMapCK capacity equal to 128") {
+        map = new HashMapCK<int, int>(128);
+        REQUIRE(map->getCapacity() == 128);
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Setting the HashMapCK capacity equal to 64 and load factor equal to 0.5") {
+        map = new HashMapCK<int, int>(64, 0.5f);
+        REQUIRE(map->getCapacity() == 64);
+        REQUIRE(map->getLoadFactor() == 0.5f);
+    }
+
+    SECTION("Rounding the HashMapCK capacity up to whole buckets") {
+        map = new HashMapCK<int, int>(10);
+        REQUIRE(map->getCapacity() == 12);
+    }
+}
+
+TEST_CASE("Adding and getting elements from HashMapCK", "[HashMapCK]") {
+    map = new HashMapCK<int, int>();
+
+    SECTION("Adding non existing keys") {
+        map->put(1, 100);
+        map->put(2, 200);
+
+        REQUIRE_FALSE(map->isEmpty());
+        REQUIRE(map->getSize() == 2);
+        REQUIRE(map->get(1) == 100);
+        REQUIRE(map->get(2) == 200);
+    }
+
+    SECTION("Checking returns when adding non existing/existing keys") {
+        REQUIRE(map->put(1, 100) == 0);
+        REQUIRE(map->put(1, 1000) == 100);
+    }
+
+    SECTION("Checking handling collisions") {
+        map->put(1, 100);
+        map->put(9, 900);
+        map->put(17, 1700);
+        map->put(25, 2500);
+        map->put(33, 3300);
+        map->put(41, 4100);
+
+        REQUIRE(map->get(1) == 100);
+        REQUIRE(map->get(9) == 900);
+        REQUIRE(map->get(17) == 1700);
+        REQUIRE(map->get(25) == 2500);
+        REQUIRE(map->get(33) == 3300);
+        REQUIRE(map->get(41) == 4100);
+    }
+
+    SECTION("Exception when getting non existing elements") {
+        REQUIRE_THROWS_AS(map->get(1), std::out_of_range);
+        REQUIRE_THROWS_AS(map->get(200), std::out_of_range);
+    }
+
+    SECTION("Adding elements after clearing HashMapCK") {
+        map->put(1, 100);
+        map->put(33, 1000);
+        map->put(2, 200);
+        map->clear();
+
+        map->put(1, 100);
+        REQUIRE(map->get(1) == 100);
+
+        map->put(33, 1000);
+        REQUIRE(map->get(33) == 1000);
+    }
+}
+
+TEST_CASE("Removing from HashMapCK", "[HashMapCK]") {
+    map = new HashMapCK<int, int>();
+    map->put(1, 100);
+    map->put(2, 200);
+    map->put(3, 300);
+
+    map->put(33, 1000);
+    map->put(65, 10000);
+
+    SECTION("Elements that did not cause a collision") {
+        REQUIRE(map->getSize() == 5);
+        map->remove(2);
+        map->remove(3);
+
+        REQUIRE_FALSE(map->containsKey(2));
+        REQUIRE_FALSE(map->containsKey(3));
+        REQUIRE(map->getSize() == 3);
+    }
+
+    SECTION("Elements that did cause a collision") {
+        map->remove(1);
+        REQUIRE_FALSE(map->containsKey(1));
+        REQUIRE(map->get(33) == 1000);
+
+        map->put(1, 100);
+        map->remove(65);
+        REQUIRE_FALSE(map->containsKey(65));
+
+        map->remove(1);
+        REQUIRE_FALSE(map->containsKey(1));
+        REQUIRE(map->get(33) == 1000);
+    }
+
+    SECTION("Clearing all elements in HashMapCK") {
+        map->clear();
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Removing elements that does not exist") {
+        REQUIRE_THROWS_AS(map->remove(1000), std::out_of_range);
+        REQUIRE_THROWS_AS(map->remove(5000), std::out_of_range);
+    }
+}
+
+TEST_CASE("Rehashing HashMapCK after exceeded threshold", "[HashMapCK]") {
+    map = new HashMapCK<int, int>(8);
+    map->put(1, 100);
+    map->put(2, 200);
+    map->put(3, 300);
+    map->put(4, 400);
+
+    SECTION("Rehashing without collisions") {
+        map->put(5, 500);
+        map->put(6, 600);
+        map->put(7, 700);
+
+        REQUIRE(map->getCapacity() == 16);
+        REQUIRE(map->getSize() == 7);
+        REQUIRE(map->containsKey(4));
+        REQUIRE(map->get(4) == 400);
+    }
+
+    SECTION("Rehashing when displacement fails") {
+        auto *full = new HashMapCK<int, int>(8, 1.0f);
+        for (int i = 0; i < 64; i++) full->put(i * 2, i);
+
+        REQUIRE(full->getCapacity() >= 64);
+        REQUIRE(full->getSize() == 64);
+        for (int i = 0; i < 64; i++) REQUIRE(full->get(i * 2) == i);
+        delete full;
+    }
+}
+
+TEST_CASE("Flooding HashMapCK with keys of one hash", "[HashMapCK]") {
+    HashMapCK<int, int, ConstantHash> flooded(8);
+    size_t fitting = 2 * constants::CUCKOO_BUCKET_SLOTS;
+    for (size_t i = 0; i < fitting; i++) flooded.put(static_cast<int>(i), static_cast<int>(i) * 10);
+
+    SECTION("Giving up instead of growing without bound") {
+        size_t capacity = flooded.getCapacity();
+        REQUIRE_THROWS_AS(flooded.put(-1, -10), std::length_error);
+        REQUIRE(flooded.getCapacity() == capacity);
+        REQUIRE(flooded.getSize() == fitting);
+        REQUIRE_FALSE(flooded.containsKey(-1));
+        for (size_t i = 0; i < fitting; i++) REQUIRE(flooded.get(static_cast<int>(i)) == static_cast<int>(i) * 10);
+    }
+
+    SECTION("Giving up when the table is due to grow") {
+        HashMapCK<int, int, ConstantHash> full(8, 1.0f);
+        for (size_t i = 0; i < fitting; i++) full.put(static_cast<int>(i), static_cast<int>(i));
+
+        REQUIRE_THROWS_AS(full.put(-1, -1), std::length_error);
+        REQUIRE(full.getCapacity() == 8);
+        REQUIRE(full.getSize() == fitting);
+        REQUIRE_FALSE(full.containsKey(-1));
+    }
+
+    SECTION("Staying usable after giving up") {
+        REQUIRE_THROWS_AS(flooded.put(-1, -10), std::length_error);
+        REQUIRE(flooded.remove(0) == 0);
+        REQUIRE(flooded.put(-1, -10) == 0);
+        REQUIRE(flooded.get(-1) == -10);
+        REQUIRE(flooded.getSize() == fitting);
+    }
+}
+
+TEST_CASE("Filling HashMapCK up to high load factor", "[HashMapCK]") {
+    map = new HashMapCK<int, int>(4096, 0.95f);
+    std::mt19937 rng(42);
+    std::vector<int> keys;
+    for (int i = 0; i < 3800; i++) keys.push_back(static_cast<int>(rng() >> 1));
+    for (int i = 0; i < 3800; i++) map->put(keys[i], i);
+
+    REQUIRE(map->getSize() == 3800);
+    REQUIRE(map->getCapacity() == 4096);
+    for (int i = 0; i < 3800; i++) REQUIRE(map->get(keys[i]) == i);
+    REQUIRE_FALSE(map->containsKey(-1));
+}
+
+TEST_CASE("Moving, swapping and cloning HashMapCK", "[HashMapCK]") {
+    HashMapCK<int, int> hashMap;
+    for (int i = 1; i <= 100; i++) hashMap.put(i, i * 10);
+    size_t capacity = hashMap.getCapacity();
+
+    SECTION("Moving leaves the source empty and usable") {
+        HashMapCK<int, int> moved(std::move(hashMap));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(moved.getCapacity() == capacity);
+        REQUIRE(moved.get(100) == 1000);
+        REQUIRE(hashMap.isEmpty());
+
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        hashMap = std::move(moved);
+        REQUIRE(hashMap.getSize() == 100);
+        REQUIRE(hashMap.get(1) == 10);
+    }
+
+    SECTION("Swapping exchanges whole tables") {
+        HashMapCK<int, int> other;
+        other.put(-1, -10);
+        hashMap.swap(other);
+
+        REQUIRE(hashMap.getSize() == 1);
+        REQUIRE(hashMap.get(-1) == -10);
+        REQUIRE(other.getSize() == 100);
+        REQUIRE(other.getCapacity() == capacity);
+        REQUIRE(other.get(42) == 420);
+    }
+
+    SECTION("Cloning gives an independent copy of the same layout") {
+        HashMapCK<int, int> copy = hashMap.clone();
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.getCapacity() == capacity);
+
+        copy.put(1, -1);
+        copy.remove(2);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 20);
+
+        size_t found = 0;
+        for (int i = 3; i <= 100; i++) {
+            if (copy.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 98);
+        REQUIRE(copy.get(1) == -1);
+        REQUIRE_FALSE(copy.containsKey(2));
+    }
+}
@@ -1,4 +1,13 @@
 #include <HashMapDH.h>
+#include "CountingResource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -58,6 +67,16 @@ TEST_CASE("Adding and getting elements from HashMapDH", "[HashMapDH]") {
         REQUIRE_THROWS_AS(map->get(200), std::out_of_range);
     }
 
+    SECTION("Finding existing and non existing elements") {
+        map->put(1, 100);
+        map->put(33, 1000);
+
+        REQUIRE(*map->find(33) == 1000);
+        REQUIRE(map->find(65) == nullptr);
+        *map->find(1) = 101;
+        REQUIRE(map->get(1) == 101);
+    }
+
     SECTION("Adding elements after clearing HashMapDH") {
         map->put(1, 100);
         map->put(33, 1000);
@@ -113,6 +132,16 @@ TEST_CASE("Removing from HashMapDH", "[HashMapDH]") {
         REQUIRE_THROWS_AS(map->remove(1000), std::out_of_range);
         REQUIRE_THROWS_AS(map->remove(5000), std::out_of_range);
     }
+
+    SECTION("Trying to remove existing and non existing elements") {
+        int value = 0;
+        REQUIRE(map->tryRemove(33, value));
+        REQUIRE(value == 1000);
+        REQUIRE_FALSE(map->tryRemove(33, value));
+        REQUIRE_FALSE(map->tryRemove(5000, value));
+        REQUIRE(value == 1000);
+        REQUIRE(map->getSize() == 4);
+    }
 }
 
 TEST_CASE("", "[HashMapDH]") {
@@ -141,6 +170,15 @@ TEST_CASE("", "[HashMapDH]") {
     }
 }
 
+TEST_CASE("Storing strings in HashMapDH", "[HashMapDH]") {
+    HashMapDH<std::string, std::string> hashMap;
+    REQUIRE(hashMap.put("a", "first").empty());
+    REQUIRE(hashMap.put("a", "second") == "first");
+    for (int i = 0; i < 100; i++) hashMap.put("key-" + std::to_string(i), std::to_string(i));
+    REQUIRE(hashMap.get("key-42") == "42");
+    REQUIRE(hashMap.remove("a") == "second");
+}
+
 TEST_CASE("Rehashing HashMapDH after exceeded threshold", "[HashMapDH]") {
     map = new HashMapDH<int, int>(6);
     map->put(1, 100);
@@ -169,4 +207,437 @@ TEST_CASE("Rehashing HashMapDH after exceeded threshold", "[HashMapDH]") {
         REQUIRE(map->containsKey(65));
         REQUIRE(map->get(65) == 650);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Rehashing large HashMapDH in parallel", "[HashMapDH]") {
+    auto *large = new HashMapDH<int, int>(1024);
+    std::mt19937 rng(42);
+    std::vector<int> keys;
+    for (int i = 0; i < 200000; i++) keys.push_back(static_cast<int>(rng() >> 1));
+    for (int i = 0; i < 200000; i++) large->put(keys[i], i);
+
+    size_t found = 0;
+    for (int i = 0; i < 200000; i++) {
+        if (large->get(keys[i]) == i) found++;
+    }
+    REQUIRE(large->getSize() == found);
+    REQUIRE(large->getCapacity() > 262144);
+    REQUIRE_FALSE(large->containsKey(-1));
+    delete large;
+}
+
+TEST_CASE("Building HashMapDH from a range of pairs", "[HashMapDH]") {
+    std::vector<std::pair<int, int>> pairs = {{1, 10}, {2, 20}, {3, 30}, {2, 25}, {33, 330}};
+
+    SECTION("Constructing from range keeps the last value of duplicate keys") {
+        HashMapDH<int, int> hashMap(pairs.begin(), pairs.end());
+        REQUIRE(hashMap.getSize() == 4);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 25);
+        REQUIRE(hashMap.get(33) == 330);
+        REQUIRE_FALSE(hashMap.containsKey(4));
+    }
+
+    SECTION("Constructing from a range without random access") {
+        std::list<std::pair<int, int>> listed;
+        for (int i = 1; i <= 50000; i++) listed.emplace_back(i, i * 2);
+
+        HashMapDH<int, int> hashMap(listed.begin(), listed.end());
+        REQUIRE(hashMap.getSize() == 50000);
+
+        size_t found = 0;
+        for (int i = 1; i <= 50000; i++) {
+            if (hashMap.get(i) == i * 2) found++;
+        }
+        REQUIRE(found == 50000);
+    }
+
+    SECTION("Building into non empty map") {
+        HashMapDH<int, int> hashMap;
+        hashMap.put(3, 1);
+        hashMap.put(7, 70);
+        hashMap.buildFrom(pairs.begin(), pairs.end());
+        REQUIRE(hashMap.getSize() == 5);
+        REQUIRE(hashMap.get(3) == 30);
+        REQUIRE(hashMap.get(7) == 70);
+    }
+
+    SECTION("Building large map sizes the table once") {
+        std::vector<std::pair<int, int>> large;
+        for (int i = 0; i < 100000; i++) large.emplace_back(static_cast<int>(((i + 1) * 2654435761u) & 0x7fffffff), i);
+
+        HashMapDH<int, int> hashMap(large.begin(), large.end(), 0.5f);
+        size_t capacity = hashMap.getCapacity();
+        REQUIRE(capacity * 0.5f >= large.size());
+
+        size_t found = 0;
+        for (int i = 0; i < 100000; i++) {
+            if (hashMap.get(large[i].first) == i) found++;
+        }
+        REQUIRE(found == 100000);
+
+        for (int i = 0; i < 100000; i += 2) hashMap.remove(large[i].first);
+        found = 0;
+        for (int i = 1; i < 100000; i += 2) {
+            if (hashMap.get(large[i].first) == i) found++;
+        }
+        REQUIRE(found == 50000);
+        REQUIRE(hashMap.getCapacity() == capacity);
+    }
+}
+
+TEST_CASE("Rehashing HashMapDH backed by huge pages", "[HashMapDH]") {
+    HashMapDH<int, int, std::hash<int>, allocation::HugePageAllocation> hashMap(262144);
+    for (int i = 1; i <= 250000; i++) hashMap.put(i, 2 * i);
+    REQUIRE(hashMap.getCapacity() > 262144);
+
+    size_t found = 0;
+    for (int i = 1; i <= 250000; i++) {
+        if (hashMap.get(i) == 2 * i) found++;
+    }
+    REQUIRE(found == 250000);
+    REQUIRE_FALSE(hashMap.containsKey(-1));
+
+    for (int i = 1; i <= 250000; i += 2) hashMap.remove(i);
+    REQUIRE(hashMap.getSize() == 125000);
+}
+
+TEST_CASE("Updating HashMapDH values in place", "[HashMapDH]") {
+    HashMapDH<int, int> hashMap;
+
+    SECTION("Counting keys with operator[] and upsert") {
+        for (int i = 1; i <= 5000; i++) {
+            hashMap[i % 700 + 1]++;
+            hashMap.upsert(i % 300 + 1000, [](int &count) { count += 2; });
+        }
+        REQUIRE(hashMap.getSize() == 1000);
+        REQUIRE(hashMap.get(1) == 7);
+        REQUIRE(hashMap.get(700) == 7);
+        REQUIRE(hashMap.get(1000) == 2 * 16);
+        REQUIRE(hashMap.get(1299) == 2 * 16);
+    }
+
+    SECTION("Computing only absent values") {
+        int calls = 0;
+        auto factory = [&calls]() { return ++calls * 100; };
+        REQUIRE(hashMap.computeIfAbsent(3, factory) == 100);
+        REQUIRE(hashMap.computeIfAbsent(3, factory) == 100);
+        REQUIRE(hashMap.computeIfAbsent(4, factory) == 200);
+        REQUIRE(calls == 2);
+        REQUIRE(hashMap.getSize() == 2);
+    }
+
+    SECTION("Merging values distinguishes absent from zero") {
+        auto sum = [](int current, int value) { return current + value; };
+        REQUIRE(hashMap.merge(5, 0, sum) == 0);
+        REQUIRE(hashMap.merge(5, 7, sum) == 7);
+        REQUIRE(hashMap.merge(5, 7, sum) == 14);
+        REQUIRE(hashMap.get(5) == 14);
+    }
+
+    SECTION("Writing through returned reference across rehashes") {
+        for (int i = 1; i <= 2000; i++) hashMap[i] = i * 3;
+        REQUIRE(hashMap.getCapacity() > 2000);
+
+        size_t found = 0;
+        for (int i = 1; i <= 2000; i++) {
+            if (hashMap.get(i) == i * 3) found++;
+        }
+        REQUIRE(found == 2000);
+    }
+}
+
+struct CollidingHash {
+    size_t operator()(const int &key) const { return 7; }
+};
+
+TEST_CASE("Observing HashMapDH events", "[HashMapDH]") {
+    SECTION("Reporting reuse of removed slots") {
+        HashMapDH<int, int, std::hash<int>, allocation::HeapAllocation, CountingObserver<>> hashMap(11);
+        for (int i = 1; i <= 5; i++) hashMap.put(i, i);
+        hashMap.remove(2);
+        hashMap.remove(3);
+
+        hashMap.put(2, 20);
+        hashMap[3] = 30;
+        REQUIRE(hashMap.get(2) == 20);
+        REQUIRE(hashMap.get(3) == 30);
+        REQUIRE(hashMap.getObserver().getTombstoneReuses() == 2);
+
+        std::vector<size_t> slots;
+        hashMap.getObserver().forEachEvent([&slots](const CountingObserver<>::Event &event) {
+            if (event.kind == CountingObserver<>::Kind::TOMBSTONE_REUSE) slots.push_back(event.first);
+        });
+        REQUIRE((slots == std::vector<size_t>{2, 3}));
+    }
+
+    SECTION("Reporting long probe sequences") {
+        HashMapDH<int, int, CollidingHash, allocation::HeapAllocation, CountingObserver<2>> hashMap(11);
+        for (int i = 1; i <= 5; i++) hashMap.put(i, i);
+        auto &observer = hashMap.getObserver();
+        observer.reset();
+
+        REQUIRE(hashMap.get(2) == 2);
+        REQUIRE(observer.getLongProbes() == 0);
+        REQUIRE(hashMap.get(5) == 5);
+        REQUIRE_FALSE(hashMap.containsKey(6));
+        REQUIRE(observer.getLongProbes() == 2);
+        REQUIRE(observer.getLongestProbe() == 5);
+    }
+}
+
+TEST_CASE("Erasing matching entries from HashMapDH", "[HashMapDH]") {
+    HashMapDH<int, int> hashMap(11);
+    for (int i = 1; i <= 1000; i++) hashMap.put(i, i * 10);
+    size_t capacity = hashMap.getCapacity();
+
+    SECTION("Erasing a few entries leaves the rest reachable past their slots") {
+        REQUIRE(hashMap.eraseIf([](const int &key, const int &) { return key % 10 == 0; }) == 100);
+        REQUIRE(hashMap.getSize() == 900);
+        REQUIRE(hashMap.getCapacity() == capacity);
+
+        size_t found = 0;
+        for (int i = 1; i <= 1000; i++) {
+            if (i % 10 == 0) REQUIRE_FALSE(hashMap.containsKey(i));
+            else if (hashMap.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 900);
+    }
+
+    SECTION("Erasing most entries clears removed slots in place") {
+        REQUIRE(hashMap.eraseIf([](const int &, const int &value) { return value > 1000; }) == 900);
+        REQUIRE(hashMap.getSize() == 100);
+        REQUIRE(hashMap.getCapacity() == capacity);
+
+        size_t found = 0;
+        for (int i = 1; i <= 100; i++) {
+            if (hashMap.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 100);
+        REQUIRE_FALSE(hashMap.containsKey(500));
+
+        for (int i = 101; i <= 1000; i++) hashMap.put(i, i);
+        REQUIRE(hashMap.getSize() == 1000);
+        REQUIRE(hashMap.getCapacity() == capacity);
+        REQUIRE(hashMap.get(1000) == 1000);
+    }
+}
+
+TEST_CASE("Moving, swapping and cloning HashMapDH", "[HashMapDH]") {
+    HashMapDH<int, int> hashMap;
+    for (int i = 1; i <= 100; i++) hashMap.put(i, i * 10);
+    size_t capacity = hashMap.getCapacity();
+
+    SECTION("Moving leaves the source empty and usable") {
+        HashMapDH<int, int> moved(std::move(hashMap));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(moved.getCapacity() == capacity);
+        REQUIRE(moved.get(100) == 1000);
+        REQUIRE(hashMap.isEmpty());
+
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        hashMap = std::move(moved);
+        REQUIRE(hashMap.getSize() == 100);
+        REQUIRE(hashMap.get(1) == 10);
+    }
+
+    SECTION("Swapping exchanges whole tables") {
+        HashMapDH<int, int> other;
+        other.put(-1, -10);
+        hashMap.swap(other);
+
+        REQUIRE(hashMap.getSize() == 1);
+        REQUIRE(hashMap.get(-1) == -10);
+        REQUIRE(other.getSize() == 100);
+        REQUIRE(other.getCapacity() == capacity);
+        REQUIRE(other.get(42) == 420);
+    }
+
+    SECTION("Cloning gives an independent copy of the same layout") {
+        HashMapDH<int, int> copy = hashMap.clone();
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.getCapacity() == capacity);
+
+        copy.put(1, -1);
+        copy.remove(2);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 20);
+
+        size_t found = 0;
+        for (int i = 3; i <= 100; i++) {
+            if (copy.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 98);
+        REQUIRE(copy.get(1) == -1);
+        REQUIRE_FALSE(copy.containsKey(2));
+    }
+
+    SECTION("Cloning keeps removed slots reusable") {
+        for (int i = 1; i <= 50; i++) hashMap.remove(i);
+        HashMapDH<int, int> copy = hashMap.clone();
+        REQUIRE(copy.getSize() == 50);
+
+        for (int i = 1; i <= 50; i++) copy.put(i, -i);
+        REQUIRE(copy.getCapacity() == capacity);
+        REQUIRE(copy.get(50) == -50);
+        REQUIRE(copy.get(51) == 510);
+        REQUIRE_FALSE(hashMap.containsKey(50));
+    }
+}
+
+TEST_CASE("Filtering lookups of HashMapDH", "[HashMapDH]") {
+    using FilteredMap = HashMapDH<int, int, std::hash<int>, allocation::HeapAllocation, NoObserver, BlockedBloomFilter<>>;
+    FilteredMap hashMap;
+    for (int i = 1; i <= 1000; i++) hashMap.put(i, i * 10);
+
+    SECTION("Present keys pass the filter") {
+        size_t found = 0;
+        for (int i = 1; i <= 1000; i++) {
+            if (hashMap.containsKey(i) && hashMap.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 1000);
+
+        size_t missing = 0;
+        for (int i = 1001; i <= 11000; i++) missing += !hashMap.containsKey(i);
+        REQUIRE(missing == 10000);
+        REQUIRE_THROWS_AS(hashMap.get(5000), std::out_of_range);
+        REQUIRE_THROWS_AS(hashMap.remove(5000), std::out_of_range);
+    }
+
+    SECTION("Removed keys stop passing once the filter is rebuilt") {
+        for (int i = 1; i <= 1000; i += 2) hashMap.remove(i);
+        hashMap.eraseIf([](const int &key, const int &) { return key % 4 == 0; });
+        REQUIRE(hashMap.getSize() == 250);
+
+        size_t found = 0;
+        for (int i = 1; i <= 1000; i++) {
+            if (hashMap.containsKey(i)) found++;
+        }
+        REQUIRE(found == 250);
+
+        hashMap[2] += 1;
+        hashMap.merge(4, 1, [](int a, int b) { return a + b; });
+        REQUIRE(hashMap.get(2) == 21);
+        REQUIRE(hashMap.get(4) == 1);
+    }
+
+    SECTION("Clones, swaps and clears carry the filter along") {
+        FilteredMap copy = hashMap.clone();
+        FilteredMap other;
+        other.swap(copy);
+        REQUIRE(other.get(1000) == 10000);
+        REQUIRE(copy.isEmpty());
+        REQUIRE_FALSE(copy.containsKey(1000));
+
+        hashMap.clear();
+        REQUIRE_FALSE(hashMap.containsKey(1));
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        REQUIRE(other.getSize() == 1000);
+    }
+}
+
+TEST_CASE("Allocating HashMapDH from a memory resource", "[HashMapDH]") {
+    CountingResource counting;
+
+    SECTION("Every allocation is given back to the resource") {
+        {
+            HashMapDH<int, int, std::hash<int>, allocation::ResourceAllocation> hashMap(16, 0.75, &counting);
+            for (int i = 1; i <= 1000; i++) hashMap.put(i, i);
+            for (int i = 1; i <= 1000; i += 2) hashMap.remove(i);
+            hashMap[2002] += 1;
+            hashMap.eraseIf([](const int &key, const int &) { return key % 4 == 0; });
+
+            HashMapDH<int, int, std::hash<int>, allocation::ResourceAllocation> copy = hashMap.clone();
+            REQUIRE(copy.getSize() == hashMap.getSize());
+            REQUIRE(copy.get(2002) == 1);
+
+            hashMap.clear();
+            REQUIRE(hashMap.isEmpty());
+            REQUIRE(copy.get(2) == 2);
+            REQUIRE(counting.allocated > counting.deallocated);
+        }
+        REQUIRE(counting.allocated > 0);
+        REQUIRE(counting.deallocated == counting.allocated);
+    }
+
+    SECTION("A monotonic resource releases everything at once") {
+        std::pmr::monotonic_buffer_resource arena(&counting);
+        {
+            HashMapDH<int, int, std::hash<int>, allocation::ResourceAllocation> hashMap(16, 0.75, &arena);
+            for (int i = 1; i <= 1000; i++) hashMap.put(i, i * 2);
+
+            size_t found = 0;
+            for (int i = 1; i <= 1000; i++) {
+                if (hashMap.get(i) == i * 2) found++;
+            }
+            REQUIRE(found == 1000);
+
+            hashMap.clear();
+            REQUIRE(hashMap.isEmpty());
+            REQUIRE_FALSE(hashMap.containsKey(1));
+
+            hashMap.put(1, 1);
+            REQUIRE(hashMap.get(1) == 1);
+            REQUIRE(hashMap.getSize() == 1);
+        }
+        REQUIRE(counting.deallocated == 0);
+
+        arena.release();
+        REQUIRE(counting.deallocated == counting.allocated);
+    }
+}
+
+TEST_CASE("Scanning HashMapDH in parallel", "[HashMapDH]") {
+    HashMapDH<int, long long> hashMap;
+    for (int i = 1; i <= 100000; i++) hashMap.put(i, i);
+
+    SECTION("Reducing entries") {
+        auto sum = hashMap.parallelReduce(0LL, [](long long acc, const int &, const long long &value) {
+            return acc + value;
+        }, [](long long a, long long b) { return a + b; });
+        REQUIRE(sum == 100000LL * 100001 / 2);
+
+        int max = hashMap.parallelReduce(0, [](int acc, const int &key, const long long &) {
+            return std::max(acc, key);
+        }, [](int a, int b) { return std::max(a, b); });
+        REQUIRE(max == 100000);
+    }
+
+    SECTION("Reducing entries to a flag") {
+        bool found = hashMap.parallelReduce(false, [](bool acc, const int &key, const long long &) {
+            return acc || key == 77777;
+        }, [](bool a, bool b) { return a || b; });
+        REQUIRE(found);
+
+        bool positive = hashMap.parallelReduce(true, [](bool acc, const int &, const long long &value) {
+            return acc && value > 0;
+        }, [](bool a, bool b) { return a && b; });
+        REQUIRE(positive);
+    }
+
+    SECTION("Visiting every entry once") {
+        std::atomic<size_t> visited{0};
+        std::atomic<long long> keys{0};
+        hashMap.parallelForEach([&visited, &keys](const int &key, const long long &) {
+            visited++;
+            keys += key;
+        });
+        REQUIRE(visited == 100000);
+        REQUIRE(keys == 100000LL * 100001 / 2);
+    }
+
+    SECTION("Visiting and updating every entry on one thread") {
+        hashMap.forEach([](const int &, long long &value) { value = -value; });
+        long long sum = 0;
+        hashMap.forEach([&sum](const int &, const long long &value) { sum += value; });
+        REQUIRE(sum == -100000LL * 100001 / 2);
+    }
+
+    SECTION("An empty map reduces to the identity") {
+        hashMap.clear();
+        REQUIRE(hashMap.parallelReduce(0, [](int acc, const int &, const long long &) { return acc + 1; },
+                                       [](int a, int b) { return a + b; }) == 0);
+    }
+}
@@ -0,0 +1,252 @@
+#include <HashMapHS.h>
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+HashMapHS<int, int> *map;
+
+struct ConstantHash {
+    size_t operator()(int) const { return 7; }
+};
+
+TEST_CASE("Creating HashMapHS of given capacities and load factors", "[HashMapHS]") {
+    SECTION("Using default capacity") {
+        map = new HashMapHS<int, int>();
+        REQUIRE(map->isEmpty());
+        REQUIRE(map->getCapacity() == 32);
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Setting the HashMapHS capacity equal to 128") {
+        map = new HashMapHS<int, int>(128);
+        REQUIRE(map->getCapacity() == 128);
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Setting the HashMapHS capacity equal to 64 and load factor equal to 0.5") {
+        map = new HashMapHS<int, int>(64, 0.5f);
+        REQUIRE(map->getCapacity() == 64);
+        REQUIRE(map->getLoadFactor() == 0.5f);
+    }
+}
+
+TEST_CASE("Adding and getting elements from HashMapHS", "[HashMapHS]") {
+    map = new HashMapHS<int, int>();
+
+    SECTION("Adding non existing keys") {
+        map->put(1, 100);
+        map->put(2, 200);
+
+        REQUIRE_FALSE(map->isEmpty());
+        REQUIRE(map->getSize() == 2);
+        REQUIRE(map->get(1) == 100);
+        REQUIRE(map->get(2) == 200);
+    }
+
+    SECTION("Checking returns when adding non existing/existing keys") {
+        REQUIRE(map->put(1, 100) == 0);
+        REQUIRE(map->put(1, 1000) == 100);
+    }
+
+    SECTION("Checking handling collisions") {
+        map->put(1, 100);
+        map->put(33, 1000);
+        map->put(65, 10000);
+        map->put(129, 100000);
+
+        map->put(31, 120);
+        map->put(63, 140);
+
+        map->put(2, 200);
+
+        REQUIRE(map->get(1) == 100);
+        REQUIRE(map->get(33) == 1000);
+        REQUIRE(map->get(65) == 10000);
+        REQUIRE(map->get(129) == 100000);
+
+        REQUIRE(map->get(31) == 120);
+        REQUIRE(map->get(63) == 140);
+
+        REQUIRE(map->get(2) == 200);
+    }
+
+    SECTION("Exception when getting non existing elements") {
+        REQUIRE_THROWS_AS(map->get(1), std::out_of_range);
+        REQUIRE_THROWS_AS(map->get(200), std::out_of_range);
+    }
+
+    SECTION("Adding elements after clearing HashMapHS") {
+        map->put(1, 100);
+        map->put(33, 1000);
+        map->put(2, 200);
+        map->clear();
+
+        map->put(1, 100);
+        REQUIRE(map->get(1) == 100);
+
+        map->put(33, 1000);
+        REQUIRE(map->get(33) == 1000);
+    }
+}
+
+TEST_CASE("Removing from HashMapHS", "[HashMapHS]") {
+    map = new HashMapHS<int, int>();
+    map->put(1, 100);
+    map->put(2, 200);
+    map->put(3, 300);
+
+    map->put(33, 1000);
+    map->put(65, 10000);
+
+    SECTION("Elements that did not cause a collision") {
+        REQUIRE(map->getSize() == 5);
+        map->remove(2);
+        map->remove(3);
+
+        REQUIRE_FALSE(map->containsKey(2));
+        REQUIRE_FALSE(map->containsKey(3));
+        REQUIRE(map->getSize() == 3);
+    }
+
+    SECTION("Elements that did cause a collision") {
+        map->remove(1);
+        REQUIRE_FALSE(map->containsKey(1));
+        REQUIRE(map->get(33) == 1000);
+
+        map->put(1, 100);
+        map->remove(65);
+        REQUIRE_FALSE(map->containsKey(65));
+
+        map->remove(1);
+        REQUIRE_FALSE(map->containsKey(1));
+        REQUIRE(map->get(33) == 1000);
+    }
+
+    SECTION("Clearing all elements in HashMapHS") {
+        map->clear();
+        REQUIRE(map->getSize() == 0);
+    }
+
+    SECTION("Removing elements that does not exist") {
+        REQUIRE_THROWS_AS(map->remove(1000), std::out_of_range);
+        REQUIRE_THROWS_AS(map->remove(5000), std::out_of_range);
+    }
+}
+
+TEST_CASE("Rehashing HashMapHS after exceeded threshold", "[HashMapHS]") {
+    map = new HashMapHS<int, int>(8);
+    map->put(1, 100);
+    map->put(2, 200);
+    map->put(3, 300);
+    map->put(4, 400);
+
+    SECTION("Rehashing without collisions") {
+        map->put(5, 500);
+        map->put(6, 600);
+        map->put(7, 700);
+
+        REQUIRE(map->getCapacity() == 16);
+        REQUIRE(map->getSize() == 7);
+        REQUIRE(map->containsKey(4));
+        REQUIRE(map->get(4) == 400);
+    }
+
+    SECTION("Rehashing when neighborhood overflows") {
+        auto *crowded = new HashMapHS<int, int>(64, 1.0f);
+        for (int i = 0; i < 40; i++) crowded->put(i * 1024, i);
+
+        REQUIRE(crowded->getSize() == 40);
+        REQUIRE(crowded->getCapacity() > 64);
+        for (int i = 0; i < 40; i++) REQUIRE(crowded->get(i * 1024) == i);
+        delete crowded;
+    }
+}
+
+TEST_CASE("Flooding HashMapHS with keys of one hash", "[HashMapHS]") {
+    HashMapHS<int, int, ConstantHash> flooded(64);
+    size_t fitting = constants::HOPSCOTCH_NEIGHBORHOOD;
+    for (size_t i = 0; i < fitting; i++) flooded.put(static_cast<int>(i), static_cast<int>(i) * 10);
+
+    SECTION("Giving up instead of growing without bound") {
+        size_t capacity = flooded.getCapacity();
+        REQUIRE_THROWS_AS(flooded.put(-1, -10), std::length_error);
+        REQUIRE(flooded.getCapacity() == capacity);
+        REQUIRE(flooded.getSize() == fitting);
+        REQUIRE_FALSE(flooded.containsKey(-1));
+        for (size_t i = 0; i < fitting; i++) REQUIRE(flooded.get(static_cast<int>(i)) == static_cast<int>(i) * 10);
+    }
+
+    SECTION("Staying usable after giving up") {
+        REQUIRE_THROWS_AS(flooded.put(-1, -10), std::length_error);
+        REQUIRE(flooded.remove(0) == 0);
+        REQUIRE(flooded.put(-1, -10) == 0);
+        REQUIRE(flooded.get(-1) == -10);
+        REQUIRE(flooded.getSize() == fitting);
+    }
+}
+
+TEST_CASE("Filling HashMapHS up to high load factor", "[HashMapHS]") {
+    map = new HashMapHS<int, int>(4096, 0.9f);
+    std::mt19937 rng(42);
+    std::vector<int> keys;
+    for (int i = 0; i < 3600; i++) keys.push_back(static_cast<int>(rng() >> 1));
+    for (int i = 0; i < 3600; i++) map->put(keys[i], i);
+
+    REQUIRE(map->getSize() == 3600);
+    REQUIRE(map->getCapacity() == 4096);
+    for (int i = 0; i < 3600; i++) REQUIRE(map->get(keys[i]) == i);
+    REQUIRE_FALSE(map->containsKey(-1));
+}
+
+TEST_CASE("Moving, swapping and cloning HashMapHS", "[HashMapHS]") {
+    HashMapHS<int, int> hashMap;
+    for (int i = 1; i <= 100; i++) hashMap.put(i, i * 10);
+    size_t capacity = hashMap.getCapacity();
+
+    SECTION("Moving leaves the source empty and usable") {
+        HashMapHS<int, int> moved(std::move(hashMap));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(moved.getCapacity() == capacity);
+        REQUIRE(moved.get(100) == 1000);
+        REQUIRE(hashMap.isEmpty());
+
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        hashMap = std::move(moved);
+        REQUIRE(hashMap.getSize() == 100);
+        REQUIRE(hashMap.get(1) == 10);
+    }
+
+    SECTION("Swapping exchanges whole tables") {
+        HashMapHS<int, int> other;
+        other.put(-1, -10);
+        hashMap.swap(other);
+
+        REQUIRE(hashMap.getSize() == 1);
+        REQUIRE(hashMap.get(-1) == -10);
+        REQUIRE(other.getSize() == 100);
+        REQUIRE(other.getCapacity() == capacity);
+        REQUIRE(other.get(42) == 420);
+    }
+
+    SECTION("Cloning gives an independent copy of the same layout") {
+        HashMapHS<int, int> copy = hashMap.clone();
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.getCapacity() == capacity);
+
+        copy.put(1, -1);
+        copy.remove(2);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 20);
+
+        size_t found = 0;
+        for (int i = 3; i <= 100; i++) {
+            if (copy.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 98);
+        REQUIRE(copy.get(1) == -1);
+        REQUIRE_FALSE(copy.containsKey(2));
+    }
+}
@@ -1,4 +1,11 @@
 #include <HashMapLL.h>
+#include "CountingResource.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <random>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -58,6 +65,16 @@ TEST_CASE("Adding and getting elements from HashMapLL", "[HashMapLL]") {
         REQUIRE_THROWS_AS(map->get(200), std::out_of_range);
     }
 
+    SECTION("Finding existing and non existing elements") {
+        map->put(1, 100);
+        map->put(33, 1000);
+
+        REQUIRE(*map->find(33) == 1000);
+        REQUIRE(map->find(65) == nullptr);
+        *map->find(1) = 101;
+        REQUIRE(map->get(1) == 101);
+    }
+
     SECTION("Adding elements after clearing HashMapLL") {
         map->put(1, 100);
         map->put(33, 1000);
@@ -112,6 +129,16 @@ TEST_CASE("Removing from HashMapLL", "[HashMapLL]") {
         REQUIRE_THROWS_AS(map->remove(1000), std::out_of_range);
         REQUIRE_THROWS_AS(map->remove(5000), std::out_of_range);
     }
+
+    SECTION("Trying to remove existing and non existing elements") {
+        int value = 0;
+        REQUIRE(map->tryRemove(33, value));
+        REQUIRE(value == 1000);
+        REQUIRE_FALSE(map->tryRemove(33, value));
+        REQUIRE_FALSE(map->tryRemove(5000, value));
+        REQUIRE(value == 1000);
+        REQUIRE(map->getSize() == 4);
+    }
 }
 
 TEST_CASE("Rehashing HashMapLL after exceeded threshold", "[HashMapLL]") {
@@ -142,4 +169,518 @@ TEST_CASE("Rehashing HashMapLL after exceeded threshold", "[HashMapLL]") {
         REQUIRE(map->containsKey(65));
         REQUIRE(map->get(65) == 650);
     }
-}
\ No newline at end of file
+}
+
+struct CollidingHash {
+    size_t operator()(const int &key) const { return 7; }
+};
+
+TEST_CASE("Treeifying long chains in HashMapLL", "[HashMapLL]") {
+    auto *flooded = new HashMapLL<int, int, CollidingHash>(1024);
+    for (int i = 0; i < 100; i++) flooded->put(i, i * 10);
+
+    SECTION("Getting elements from treeified bucket") {
+        REQUIRE(flooded->getSize() == 100);
+        REQUIRE(flooded->get(0) == 0);
+        REQUIRE(flooded->get(57) == 570);
+        REQUIRE(flooded->get(99) == 990);
+        REQUIRE_FALSE(flooded->containsKey(100));
+        REQUIRE_THROWS_AS(flooded->get(-1), std::out_of_range);
+    }
+
+    SECTION("Updating existing keys in treeified bucket") {
+        REQUIRE(flooded->put(42, 1) == 420);
+        REQUIRE(flooded->get(42) == 1);
+        REQUIRE(flooded->getSize() == 100);
+    }
+
+    SECTION("Removing elements until bucket becomes a chain again") {
+        for (int i = 0; i < 96; i++) REQUIRE(flooded->remove(i) == i * 10);
+
+        REQUIRE(flooded->getSize() == 4);
+        REQUIRE_FALSE(flooded->containsKey(0));
+        REQUIRE(flooded->get(96) == 960);
+        REQUIRE(flooded->get(99) == 990);
+        REQUIRE_THROWS_AS(flooded->remove(0), std::out_of_range);
+    }
+
+    SECTION("Rehashing HashMapLL with treeified bucket") {
+        for (int i = 100; i < 800; i++) flooded->put(i, i * 10);
+
+        REQUIRE(flooded->getCapacity() == 2048);
+        REQUIRE(flooded->getSize() == 800);
+        REQUIRE(flooded->get(0) == 0);
+        REQUIRE(flooded->get(799) == 7990);
+    }
+
+    SECTION("Clearing HashMapLL with treeified bucket") {
+        flooded->clear();
+        REQUIRE(flooded->isEmpty());
+        REQUIRE_FALSE(flooded->containsKey(1));
+
+        flooded->put(1, 10);
+        REQUIRE(flooded->get(1) == 10);
+    }
+
+    delete flooded;
+}
+
+
+TEST_CASE("Rehashing large HashMapLL in parallel", "[HashMapLL]") {
+    auto *large = new HashMapLL<int, int>(1024);
+    std::mt19937 rng(42);
+    std::vector<int> keys;
+    for (int i = 0; i < 200000; i++) keys.push_back(static_cast<int>(rng() >> 1));
+    for (int i = 0; i < 200000; i++) large->put(keys[i], i);
+
+    size_t found = 0;
+    for (int i = 0; i < 200000; i++) {
+        if (large->get(keys[i]) == i) found++;
+    }
+    REQUIRE(large->getSize() == found);
+    REQUIRE(large->getCapacity() > 262144);
+    REQUIRE_FALSE(large->containsKey(-1));
+    delete large;
+}
+
+TEST_CASE("Building HashMapLL from a range of pairs", "[HashMapLL]") {
+    std::vector<std::pair<int, int>> pairs = {{1, 10}, {2, 20}, {3, 30}, {2, 25}, {33, 330}};
+
+    SECTION("Constructing from range keeps the last value of duplicate keys") {
+        HashMapLL<int, int> hashMap(pairs.begin(), pairs.end());
+        REQUIRE(hashMap.getSize() == 4);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 25);
+        REQUIRE(hashMap.get(33) == 330);
+        REQUIRE_FALSE(hashMap.containsKey(4));
+    }
+
+    SECTION("Building into non empty map") {
+        HashMapLL<int, int> hashMap;
+        hashMap.put(3, 1);
+        hashMap.put(7, 70);
+        hashMap.buildFrom(pairs.begin(), pairs.end());
+        REQUIRE(hashMap.getSize() == 5);
+        REQUIRE(hashMap.get(3) == 30);
+        REQUIRE(hashMap.get(7) == 70);
+    }
+
+    SECTION("Building large map sizes the table once") {
+        std::vector<std::pair<int, int>> large;
+        for (int i = 0; i < 100000; i++) large.emplace_back(static_cast<int>(((i + 1) * 2654435761u) & 0x7fffffff), i);
+
+        HashMapLL<int, int> hashMap(large.begin(), large.end(), 0.5f);
+        size_t capacity = hashMap.getCapacity();
+        REQUIRE(capacity * 0.5f >= large.size());
+
+        size_t found = 0;
+        for (int i = 0; i < 100000; i++) {
+            if (hashMap.get(large[i].first) == i) found++;
+        }
+        REQUIRE(found == 100000);
+
+        for (int i = 0; i < 100000; i += 2) hashMap.remove(large[i].first);
+        found = 0;
+        for (int i = 1; i < 100000; i += 2) {
+            if (hashMap.get(large[i].first) == i) found++;
+        }
+        REQUIRE(found == 50000);
+        REQUIRE(hashMap.getCapacity() == capacity);
+    }
+}
+
+TEST_CASE("Rehashing HashMapLL backed by huge pages", "[HashMapLL]") {
+    HashMapLL<int, int, std::hash<int>, allocation::HugePageAllocation> hashMap(262144);
+    for (int i = 1; i <= 250000; i++) hashMap.put(i, 2 * i);
+    REQUIRE(hashMap.getCapacity() > 262144);
+
+    size_t found = 0;
+    for (int i = 1; i <= 250000; i++) {
+        if (hashMap.get(i) == 2 * i) found++;
+    }
+    REQUIRE(found == 250000);
+    REQUIRE_FALSE(hashMap.containsKey(-1));
+
+    for (int i = 1; i <= 250000; i += 2) hashMap.remove(i);
+    REQUIRE(hashMap.getSize() == 125000);
+}
+
+TEST_CASE("Updating HashMapLL values in place", "[HashMapLL]") {
+    HashMapLL<int, int> hashMap;
+
+    SECTION("Counting keys with operator[] and upsert") {
+        for (int i = 1; i <= 5000; i++) {
+            hashMap[i % 700 + 1]++;
+            hashMap.upsert(i % 300 + 1000, [](int &count) { count += 2; });
+        }
+        REQUIRE(hashMap.getSize() == 1000);
+        REQUIRE(hashMap.get(1) == 7);
+        REQUIRE(hashMap.get(700) == 7);
+        REQUIRE(hashMap.get(1000) == 2 * 16);
+        REQUIRE(hashMap.get(1299) == 2 * 16);
+    }
+
+    SECTION("Computing only absent values") {
+        int calls = 0;
+        auto factory = [&calls]() { return ++calls * 100; };
+        REQUIRE(hashMap.computeIfAbsent(3, factory) == 100);
+        REQUIRE(hashMap.computeIfAbsent(3, factory) == 100);
+        REQUIRE(hashMap.computeIfAbsent(4, factory) == 200);
+        REQUIRE(calls == 2);
+        REQUIRE(hashMap.getSize() == 2);
+    }
+
+    SECTION("Merging values distinguishes absent from zero") {
+        auto sum = [](int current, int value) { return current + value; };
+        REQUIRE(hashMap.merge(5, 0, sum) == 0);
+        REQUIRE(hashMap.merge(5, 7, sum) == 7);
+        REQUIRE(hashMap.merge(5, 7, sum) == 14);
+        REQUIRE(hashMap.get(5) == 14);
+    }
+
+    SECTION("Writing through returned reference across rehashes") {
+        for (int i = 1; i <= 2000; i++) hashMap[i] = i * 3;
+        REQUIRE(hashMap.getCapacity() > 2000);
+
+        size_t found = 0;
+        for (int i = 1; i <= 2000; i++) {
+            if (hashMap.get(i) == i * 3) found++;
+        }
+        REQUIRE(found == 2000);
+    }
+}
+
+TEST_CASE("Updating values of treeified HashMapLL bucket in place", "[HashMapLL]") {
+    HashMapLL<int, int, CollidingHash> flooded(1024);
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < 50; i++) flooded[i] += i;
+    }
+
+    REQUIRE(flooded.getSize() == 50);
+    for (int i = 0; i < 50; i++) REQUIRE(flooded.get(i) == 3 * i);
+    REQUIRE(flooded.merge(49, 1, [](int current, int value) { return current - value; }) == 146);
+
+    int calls = 0;
+    auto factory = [&calls]() {
+        calls++;
+        return -1;
+    };
+    REQUIRE(flooded.computeIfAbsent(10, factory) == 30);
+    REQUIRE(flooded.computeIfAbsent(50, factory) == -1);
+    REQUIRE(calls == 1);
+    REQUIRE(flooded.getSize() == 51);
+    for (int i = 0; i < 50; i++) REQUIRE(flooded.get(i) == (i == 49 ? 146 : 3 * i));
+}
+
+TEST_CASE("Observing HashMapLL events", "[HashMapLL]") {
+    HashMapLL<int, int, CollidingHash, allocation::HeapAllocation, CountingObserver<4>> hashMap(16);
+    for (int i = 0; i < 6; i++) hashMap.put(i, i);
+
+    SECTION("Reporting walks over long chains") {
+        auto &observer = hashMap.getObserver();
+        size_t before = observer.getLongProbes();
+        REQUIRE(hashMap.get(5) == 5);
+        REQUIRE_FALSE(hashMap.containsKey(6));
+        REQUIRE(hashMap.get(0) == 0);
+
+        REQUIRE(observer.getLongProbes() == before + 2);
+        REQUIRE(observer.getLongestProbe() == 6);
+    }
+
+    SECTION("Reporting every rehash with both capacities") {
+        for (int i = 6; i < 13; i++) hashMap.put(i, i);
+        REQUIRE(hashMap.getCapacity() == 32);
+        REQUIRE(hashMap.getObserver().getRehashes() == 1);
+
+        size_t rehashes = 0;
+        hashMap.getObserver().forEachEvent([&rehashes](const CountingObserver<4>::Event &event) {
+            if (event.kind != CountingObserver<4>::Kind::REHASH) return;
+            REQUIRE(event.first == 16);
+            REQUIRE(event.second == 32);
+            rehashes++;
+        });
+        REQUIRE(rehashes == 1);
+    }
+}
+
+TEST_CASE("Erasing matching entries from HashMapLL", "[HashMapLL]") {
+    SECTION("Unlinking entries from every position of the chains") {
+        HashMapLL<int, int> hashMap(16);
+        for (int i = 0; i < 1000; i++) hashMap.put(i, i * 10);
+
+        REQUIRE(hashMap.eraseIf([](const int &key, const int &) { return key % 3 == 0; }) == 334);
+        REQUIRE(hashMap.getSize() == 666);
+
+        size_t found = 0;
+        for (int i = 0; i < 1000; i++) {
+            if (i % 3 == 0) REQUIRE_FALSE(hashMap.containsKey(i));
+            else if (hashMap.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 666);
+        REQUIRE(hashMap.eraseIf([](const int &, const int &) { return false; }) == 0);
+    }
+
+    SECTION("Rebuilding treeified buckets from surviving entries") {
+        HashMapLL<int, int, CollidingHash> flooded(1024);
+        for (int i = 0; i < 100; i++) flooded.put(i, i * 10);
+
+        REQUIRE(flooded.eraseIf([](const int &, const int &value) { return value >= 200; }) == 80);
+        REQUIRE(flooded.getSize() == 20);
+        REQUIRE(flooded.get(19) == 190);
+        REQUIRE_FALSE(flooded.containsKey(20));
+
+        REQUIRE(flooded.eraseIf([](const int &key, const int &) { return key > 2; }) == 17);
+        REQUIRE(flooded.getSize() == 3);
+        REQUIRE(flooded.get(2) == 20);
+        flooded.put(50, 500);
+        REQUIRE(flooded.get(50) == 500);
+    }
+}
+
+TEST_CASE("Moving, swapping and cloning HashMapLL", "[HashMapLL]") {
+    HashMapLL<int, int> hashMap;
+    for (int i = 1; i <= 100; i++) hashMap.put(i, i * 10);
+    size_t capacity = hashMap.getCapacity();
+
+    SECTION("Moving leaves the source empty and usable") {
+        HashMapLL<int, int> moved(std::move(hashMap));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(moved.getCapacity() == capacity);
+        REQUIRE(moved.get(100) == 1000);
+        REQUIRE(hashMap.isEmpty());
+
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        hashMap = std::move(moved);
+        REQUIRE(hashMap.getSize() == 100);
+        REQUIRE(hashMap.get(1) == 10);
+    }
+
+    SECTION("Swapping exchanges whole tables") {
+        HashMapLL<int, int> other;
+        other.put(-1, -10);
+        hashMap.swap(other);
+
+        REQUIRE(hashMap.getSize() == 1);
+        REQUIRE(hashMap.get(-1) == -10);
+        REQUIRE(other.getSize() == 100);
+        REQUIRE(other.getCapacity() == capacity);
+        REQUIRE(other.get(42) == 420);
+    }
+
+    SECTION("Cloning gives an independent copy of the same layout") {
+        HashMapLL<int, int> copy = hashMap.clone();
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.getCapacity() == capacity);
+
+        copy.put(1, -1);
+        copy.remove(2);
+        REQUIRE(hashMap.get(1) == 10);
+        REQUIRE(hashMap.get(2) == 20);
+
+        size_t found = 0;
+        for (int i = 3; i <= 100; i++) {
+            if (copy.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 98);
+        REQUIRE(copy.get(1) == -1);
+        REQUIRE_FALSE(copy.containsKey(2));
+    }
+
+    SECTION("Cloning treeified buckets") {
+        HashMapLL<int, int, CollidingHash> flooded(64);
+        for (int i = 0; i < 40; i++) flooded.put(i, i);
+
+        HashMapLL<int, int, CollidingHash> copy = flooded.clone();
+        flooded.clear();
+        REQUIRE(copy.getSize() == 40);
+        for (int i = 0; i < 40; i++) REQUIRE(copy.get(i) == i);
+        REQUIRE(copy.remove(39) == 39);
+    }
+}
+
+TEST_CASE("Filtering lookups of HashMapLL", "[HashMapLL]") {
+    using FilteredMap = HashMapLL<int, int, std::hash<int>, allocation::HeapAllocation, NoObserver, BlockedBloomFilter<>>;
+    FilteredMap hashMap;
+    for (int i = 1; i <= 1000; i++) hashMap.put(i, i * 10);
+
+    SECTION("Present keys pass the filter") {
+        size_t found = 0;
+        for (int i = 1; i <= 1000; i++) {
+            if (hashMap.containsKey(i) && hashMap.get(i) == i * 10) found++;
+        }
+        REQUIRE(found == 1000);
+
+        size_t missing = 0;
+        for (int i = 1001; i <= 11000; i++) missing += !hashMap.containsKey(i);
+        REQUIRE(missing == 10000);
+        REQUIRE_THROWS_AS(hashMap.get(5000), std::out_of_range);
+        REQUIRE_THROWS_AS(hashMap.remove(5000), std::out_of_range);
+    }
+
+    SECTION("Removed keys stop passing once the filter is rebuilt") {
+        for (int i = 1; i <= 1000; i += 2) hashMap.remove(i);
+        hashMap.eraseIf([](const int &key, const int &) { return key % 4 == 0; });
+        REQUIRE(hashMap.getSize() == 250);
+
+        size_t found = 0;
+        for (int i = 1; i <= 1000; i++) {
+            if (hashMap.containsKey(i)) found++;
+        }
+        REQUIRE(found == 250);
+
+        hashMap[2] += 1;
+        hashMap.merge(4, 1, [](int a, int b) { return a + b; });
+        REQUIRE(hashMap.get(2) == 21);
+        REQUIRE(hashMap.get(4) == 1);
+    }
+
+    SECTION("Clones, swaps and clears carry the filter along") {
+        FilteredMap copy = hashMap.clone();
+        FilteredMap other;
+        other.swap(copy);
+        REQUIRE(other.get(1000) == 10000);
+        REQUIRE(copy.isEmpty());
+        REQUIRE_FALSE(copy.containsKey(1000));
+
+        hashMap.clear();
+        REQUIRE_FALSE(hashMap.containsKey(1));
+        hashMap.put(1, 1);
+        REQUIRE(hashMap.get(1) == 1);
+        REQUIRE(other.getSize() == 1000);
+    }
+
+    SECTION("Few missing keys get past the filter") {
+        BlockedBloomFilter<> filter;
+        filter.reset(10000);
+        std::hash<int> hasher;
+        for (int i = 0; i < 10000; i++) filter.add(hasher(i));
+
+        size_t passed = 0;
+        for (int i = 10000; i < 110000; i++) passed += filter.mayContain(hasher(i));
+        REQUIRE(passed < 3000);
+    }
+}
+
+TEST_CASE("Allocating HashMapLL from a memory resource", "[HashMapLL]") {
+    CountingResource counting;
+
+    SECTION("Every allocation is given back to the resource") {
+        {
+            HashMapLL<int, int, std::hash<int>, allocation::ResourceAllocation> hashMap(16, 0.75, &counting);
+            for (int i = 1; i <= 1000; i++) hashMap.put(i, i);
+            for (int i = 1; i <= 1000; i += 2) hashMap.remove(i);
+            hashMap[2002] += 1;
+            hashMap.eraseIf([](const int &key, const int &) { return key % 4 == 0; });
+
+            HashMapLL<int, int, std::hash<int>, allocation::ResourceAllocation> copy = hashMap.clone();
+            REQUIRE(copy.getSize() == hashMap.getSize());
+            REQUIRE(copy.get(2002) == 1);
+
+            hashMap.clear();
+            REQUIRE(hashMap.isEmpty());
+            REQUIRE(copy.get(2) == 2);
+            REQUIRE(counting.allocated > counting.deallocated);
+        }
+        REQUIRE(counting.allocated > 0);
+        REQUIRE(counting.deallocated == counting.allocated);
+    }
+
+    SECTION("A monotonic resource releases everything at once") {
+        std::pmr::monotonic_buffer_resource arena(&counting);
+        {
+            HashMapLL<int, int, std::hash<int>, allocation::ResourceAllocation> hashMap(16, 0.75, &arena);
+            for (int i = 1; i <= 1000; i++) hashMap.put(i, i * 2);
+
+            size_t found = 0;
+            for (int i = 1; i <= 1000; i++) {
+                if (hashMap.get(i) == i * 2) found++;
+            }
+            REQUIRE(found == 1000);
+
+            hashMap.clear();
+            REQUIRE(hashMap.isEmpty());
+            REQUIRE_FALSE(hashMap.containsKey(1));
+
+            hashMap.put(1, 1);
+            REQUIRE(hashMap.get(1) == 1);
+            REQUIRE(hashMap.getSize() == 1);
+        }
+        REQUIRE(counting.deallocated == 0);
+
+        arena.release();
+        REQUIRE(counting.deallocated == counting.allocated);
+    }
+
+    SECTION("Treeified buckets stay on the heap") {
+        std::pmr::monotonic_buffer_resource arena(&counting);
+        HashMapLL<int, int, CollidingHash, allocation::ResourceAllocation> hashMap(1024, 0.75, &arena);
+        for (int i = 1; i <= 64; i++) hashMap.put(i, i);
+        for (int i = 1; i <= 60; i++) hashMap.remove(i);
+
+        REQUIRE(hashMap.getSize() == 4);
+        REQUIRE(hashMap.get(64) == 64);
+        hashMap.clear();
+        REQUIRE(hashMap.isEmpty());
+    }
+}
+
+TEST_CASE("Scanning HashMapLL in parallel", "[HashMapLL]") {
+    HashMapLL<int, long long> hashMap;
+    for (int i = 1; i <= 100000; i++) hashMap.put(i, i);
+
+    SECTION("Reducing entries") {
+        auto sum = hashMap.parallelReduce(0LL, [](long long acc, const int &, const long long &value) {
+            return acc + value;
+        }, [](long long a, long long b) { return a + b; });
+        REQUIRE(sum == 100000LL * 100001 / 2);
+
+        int max = hashMap.parallelReduce(0, [](int acc, const int &key, const long long &) {
+            return std::max(acc, key);
+        }, [](int a, int b) { return std::max(a, b); });
+        REQUIRE(max == 100000);
+    }
+
+    SECTION("Reducing entries to a flag") {
+        bool found = hashMap.parallelReduce(false, [](bool acc, const int &key, const long long &) {
+            return acc || key == 77777;
+        }, [](bool a, bool b) { return a || b; });
+        REQUIRE(found);
+
+        bool positive = hashMap.parallelReduce(true, [](bool acc, const int &, const long long &value) {
+            return acc && value > 0;
+        }, [](bool a, bool b) { return a && b; });
+        REQUIRE(positive);
+    }
+
+    SECTION("Visiting every entry once") {
+        std::atomic<size_t> visited{0};
+        std::atomic<long long> keys{0};
+        hashMap.parallelForEach([&visited, &keys](const int &key, const long long &) {
+            visited++;
+            keys += key;
+        });
+        REQUIRE(visited == 100000);
+        REQUIRE(keys == 100000LL * 100001 / 2);
+    }
+
+    SECTION("Visiting and updating every entry on one thread") {
+        hashMap.forEach([](const int &, long long &value) { value = -value; });
+        long long sum = 0;
+        hashMap.forEach([&sum](const int &, const long long &value) { sum += value; });
+        REQUIRE(sum == -100000LL * 100001 / 2);
+    }
+
+    SECTION("An empty map reduces to the identity") {
+        hashMap.clear();
+        REQUIRE(hashMap.parallelReduce(0, [](int acc, const int &, const long long &) { return acc + 1; },
+                                       [](int a, int b) { return a + b; }) == 0);
+    }
+
+    SECTION("Treeified buckets are scanned too") {
+        HashMapLL<int, int, CollidingHash> flooded(1024);
+        for (int i = 1; i <= 100; i++) flooded.put(i, i);
+        REQUIRE(flooded.parallelReduce(0, [](int sum, const int &, const int &value) { return sum + value; },
+                                       [](int a, int b) { return a + b; }) == 5050);
+    }
+}
@@ -0,0 +1,188 @@
+#include <HashSetLL.h>
+#include <HashSetDH.h>
+#include <HashSetRH.h>
+#include "CountingResource.h"
+
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+// The same set drawing its memory from a memory resource
+template <typename S>
+struct WithResource;
+
+template <template <typename, typename, typename> class S, typename K, typename H, typename A>
+struct WithResource<S<K, H, A>> {
+    using type = S<K, H, allocation::ResourceAllocation>;
+};
+
+TEMPLATE_TEST_CASE("Inserting, looking up and erasing keys of hash sets", "[HashSet]", HashSetLL<int>, HashSetDH<int>,
+                   HashSetRH<int>) {
+    TestType set;
+    REQUIRE(set.isEmpty());
+
+    SECTION("Inserting the same key twice stores it once") {
+        REQUIRE(set.insert(5));
+        REQUIRE_FALSE(set.insert(5));
+        REQUIRE(set.getSize() == 1);
+        REQUIRE(set.contains(5));
+        REQUIRE_FALSE(set.contains(6));
+    }
+
+    SECTION("Erasing existing and missing keys") {
+        set.insert(5);
+        set.insert(37);
+        REQUIRE(set.erase(5));
+        REQUIRE_FALSE(set.erase(5));
+        REQUIRE_FALSE(set.contains(5));
+        REQUIRE(set.contains(37));
+        REQUIRE(set.getSize() == 1);
+    }
+
+    SECTION("Rehashing after exceeded threshold") {
+        for (int i = 0; i < 1000; i++) set.insert(i * 7);
+        REQUIRE(set.getSize() == 1000);
+        REQUIRE(set.getCapacity() > 1000);
+
+        size_t found = 0;
+        for (int i = 0; i < 1000; i++) {
+            if (set.contains(i * 7)) found++;
+        }
+        REQUIRE(found == 1000);
+        REQUIRE_FALSE(set.contains(3));
+
+        set.clear();
+        REQUIRE(set.isEmpty());
+        REQUIRE_FALSE(set.contains(7));
+    }
+}
+
+TEMPLATE_TEST_CASE("Combining hash sets with another set", "[HashSet]", HashSetLL<int>, HashSetDH<int>,
+                   HashSetRH<int>) {
+    TestType evens;
+    TestType thirds;
+    for (int i = 0; i < 600; i += 2) evens.insert(i);
+    for (int i = 0; i < 600; i += 3) thirds.insert(i);
+
+    SECTION("Union of sets") {
+        evens.addAll(thirds);
+        REQUIRE(evens.getSize() == 400);
+        for (int i = 0; i < 600; i++) REQUIRE(evens.contains(i) == (i % 2 == 0 || i % 3 == 0));
+    }
+
+    SECTION("Intersection of sets") {
+        evens.retainAll(thirds);
+        REQUIRE(evens.getSize() == 100);
+        for (int i = 0; i < 600; i++) REQUIRE(evens.contains(i) == (i % 6 == 0));
+    }
+
+    SECTION("Difference of sets") {
+        evens.removeAll(thirds);
+        REQUIRE(evens.getSize() == 200);
+        for (int i = 0; i < 600; i++) REQUIRE(evens.contains(i) == (i % 2 == 0 && i % 3 != 0));
+    }
+
+    SECTION("Combining sets of different capacities") {
+        TestType small(8);
+        for (int i = 0; i < 12; i += 2) small.insert(i + 1);
+        small.insert(0);
+        REQUIRE(small.getCapacity() != evens.getCapacity());
+
+        TestType copy;
+        copy.addAll(evens);
+        copy.retainAll(small);
+        REQUIRE(copy.getSize() == 1);
+        REQUIRE(copy.contains(0));
+
+        evens.removeAll(small);
+        REQUIRE(evens.getSize() == 299);
+        REQUIRE_FALSE(evens.contains(0));
+
+        small.addAll(evens);
+        REQUIRE(small.getSize() == 306);
+    }
+
+    SECTION("Combining sets whose capacities do not divide each other") {
+        TestType odd(12);
+        for (int i = 0; i < 9; i++) odd.insert(i);
+        REQUIRE(evens.getCapacity() % odd.getCapacity() != 0);
+
+        odd.removeAll(evens);
+        REQUIRE(odd.getSize() == 4);
+        REQUIRE(odd.contains(7));
+
+        evens.retainAll(odd);
+        REQUIRE(evens.isEmpty());
+
+        odd.addAll(thirds);
+        REQUIRE(odd.getSize() == 203);
+        for (int i = 0; i < 600; i++) REQUIRE(odd.contains(i) == ((i < 9 && i % 2 == 1) || i % 3 == 0));
+    }
+
+    SECTION("Combining set with itself") {
+        evens.addAll(evens);
+        evens.retainAll(evens);
+        REQUIRE(evens.getSize() == 300);
+
+        evens.removeAll(evens);
+        REQUIRE(evens.isEmpty());
+    }
+}
+
+TEMPLATE_TEST_CASE("Moving and swapping hash sets", "[HashSet]", HashSetLL<int>, HashSetDH<int>, HashSetRH<int>) {
+    TestType set;
+    for (int i = 1; i <= 100; i++) set.insert(i);
+    size_t capacity = set.getCapacity();
+
+    SECTION("Moving leaves the source empty and usable") {
+        TestType moved(std::move(set));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(moved.getCapacity() == capacity);
+        REQUIRE(moved.contains(100));
+        REQUIRE(set.isEmpty());
+
+        set.insert(-1);
+        REQUIRE(set.contains(-1));
+        set = std::move(moved);
+        REQUIRE(set.getSize() == 100);
+        REQUIRE_FALSE(set.contains(-1));
+    }
+
+    SECTION("Swapping exchanges whole tables") {
+        TestType other;
+        other.insert(-1);
+        set.swap(other);
+
+        REQUIRE(set.getSize() == 1);
+        REQUIRE(set.contains(-1));
+        REQUIRE(other.getSize() == 100);
+        REQUIRE(other.getCapacity() == capacity);
+        REQUIRE(other.contains(42));
+    }
+}
+
+TEMPLATE_TEST_CASE("Allocating hash sets from a memory resource", "[HashSet]", HashSetLL<int>, HashSetDH<int>,
+                   HashSetRH<int>) {
+    CountingResource counting;
+    {
+        typename WithResource<TestType>::type set(16, 0.75, &counting);
+        for (int i = 1; i <= 1000; i++) set.insert(i);
+        for (int i = 1; i <= 1000; i += 2) set.erase(i);
+        REQUIRE(set.getSize() == 500);
+        REQUIRE(set.contains(2));
+        REQUIRE_FALSE(set.contains(1));
+
+        typename WithResource<TestType>::type other(16, 0.75, &counting);
+        other.insert(-1);
+        set.swap(other);
+        REQUIRE(set.contains(-1));
+        REQUIRE(other.getSize() == 500);
+
+        other.clear();
+        REQUIRE(other.isEmpty());
+        REQUIRE(counting.allocated > counting.deallocated);
+    }
+    REQUIRE(counting.allocated > 0);
+    REQUIRE(counting.deallocated == counting.allocated);
+}
@@ -0,0 +1,150 @@
+#include <LruHashMap.h>
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Using LruHashMap bounded by entry count", "[LruHashMap]") {
+    LruHashMap<int, int> map(3);
+    std::vector<int> evicted;
+    map.setEvictionListener([&evicted](const int &key, const int &) { evicted.push_back(key); });
+    REQUIRE(map.isEmpty());
+
+    SECTION("Adding, replacing and getting elements") {
+        REQUIRE(map.put(1, 10) == 0);
+        REQUIRE(map.put(1, 11) == 10);
+        REQUIRE(map.get(1) == 11);
+        REQUIRE(map.getSize() == 1);
+        REQUIRE_THROWS_AS(map.get(2), std::out_of_range);
+    }
+
+    SECTION("Evicting the least recently used element") {
+        map.put(1, 10);
+        map.put(2, 20);
+        map.put(3, 30);
+        REQUIRE(map.get(1) == 10);
+
+        map.put(4, 40);
+        REQUIRE((evicted == std::vector<int>{2}));
+        REQUIRE_FALSE(map.containsKey(2));
+        REQUIRE(map.getSize() == 3);
+
+        map.put(5, 50);
+        REQUIRE((evicted == std::vector<int>{2, 3}));
+        REQUIRE(map.containsKey(1));
+    }
+
+    SECTION("Replacing a value counts as a use") {
+        map.put(1, 10);
+        map.put(2, 20);
+        map.put(3, 30);
+        map.put(1, 11);
+        map.put(4, 40);
+        REQUIRE((evicted == std::vector<int>{2}));
+    }
+
+    SECTION("Removing and clearing") {
+        map.put(1, 10);
+        map.put(2, 20);
+        REQUIRE(map.remove(1) == 10);
+        REQUIRE_THROWS_AS(map.remove(1), std::out_of_range);
+        REQUIRE(map.getSize() == 1);
+
+        map.put(3, 30);
+        map.put(4, 40);
+        REQUIRE(evicted.empty());
+
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getWeight() == 0);
+        REQUIRE(evicted.empty());
+    }
+}
+
+TEST_CASE("Using LruHashMap bounded by bytes", "[LruHashMap]") {
+    LruHashMap<int, std::string> map(10, [](const int &, const std::string &value) { return value.size(); });
+
+    map.put(1, "aaaa");
+    map.put(2, "bbbb");
+    REQUIRE(map.getWeight() == 8);
+
+    map.put(3, "cccccc");
+    REQUIRE_FALSE(map.containsKey(1));
+    REQUIRE(map.containsKey(2));
+    REQUIRE(map.getWeight() == 10);
+
+    map.put(3, "ccccccccccc");
+    REQUIRE(map.isEmpty());
+    REQUIRE(map.getWeight() == 0);
+}
+
+TEST_CASE("Using LruHashMap with CLOCK eviction", "[LruHashMap]") {
+    LruHashMap<int, int, std::hash<int>, ClockEviction> map(3);
+    std::vector<int> evicted;
+    map.setEvictionListener([&evicted](const int &key, const int &) { evicted.push_back(key); });
+
+    map.put(1, 10);
+    map.put(2, 20);
+    map.put(3, 30);
+    REQUIRE(map.get(1) == 10);
+
+    map.put(4, 40);
+    REQUIRE((evicted == std::vector<int>{2}));
+    REQUIRE(map.containsKey(1));
+
+    REQUIRE(map.get(3) == 30);
+    REQUIRE(map.get(4) == 40);
+    map.put(5, 50);
+    REQUIRE((evicted == std::vector<int>{2, 1}));
+}
+
+TEST_CASE("Rehashing LruHashMap keeps the recency order", "[LruHashMap]") {
+    LruHashMap<int, int> map(1000);
+    std::vector<int> evicted;
+    map.setEvictionListener([&evicted](const int &key, const int &) { evicted.push_back(key); });
+
+    for (int i = 0; i < 2000; i++) map.put(i, i);
+    REQUIRE(map.getSize() == 1000);
+    REQUIRE(map.getCapacity() > 1000);
+    REQUIRE(evicted.size() == 1000);
+    for (int i = 0; i < 1000; i++) REQUIRE(evicted[i] == i);
+    for (int i = 1000; i < 2000; i++) REQUIRE(map.get(i) == i);
+}
+
+TEST_CASE("Moving, swapping and cloning LruHashMap", "[LruHashMap]") {
+    LruHashMap<int, int> map(3);
+    std::vector<int> evicted;
+    map.setEvictionListener([&evicted](const int &key, const int &) { evicted.push_back(key); });
+    map.put(1, 10);
+    map.put(2, 20);
+    map.put(3, 30);
+    map.get(1);
+
+    SECTION("Moving and swapping keep recency and listener") {
+        LruHashMap<int, int> moved(std::move(map));
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getMaxWeight() == 3);
+
+        moved.put(4, 40);
+        REQUIRE((evicted == std::vector<int>{2}));
+
+        map.swap(moved);
+        map.put(5, 50);
+        REQUIRE((evicted == std::vector<int>{2, 3}));
+        REQUIRE(moved.isEmpty());
+    }
+
+    SECTION("Cloning keeps the eviction order") {
+        LruHashMap<int, int> copy = map.clone();
+        REQUIRE(copy.getSize() == 3);
+        REQUIRE(copy.getWeight() == 3);
+
+        copy.put(4, 40);
+        copy.put(5, 50);
+        REQUIRE((evicted == std::vector<int>{2, 3}));
+        REQUIRE(copy.get(1) == 10);
+        REQUIRE(map.containsKey(2));
+        REQUIRE(map.getSize() == 3);
+    }
+}
@@ -0,0 +1,139 @@
+#include <MappedHashMapRH.h>
+
+#include <cstdint>
+#include <filesystem>
+
+#include <catch2/catch_test_macros.hpp>
+
+static std::string mappedPath() {
+    auto path = std::filesystem::temp_directory_path() / ("MappedHashMapRH-" + std::to_string(::getpid()) + ".bin");
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+TEST_CASE("Using MappedHashMapRH", "[MappedHashMapRH]") {
+    std::string path = mappedPath();
+
+    {
+        MappedHashMapRH<uint64_t, double> map(path, 16);
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getCapacity() == 16);
+
+        SECTION("Adding, replacing and getting elements") {
+            REQUIRE(map.put(1, 1.5) == 0);
+            REQUIRE(map.put(17, 17.5) == 0);
+            REQUIRE(map.put(1, 2.5) == 1.5);
+            REQUIRE(map.get(1) == 2.5);
+            REQUIRE(map.get(17) == 17.5);
+            REQUIRE(map.getSize() == 2);
+            REQUIRE_THROWS_AS(map.get(2), std::out_of_range);
+        }
+
+        SECTION("Removing shifts colliding elements back") {
+            for (uint64_t i = 0; i < 5; i++) map.put(3 + 16 * i, static_cast<double>(i));
+            REQUIRE(map.remove(3) == 0);
+            REQUIRE_THROWS_AS(map.remove(3), std::out_of_range);
+            for (uint64_t i = 1; i < 5; i++) REQUIRE(map.get(3 + 16 * i) == static_cast<double>(i));
+            REQUIRE(map.getSize() == 4);
+        }
+
+        SECTION("Rehashing and clearing") {
+            for (uint64_t i = 0; i < 1000; i++) map.put(i, static_cast<double>(2 * i));
+            REQUIRE(map.getCapacity() > 1000);
+            REQUIRE_FALSE(std::filesystem::exists(path + ".rehash"));
+            for (uint64_t i = 0; i < 1000; i++) REQUIRE(map.get(i) == static_cast<double>(2 * i));
+
+            map.clear();
+            REQUIRE(map.isEmpty());
+            REQUIRE_FALSE(map.containsKey(5));
+        }
+
+        SECTION("Failed rehashing keeps the old table") {
+            // A directory in place of the new file makes creating it fail
+            std::filesystem::create_directory(path + ".rehash");
+            for (uint64_t i = 0; i < 12; i++) map.put(i, static_cast<double>(i));
+            REQUIRE_THROWS_AS(map.put(12, 12.0), std::system_error);
+            REQUIRE(map.getCapacity() == 16);
+            REQUIRE(map.getSize() == 13);
+            for (uint64_t i = 0; i < 13; i++) REQUIRE(map.get(i) == static_cast<double>(i));
+
+            std::filesystem::remove(path + ".rehash");
+            map.put(13, 13.0);
+            REQUIRE(map.getCapacity() == 32);
+            REQUIRE_FALSE(std::filesystem::exists(path + ".rehash"));
+            for (uint64_t i = 0; i < 14; i++) REQUIRE(map.get(i) == static_cast<double>(i));
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Reopening MappedHashMapRH from its file", "[MappedHashMapRH]") {
+    std::string path = mappedPath();
+
+    {
+        MappedHashMapRH<uint64_t, uint64_t> map(path);
+        for (uint64_t i = 0; i < 5000; i++) map.put(i, i * i);
+        map.remove(7);
+        map.sync();
+    }
+
+    {
+        MappedHashMapRH<uint64_t, uint64_t> map(path, 16);
+        REQUIRE(map.getSize() == 4999);
+        REQUIRE(map.getCapacity() > 5000);
+        REQUIRE_FALSE(map.containsKey(7));
+        for (uint64_t i = 8; i < 5000; i++) REQUIRE(map.get(i) == i * i);
+
+        map.put(7, 49);
+    }
+
+    {
+        MappedHashMapRH<uint64_t, uint64_t> map(path);
+        REQUIRE(map.get(7) == 49);
+    }
+
+    SECTION("Files of another layout are rejected") {
+        REQUIRE_THROWS_AS((MappedHashMapRH<uint64_t, uint32_t>(path)), std::invalid_argument);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Moving, swapping and cloning MappedHashMapRH", "[MappedHashMapRH]") {
+    std::string path = mappedPath();
+    std::string clonePath = path + ".clone";
+    {
+        MappedHashMapRH<uint64_t, double> map(path, 16);
+        for (uint64_t i = 0; i < 100; i++) map.put(i, static_cast<double>(i) / 2);
+
+        SECTION("Moving keeps the mapping") {
+            MappedHashMapRH<uint64_t, double> moved(std::move(map));
+            REQUIRE(moved.getSize() == 100);
+            REQUIRE(moved.get(99) == 49.5);
+
+            MappedHashMapRH<uint64_t, double> other(clonePath, 16);
+            other.put(1, 1);
+            other.swap(moved);
+            REQUIRE(other.get(98) == 49);
+            REQUIRE(moved.get(1) == 1);
+        }
+
+        SECTION("Cloning writes an independent file") {
+            {
+                MappedHashMapRH<uint64_t, double> copy = map.clone(clonePath);
+                REQUIRE(copy.getSize() == 100);
+                REQUIRE(copy.getCapacity() == map.getCapacity());
+                copy.put(1000, 1);
+                REQUIRE_FALSE(map.containsKey(1000));
+                REQUIRE_THROWS_AS(map.clone(path), std::invalid_argument);
+            }
+
+            MappedHashMapRH<uint64_t, double> reopened(clonePath);
+            REQUIRE(reopened.getSize() == 101);
+            for (uint64_t i = 0; i < 100; i++) REQUIRE(reopened.get(i) == static_cast<double>(i) / 2);
+        }
+    }
+    std::filesystem::remove(path);
+    std::filesystem::remove(clonePath);
+}
@@ -0,0 +1,184 @@
+#include <OpenAddressingMap.h>
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+using LinearTombstone = OpenAddressingMap<int, int, std::hash<int>, LinearProbing, TombstoneDeletion>;
+using LinearBackwardShift = OpenAddressingMap<int, int, std::hash<int>, LinearProbing, BackwardShiftDeletion>;
+using TriangularTombstone = OpenAddressingMap<int, int, std::hash<int>, TriangularProbing, TombstoneDeletion>;
+using DoubleHashingTombstone = OpenAddressingMap<int, int, std::hash<int>, DoubleHashing, TombstoneDeletion>;
+using RobinHoodTombstone = OpenAddressingMap<int, int, std::hash<int>, RobinHoodProbing, TombstoneDeletion>;
+using RobinHoodBackwardShift = OpenAddressingMap<int, int, std::hash<int>, RobinHoodProbing, BackwardShiftDeletion>;
+
+TEST_CASE("Creating OpenAddressingMap with probe specific capacities", "[OpenAddressingMap]") {
+    SECTION("Linear probing keeps given capacity") {
+        LinearTombstone map(100);
+        REQUIRE(map.getCapacity() == 100);
+        REQUIRE(map.isEmpty());
+    }
+
+    SECTION("Triangular probing rounds capacity up to power of two") {
+        TriangularTombstone map(100);
+        REQUIRE(map.getCapacity() == 128);
+    }
+
+    SECTION("Double hashing rounds capacity up to prime") {
+        DoubleHashingTombstone map(100, 0.5f);
+        REQUIRE(map.getCapacity() == 101);
+        REQUIRE(map.getLoadFactor() == 0.5f);
+    }
+}
+
+TEMPLATE_TEST_CASE("Adding and getting elements from OpenAddressingMap", "[OpenAddressingMap]", LinearTombstone,
+                   LinearBackwardShift, TriangularTombstone, DoubleHashingTombstone, RobinHoodTombstone,
+                   RobinHoodBackwardShift) {
+    TestType map;
+
+    SECTION("Checking returns when adding non existing/existing keys") {
+        REQUIRE(map.put(1, 100) == 0);
+        REQUIRE(map.put(1, 1000) == 100);
+        REQUIRE(map.getSize() == 1);
+    }
+
+    SECTION("Checking handling collisions") {
+        map.put(1, 100);
+        map.put(33, 1000);
+        map.put(65, 10000);
+        map.put(2, 200);
+
+        REQUIRE(map.get(1) == 100);
+        REQUIRE(map.get(33) == 1000);
+        REQUIRE(map.get(65) == 10000);
+        REQUIRE(map.get(2) == 200);
+        REQUIRE_THROWS_AS(map.get(97), std::out_of_range);
+    }
+
+    SECTION("Adding elements after clearing OpenAddressingMap") {
+        map.put(1, 100);
+        map.put(33, 1000);
+        map.clear();
+
+        REQUIRE(map.isEmpty());
+        REQUIRE_FALSE(map.containsKey(1));
+        map.put(33, 3300);
+        REQUIRE(map.get(33) == 3300);
+    }
+}
+
+TEMPLATE_TEST_CASE("Removing from OpenAddressingMap", "[OpenAddressingMap]", LinearTombstone, LinearBackwardShift,
+                   TriangularTombstone, DoubleHashingTombstone, RobinHoodTombstone, RobinHoodBackwardShift) {
+    TestType map;
+    map.put(1, 100);
+    map.put(33, 1000);
+    map.put(65, 10000);
+    map.put(2, 200);
+
+    SECTION("Elements that did cause a collision") {
+        REQUIRE(map.remove(33) == 1000);
+        REQUIRE_FALSE(map.containsKey(33));
+        REQUIRE(map.get(1) == 100);
+        REQUIRE(map.get(65) == 10000);
+        REQUIRE(map.get(2) == 200);
+        REQUIRE(map.getSize() == 3);
+
+        map.put(33, 330);
+        REQUIRE(map.get(33) == 330);
+    }
+
+    SECTION("Removing elements that does not exist") {
+        REQUIRE_THROWS_AS(map.remove(1000), std::out_of_range);
+    }
+}
+
+TEMPLATE_TEST_CASE("Mixing operations on OpenAddressingMap", "[OpenAddressingMap]", LinearTombstone,
+                   LinearBackwardShift, TriangularTombstone, DoubleHashingTombstone, RobinHoodTombstone,
+                   RobinHoodBackwardShift) {
+    TestType map(16, 0.9f);
+    std::vector<int> values(2048, -1);
+    std::mt19937 rng(7);
+
+    for (int i = 0; i < 20000; i++) {
+        int key = static_cast<int>(rng() % values.size());
+        if (rng() % 3 == 0) {
+            if (values[key] == -1) REQUIRE_THROWS_AS(map.remove(key), std::out_of_range);
+            else REQUIRE(map.remove(key) == values[key]);
+            values[key] = -1;
+        } else {
+            map.put(key, i);
+            values[key] = i;
+        }
+    }
+
+    size_t size = 0;
+    for (size_t key = 0; key < values.size(); key++) {
+        if (values[key] == -1) {
+            REQUIRE_FALSE(map.containsKey(static_cast<int>(key)));
+            continue;
+        }
+        REQUIRE(map.get(static_cast<int>(key)) == values[key]);
+        size++;
+    }
+    REQUIRE(map.getSize() == size);
+}
+
+TEMPLATE_TEST_CASE("Moving, swapping and cloning OpenAddressingMap", "[OpenAddressingMap]", LinearTombstone,
+                   LinearBackwardShift, TriangularTombstone, DoubleHashingTombstone, RobinHoodTombstone,
+                   RobinHoodBackwardShift) {
+    TestType map;
+    for (int i = 0; i < 100; i++) map.put(i, i * 10);
+    for (int i = 0; i < 10; i++) map.remove(i);
+
+    SECTION("Moving and swapping") {
+        TestType moved(std::move(map));
+        REQUIRE(moved.getSize() == 90);
+        REQUIRE(map.isEmpty());
+
+        map.put(1, 1);
+        map.swap(moved);
+        REQUIRE(map.getSize() == 90);
+        REQUIRE(map.get(99) == 990);
+        REQUIRE(moved.get(1) == 1);
+    }
+
+    SECTION("Cloning with removed entries") {
+        TestType copy = map.clone();
+        REQUIRE(copy.getSize() == 90);
+        REQUIRE(copy.getCapacity() == map.getCapacity());
+
+        for (int i = 0; i < 10; i++) copy.put(i, -i);
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.get(5) == -5);
+        REQUIRE_FALSE(map.containsKey(5));
+        for (int i = 10; i < 100; i++) REQUIRE(copy.get(i) == i * 10);
+    }
+}
+
+TEMPLATE_TEST_CASE("Updating OpenAddressingMap values in place", "[OpenAddressingMap]", LinearTombstone,
+                   LinearBackwardShift, TriangularTombstone, DoubleHashingTombstone, RobinHoodTombstone,
+                   RobinHoodBackwardShift) {
+    TestType map(8);
+    for (int i = 0; i < 10; i++) map.put(i, i);
+    for (int i = 0; i < 5; i++) map.remove(i);
+
+    SECTION("Upserting counts through removals and rehashes") {
+        for (int round = 0; round < 3; round++) {
+            for (int i = 0; i < 200; i++) map.upsert(i, [](int &value) { value++; });
+        }
+        REQUIRE(map.getSize() == 200);
+        for (int i = 0; i < 200; i++) REQUIRE(map.get(i) == (i >= 5 && i < 10 ? i + 3 : 3));
+
+        int &value = map.upsert(500, [](int &value) { value = 7; });
+        value *= 2;
+        REQUIRE(map.get(500) == 14);
+    }
+
+    SECTION("Finding values") {
+        REQUIRE(map.find(3) == nullptr);
+        REQUIRE(*map.find(7) == 7);
+        *map.find(7) = 70;
+        REQUIRE(map.get(7) == 70);
+    }
+}
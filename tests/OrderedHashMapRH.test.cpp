@@ -0,0 +1,134 @@
+#include <OrderedHashMapRH.h>
+
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+// Hashes every key into one of a few buckets so that keys share probe sequences
+struct ShortHash {
+    size_t operator()(const int &key) const { return key % 4; }
+};
+
+template <typename Map>
+std::vector<int> keysOf(Map &map) {
+    std::vector<int> keys;
+    map.forEach([&keys](const int &key, auto &) { keys.push_back(key); });
+    return keys;
+}
+
+TEST_CASE("Using OrderedHashMapRH", "[OrderedHashMapRH]") {
+    OrderedHashMapRH<int, int> map(16);
+    REQUIRE(map.isEmpty());
+    REQUIRE(map.getCapacity() == 16);
+
+    SECTION("Adding, replacing and getting elements") {
+        REQUIRE(map.put(3, 30) == 0);
+        REQUIRE(map.put(1, 10) == 0);
+        REQUIRE(map.put(3, 33) == 30);
+        REQUIRE(map.get(3) == 33);
+        REQUIRE(map.get(1) == 10);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE_THROWS_AS(map.get(2), std::out_of_range);
+        REQUIRE_FALSE(map.containsKey(2));
+    }
+
+    SECTION("Iterating in insertion order") {
+        for (int key : {5, 3, 9, 1, 7}) map.put(key, key * 10);
+        map.put(3, 0);
+        REQUIRE(keysOf(map) == std::vector<int>({5, 3, 9, 1, 7}));
+
+        map.remove(9);
+        map.put(9, 90);
+        REQUIRE(keysOf(map) == std::vector<int>({5, 3, 1, 7, 9}));
+
+        int sum = 0;
+        map.forEach([&sum](const int &, int &value) { sum += value; });
+        REQUIRE(sum == 50 + 0 + 10 + 70 + 90);
+    }
+
+    SECTION("Rehashing keeps the order and widens the index") {
+        REQUIRE(map.getIndexWidth() == 1);
+        for (int i = 0; i < 1000; i++) map.put(i, i);
+        REQUIRE(map.getCapacity() > 1000);
+        REQUIRE(map.getIndexWidth() == 2);
+        REQUIRE(map.getIndexBytes() == map.getCapacity() * 2);
+
+        std::vector<int> keys = keysOf(map);
+        REQUIRE(keys.size() == 1000);
+        size_t ordered = 0;
+        for (int i = 0; i < 1000; i++) {
+            if (keys[i] == i && map.get(i) == i) ordered++;
+        }
+        REQUIRE(ordered == 1000);
+
+        OrderedHashMapRH<int, int> wide(100000);
+        REQUIRE(wide.getIndexWidth() == 4);
+    }
+
+    SECTION("Clearing") {
+        for (int i = 0; i < 100; i++) map.put(i, i);
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(keysOf(map).empty());
+        REQUIRE_FALSE(map.containsKey(5));
+
+        map.put(5, 5);
+        REQUIRE(map.get(5) == 5);
+    }
+}
+
+TEST_CASE("Removing from OrderedHashMapRH", "[OrderedHashMapRH]") {
+    OrderedHashMapRH<int, std::string, ShortHash> map(64);
+    for (int i = 0; i < 20; i++) map.put(i, "value-" + std::to_string(i));
+
+    SECTION("Removing shifts colliding elements back") {
+        REQUIRE(map.remove(3) == "value-3");
+        REQUIRE_THROWS_AS(map.remove(3), std::out_of_range);
+        for (int i = 0; i < 20; i++) {
+            if (i != 3) REQUIRE(map.get(i) == "value-" + std::to_string(i));
+        }
+        REQUIRE(map.getSize() == 19);
+    }
+
+    SECTION("Dead entries are compacted without growing the index") {
+        for (int round = 0; round < 10; round++) {
+            for (int i = 0; i < 20; i++) map.remove(round * 20 + i);
+            for (int i = 0; i < 20; i++) map.put((round + 1) * 20 + i, "value");
+        }
+
+        REQUIRE(map.getSize() == 20);
+        REQUIRE(map.getCapacity() == 64);
+        REQUIRE(keysOf(map).front() == 200);
+        REQUIRE(keysOf(map).back() == 219);
+        REQUIRE_FALSE(map.containsKey(199));
+    }
+}
+
+TEST_CASE("Moving, swapping and cloning OrderedHashMapRH", "[OrderedHashMapRH]") {
+    OrderedHashMapRH<int, int> map;
+    for (int i = 1; i <= 100; i++) map.put(i, i * 10);
+
+    SECTION("Moving and swapping") {
+        OrderedHashMapRH<int, int> moved(std::move(map));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(map.isEmpty());
+
+        map.put(-1, -10);
+        map.swap(moved);
+        REQUIRE(map.get(100) == 1000);
+        REQUIRE(moved.get(-1) == -10);
+    }
+
+    SECTION("Cloning copies entries in their order") {
+        OrderedHashMapRH<int, int> copy = map.clone();
+        map.remove(1);
+        copy.put(101, 1010);
+
+        REQUIRE(copy.getSize() == 101);
+        REQUIRE(copy.get(1) == 10);
+        REQUIRE(keysOf(copy).front() == 1);
+        REQUIRE(keysOf(copy).back() == 101);
+        REQUIRE_FALSE(map.containsKey(101));
+    }
+}
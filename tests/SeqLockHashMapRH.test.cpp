@@ -0,0 +1,73 @@
+#include <SeqLockHashMapRH.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Using SeqLockHashMapRH from a single thread", "[SeqLockHashMapRH]") {
+    SeqLockHashMapRH<int, int> map(16);
+    REQUIRE(map.isEmpty());
+
+    SECTION("Adding, replacing and getting elements") {
+        REQUIRE(map.put(1, 10) == 0);
+        REQUIRE(map.put(17, 170) == 0);
+        REQUIRE(map.put(1, 11) == 10);
+        REQUIRE(map.get(1) == 11);
+        REQUIRE(map.get(17) == 170);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE_THROWS_AS(map.get(2), std::out_of_range);
+    }
+
+    SECTION("Removing shifts colliding elements back") {
+        for (int i = 0; i < 5; i++) map.put(3 + 16 * i, i);
+        REQUIRE(map.remove(3) == 0);
+        REQUIRE_THROWS_AS(map.remove(3), std::out_of_range);
+        for (int i = 1; i < 5; i++) REQUIRE(map.get(3 + 16 * i) == i);
+        REQUIRE(map.getSize() == 4);
+    }
+
+    SECTION("Rehashing and clearing") {
+        for (int i = 0; i < 1000; i++) map.put(i, 2 * i);
+        REQUIRE(map.getCapacity() > 1000);
+        for (int i = 0; i < 1000; i++) REQUIRE(map.get(i) == 2 * i);
+
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE_FALSE(map.containsKey(5));
+        map.put(5, 50);
+        REQUIRE(map.get(5) == 50);
+    }
+}
+
+TEST_CASE("Reading SeqLockHashMapRH while single writer shifts and rehashes", "[SeqLockHashMapRH]") {
+    SeqLockHashMapRH<int, int> map(64);
+    for (int i = 0; i < 1000; i++) map.put(i, i);
+
+    std::atomic<bool> done(false);
+    std::atomic<size_t> misses(0);
+    std::vector<std::thread> readers;
+
+    for (int r = 0; r < 3; r++) {
+        readers.emplace_back([&map, &done, &misses]() {
+            while (!done.load()) {
+                for (int i = 0; i < 1000; i++) {
+                    if (!map.containsKey(i) || map.get(i) != i) misses++;
+                }
+            }
+        });
+    }
+
+    // Churning keys collide with the stable ones, so their inserts and removals keep shifting them around
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < 2000; i++) map.put(1000 + i, round);
+        for (int i = 0; i < 2000; i++) map.remove(1000 + i);
+        for (int i = 0; i < 1000; i += 7) map.put(i, i);
+    }
+    done.store(true);
+    for (auto &reader : readers) reader.join();
+
+    REQUIRE(misses.load() == 0);
+    REQUIRE(map.getSize() == 1000);
+}
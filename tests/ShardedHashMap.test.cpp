@@ -0,0 +1,70 @@
+#include <ShardedHashMap.h>
+#include <HashMapLL.h>
+#include <HashMapDH.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_template_test_macros.hpp>
+
+using ShardedLL = ShardedHashMap<int, int, HashMapLL<int, int>>;
+using ShardedDH = ShardedHashMap<int, int, HashMapDH<int, int>>;
+using ShardedRH = ShardedHashMap<int, int>;
+
+TEMPLATE_TEST_CASE("Using ShardedHashMap", "[ShardedHashMap]", ShardedLL, ShardedDH, ShardedRH) {
+    TestType map(4);
+    REQUIRE(map.getShards() == 16);
+    REQUIRE(map.isEmpty());
+
+    SECTION("Adding, getting and removing elements") {
+        for (int i = 1; i <= 1000; i++) REQUIRE(map.put(i, i * 10) == 0);
+        REQUIRE(map.put(5, 55) == 50);
+        REQUIRE(map.getSize() == 1000);
+        REQUIRE(map.get(5) == 55);
+        REQUIRE(map.containsKey(1000));
+        REQUIRE_FALSE(map.containsKey(1001));
+
+        REQUIRE(map.remove(7) == 70);
+        REQUIRE_THROWS_AS(map.get(7), std::out_of_range);
+        REQUIRE_THROWS_AS(map.remove(7), std::out_of_range);
+        REQUIRE(map.getSize() == 999);
+    }
+
+    SECTION("Trying to get and remove elements") {
+        map.put(3, 30);
+        int value = 0;
+        REQUIRE(map.tryGet(3, value));
+        REQUIRE(value == 30);
+        REQUIRE_FALSE(map.tryGet(4, value));
+
+        value = 0;
+        REQUIRE(map.tryRemove(3, value));
+        REQUIRE(value == 30);
+        REQUIRE_FALSE(map.tryRemove(3, value));
+        REQUIRE(map.isEmpty());
+    }
+}
+
+TEST_CASE("Writing to ShardedHashMap from several threads", "[ShardedHashMap]") {
+    ShardedHashMap<int, std::string> map;
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++) {
+        writers.emplace_back([&map, t]() {
+            for (int i = t; i < 40000; i += 4) map.put(i, std::to_string(i));
+            for (int i = t; i < 40000; i += 8) map.remove(i);
+        });
+    }
+    for (auto &writer : writers) writer.join();
+
+    REQUIRE(map.getSize() == 20000);
+    size_t found = 0;
+    for (int i = 0; i < 40000; i++) {
+        std::string value;
+        bool removed = i % 8 < 4;
+        if (map.tryGet(i, value) != removed && (removed || value == std::to_string(i))) found++;
+    }
+    REQUIRE(found == 40000);
+    REQUIRE_THROWS_AS((ShardedHashMap<int, int>(constants::SHARD_MAX_BITS + 1)), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+#include <StringHashMapRH.h>
+
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+// Hashes every key into one of a few buckets so that keys share probe sequences
+struct ShortHash {
+    size_t operator()(std::string_view key) const { return key.size() % 4; }
+};
+
+TEST_CASE("Using StringHashMapRH", "[StringHashMapRH]") {
+    StringHashMapRH<int> map(16);
+    REQUIRE(map.isEmpty());
+
+    SECTION("Adding, replacing and getting elements") {
+        REQUIRE(map.put("first", 1) == 0);
+        REQUIRE(map.put("second", 2) == 0);
+        REQUIRE(map.put("first", 11) == 1);
+        REQUIRE(map.get("first") == 11);
+        REQUIRE(map.get(std::string("second")) == 2);
+        REQUIRE(map.getSize() == 2);
+        REQUIRE(map.getArenaSize() == 11);
+        REQUIRE_THROWS_AS(map.get("third"), std::out_of_range);
+    }
+
+    SECTION("Keys sharing a prefix") {
+        map.put("prefix-0001", 1);
+        map.put("prefix-0002", 2);
+        map.put("prefix", 3);
+        map.put("", 4);
+
+        REQUIRE(map.get("prefix-0001") == 1);
+        REQUIRE(map.get("prefix-0002") == 2);
+        REQUIRE(map.get("prefix") == 3);
+        REQUIRE(map.get("") == 4);
+        REQUIRE(map.get(std::string_view()) == 4);
+        REQUIRE_FALSE(map.containsKey("prefix-0003"));
+        REQUIRE_FALSE(map.containsKey("prefix-000"));
+    }
+
+    SECTION("Rehashing and clearing") {
+        for (int i = 0; i < 1000; i++) map.put("key-" + std::to_string(i), i);
+        REQUIRE(map.getCapacity() > 1000);
+        for (int i = 0; i < 1000; i++) REQUIRE(map.get("key-" + std::to_string(i)) == i);
+
+        map.clear();
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getArenaSize() == 0);
+        REQUIRE_FALSE(map.containsKey("key-5"));
+    }
+}
+
+TEST_CASE("Removing from StringHashMapRH", "[StringHashMapRH]") {
+    StringHashMapRH<std::string, ShortHash> map(32);
+    for (int i = 0; i < 20; i++) map.put("key-" + std::to_string(i), "value-" + std::to_string(i));
+
+    SECTION("Removing shifts colliding elements back") {
+        REQUIRE(map.remove("key-3") == "value-3");
+        REQUIRE_THROWS_AS(map.remove("key-3"), std::out_of_range);
+        for (int i = 0; i < 20; i++) {
+            if (i != 3) REQUIRE(map.get("key-" + std::to_string(i)) == "value-" + std::to_string(i));
+        }
+        REQUIRE(map.getSize() == 19);
+    }
+
+    SECTION("Removed keys are dropped from the arena") {
+        size_t arenaSize = map.getArenaSize();
+        for (int i = 0; i < 10; i++) map.remove("key-" + std::to_string(i));
+        REQUIRE(map.getArenaSize() == arenaSize);
+
+        map.remove("key-10");
+        REQUIRE(map.getArenaSize() < arenaSize / 2);
+        REQUIRE(map.getCapacity() == 32);
+        for (int i = 11; i < 20; i++) REQUIRE(map.get("key-" + std::to_string(i)) == "value-" + std::to_string(i));
+
+        map.put("key-0", "again");
+        REQUIRE(map.get("key-0") == "again");
+    }
+
+    SECTION("Mostly empty tables are not compacted on every removal") {
+        StringHashMapRH<int> sparse(4096);
+        sparse.put("kept", 1);
+
+        // Churn releases fewer bytes than there are slots, so the arena only grows
+        for (int i = 0; i < 100; i++) {
+            sparse.put("churn-" + std::to_string(i), i);
+            sparse.remove("churn-" + std::to_string(i));
+        }
+        size_t churned = sparse.getArenaSize();
+        REQUIRE(churned > 4 + 100 * 6);
+
+        for (int i = 100; i < 1000; i++) {
+            sparse.put("churn-" + std::to_string(i), i);
+            sparse.remove("churn-" + std::to_string(i));
+            REQUIRE(sparse.getArenaSize() <= 4 + 4096 + 9);
+        }
+        REQUIRE(sparse.getCapacity() == 4096);
+        REQUIRE(sparse.get("kept") == 1);
+    }
+}
+
+TEST_CASE("Moving, swapping and cloning StringHashMapRH", "[StringHashMapRH]") {
+    StringHashMapRH<int> map(16);
+    for (int i = 0; i < 100; i++) map.put("key-" + std::to_string(i), i);
+
+    SECTION("Moving and swapping") {
+        StringHashMapRH<int> moved(std::move(map));
+        REQUIRE(moved.getSize() == 100);
+        REQUIRE(map.isEmpty());
+        REQUIRE(map.getArenaSize() == 0);
+
+        map.put("other", 1);
+        map.swap(moved);
+        REQUIRE(map.get("key-99") == 99);
+        REQUIRE(moved.get("other") == 1);
+    }
+
+    SECTION("Cloning copies the arena with the slots") {
+        StringHashMapRH<int> copy = map.clone();
+        REQUIRE(copy.getSize() == 100);
+        REQUIRE(copy.getArenaSize() == map.getArenaSize());
+
+        map.clear();
+        for (int i = 0; i < 100; i++) REQUIRE(copy.get("key-" + std::to_string(i)) == i);
+        copy.put("key-100", 100);
+        REQUIRE(copy.get("key-100") == 100);
+        REQUIRE(map.isEmpty());
+    }
+}